@@ -26,7 +26,7 @@
 */
 inline int ASSERT(int val_, const char* msg_, int ret_) {    
 
-    static std::mutex assertMutex;
+    static Mutex assertMutex("assert");
 
     if (val_ != 0) {
 
@@ -0,0 +1,127 @@
+/**
+    Implements the AssimpIOSystem class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         AssimpIOSystem.cpp
+    @brief        Implementation of the AssimpIOSystem class, routes ASSIMP file access through the io namespace
+*/
+#include "AssimpIOSystem.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "FileIO.hpp"
+#include "Version.hpp"
+
+namespace {
+
+    /**
+        A read-only ASSIMP stream over a mapped file
+    */
+    class AssimpIOStream : public Assimp::IOStream {
+    public:
+
+        explicit AssimpIOStream(std::shared_ptr< FileData > file_) : file(std::move(file_)) {}
+
+        size_t Read(void* buffer_, size_t size_, size_t count_) override {
+
+            if (size_ == 0) return 0;
+
+            size_t count = std::min(count_, (file->size() - position) / size_);        // Whole elements only, like fread
+            std::memcpy(buffer_, file->data() + position, count * size_);
+            position += count * size_;
+
+            return count;
+
+        }
+
+        size_t Write(const void* buffer_, size_t size_, size_t count_) override {
+
+            (void) buffer_;
+            (void) size_;
+            (void) count_;
+
+            return 0;
+
+        }
+
+        aiReturn Seek(size_t offset_, aiOrigin origin_) override {
+
+            size_t target;
+            switch (origin_) {
+
+            case aiOrigin_SET:  target = offset_;                   break;
+            case aiOrigin_CUR:  target = position + offset_;        break;
+            case aiOrigin_END:  target = file->size() - offset_;    break;
+            default:            return aiReturn_FAILURE;
+
+            }
+
+            if (target > file->size()) return aiReturn_FAILURE;
+            position = target;
+
+            return aiReturn_SUCCESS;
+
+        }
+
+        size_t Tell(void) const override {
+
+            return position;
+
+        }
+
+        size_t FileSize(void) const override {
+
+            return file->size();
+
+        }
+
+        void Flush(void) override {}
+
+    private:
+
+        std::shared_ptr< FileData >     file;
+        size_t                          position        = 0;
+
+    };
+
+}
+
+bool AssimpIOSystem::Exists(const char* file_) const {
+
+    return vk::io::exists(file_);
+
+}
+
+char AssimpIOSystem::getOsSeparator() const {
+
+#if defined WIN_64 || defined WIN_32
+    return '\\';
+#else
+    return '/';
+#endif
+
+}
+
+Assimp::IOStream* AssimpIOSystem::Open(const char* file_, const char* mode_) {
+
+    if (std::strchr(mode_, 'w') != nullptr || std::strchr(mode_, 'a') != nullptr || std::strchr(mode_, '+') != nullptr) {
+
+        return nullptr;
+
+    }
+
+    std::shared_ptr< FileData > file = vk::io::read(file_);
+
+    return file ? new AssimpIOStream(file) : nullptr;
+
+}
+
+void AssimpIOSystem::Close(Assimp::IOStream* file_) {
+
+    delete file_;
+
+}
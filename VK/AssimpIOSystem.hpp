@@ -0,0 +1,55 @@
+/**
+    Declares the AssimpIOSystem class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         AssimpIOSystem.hpp
+    @brief        Declaration of the AssimpIOSystem class, routes ASSIMP file access through the io namespace
+*/
+#ifndef ASSIMP_IO_SYSTEM_HPP
+#define ASSIMP_IO_SYSTEM_HPP
+#include <assimp/IOSystem.hpp>
+#include <assimp/IOStream.hpp>
+
+/**
+    Lets ASSIMP read models and material libraries from prefetched, memory-mapped files instead of opening them itself
+*/
+class AssimpIOSystem : public Assimp::IOSystem {
+public:
+
+    /**
+        Checks whether a file exists
+
+        @param      file_       The path ASSIMP asks for
+
+        @return     Returns true if the file exists
+    */
+    bool Exists(const char* file_) const override;
+
+    /**
+        Returns the path separator of the platform
+
+        @return     Returns the path separator
+    */
+    char getOsSeparator(void) const override;
+
+    /**
+        Opens a file for reading, write access is not supported
+
+        @param      file_       The path ASSIMP asks for
+        @param      mode_       The fopen-style access mode
+
+        @return     Returns a stream over the mapped file or nullptr if it cannot be opened
+    */
+    Assimp::IOStream* Open(const char* file_, const char* mode_ = "rb") override;
+
+    /**
+        Closes a stream returned by Open
+
+        @param      file_       The stream to close
+    */
+    void Close(Assimp::IOStream* file_) override;
+
+};
+#endif  // ASSIMP_IO_SYSTEM_HPP
@@ -16,7 +16,7 @@ BaseBuffer::BaseBuffer(const VkBufferCreateInfo* bufferCreateInfo_, VkMemoryProp
 
     bufferCreateInfo = *bufferCreateInfo_;
 
-    logger::log(EVENT_LOG, "Creating buffer...");
+    VK_LOG_DEBUG(LC_MEMORY, "Creating buffer...");
     VkResult result = vkCreateBuffer(
         vk::core::logicalDevice,
         bufferCreateInfo_,
@@ -24,7 +24,7 @@ BaseBuffer::BaseBuffer(const VkBufferCreateInfo* bufferCreateInfo_, VkMemoryProp
         &buf
         );
     ASSERT(result, "Failed to create buffer", VK_SC_BUFFER_CREATION_ERROR);
-    logger::log(EVENT_LOG, "Successfully created buffer");
+    VK_LOG_DEBUG(LC_MEMORY, "Successfully created buffer");
 
     VkMemoryRequirements memoryRequirements;
     vkGetBufferMemoryRequirements(vk::core::logicalDevice, buf, &memoryRequirements);
@@ -41,6 +41,9 @@ BaseBuffer::BaseBuffer(const VkBufferCreateInfo* bufferCreateInfo_, VkMemoryProp
         &mem
         );
     ASSERT(result, "Failed to allocate buffer memory", VK_SC_BUFFER_ALLOCATION_ERROR);
+    memoryType = memoryAllocateInfo.memoryTypeIndex;
+    track(static_cast< int64_t >(memoryRequirements.size));
+    vk::counters::add(FC_OBJECTS_CREATED, 2);       // The buffer and its memory
 
     bind();
 
@@ -48,7 +51,7 @@ BaseBuffer::BaseBuffer(const VkBufferCreateInfo* bufferCreateInfo_, VkMemoryProp
 
 BaseBuffer::BaseBuffer(VkDeviceSize size_, VkBufferUsageFlags usage_, VkMemoryPropertyFlags properties_ ) {
 
-    logger::log(EVENT_LOG, "Creating buffer...");
+    VK_LOG_DEBUG(LC_MEMORY, "Creating buffer...");
 
     QueueFamily family                        = vk::core::findSuitableQueueFamily(vk::core::physicalDevice);
     std::vector< uint32_t > indices           = { family.transferFamilyIndex.value() };
@@ -67,7 +70,7 @@ BaseBuffer::BaseBuffer(VkDeviceSize size_, VkBufferUsageFlags usage_, VkMemoryPr
         &buf
         );
     ASSERT(result, "Failed to create buffer", VK_SC_BUFFER_CREATION_ERROR);
-    logger::log(EVENT_LOG, "Successfully created buffer");
+    VK_LOG_DEBUG(LC_MEMORY, "Successfully created buffer");
 
     VkMemoryRequirements memoryRequirements;
     vkGetBufferMemoryRequirements(vk::core::logicalDevice, buf, &memoryRequirements);
@@ -84,6 +87,9 @@ BaseBuffer::BaseBuffer(VkDeviceSize size_, VkBufferUsageFlags usage_, VkMemoryPr
         &mem
         );
     ASSERT(result, "Failed to allocate buffer memory", VK_SC_BUFFER_ALLOCATION_ERROR);
+    memoryType = memoryAllocateInfo.memoryTypeIndex;
+    track(static_cast< int64_t >(memoryRequirements.size));
+    vk::counters::add(FC_OBJECTS_CREATED, 2);       // The buffer and its memory
 
     bind();
 
@@ -91,11 +97,23 @@ BaseBuffer::BaseBuffer(VkDeviceSize size_, VkBufferUsageFlags usage_, VkMemoryPr
 
 BaseBuffer::~BaseBuffer() {
 
+    track(-static_cast< int64_t >(memorySize));
+
     vkDestroyBuffer(vk::core::logicalDevice, buf, vk::core::allocator);
-    logger::log(EVENT_LOG, "Successfully destroyed buffer");
+    VK_LOG_DEBUG(LC_MEMORY, "Successfully destroyed buffer");
 
     vkFreeMemory(vk::core::logicalDevice, mem, vk::core::allocator);
-    logger::log(EVENT_LOG, "Successfully destroyed buffer memory");
+    VK_LOG_DEBUG(LC_MEMORY, "Successfully destroyed buffer memory");
+    vk::counters::add(FC_OBJECTS_DESTROYED, 2);
+
+}
+
+void BaseBuffer::track(int64_t size_) {
+
+    if (size_ == 0) return;         // Textures reuse mem for their image, the image accounts for it
+
+    vk::memory::track(vk::memory::bufferCategory(bufferCreateInfo.usage), memoryType, size_);
+    memorySize = static_cast< VkDeviceSize >(size_ > 0 ? size_ : 0);
 
 }
 
@@ -126,6 +144,7 @@ VK_STATUS_CODE BaseBuffer::fill(const void* bufData_) {
         );
     memcpy(data, bufData_, static_cast< size_t >(bufferCreateInfo.size));
     vkUnmapMemory(vk::core::logicalDevice, mem);
+    vk::counters::add(FC_BYTES_UPLOADED, bufferCreateInfo.size);
 
     return vk::errorCodeBuffer;
 
@@ -144,6 +163,7 @@ VK_STATUS_CODE BaseBuffer::fill(const unsigned char* bufData_) {
         );
     memcpy(data, bufData_, static_cast<size_t>(bufferCreateInfo.size));
     vkUnmapMemory(vk::core::logicalDevice, mem);
+    vk::counters::add(FC_BYTES_UPLOADED, bufferCreateInfo.size);
 
     return vk::errorCodeBuffer;
 
@@ -154,19 +174,19 @@ VK_STATUS_CODE BaseBuffer::fillS(const void* bufData_, size_t bufSize_) {
     QueueFamily family                      = vk::core::findSuitableQueueFamily(vk::core::physicalDevice);
     std::vector< uint32_t > indices         = { family.transferFamilyIndex.value() };
 
-    VkBufferCreateInfo bufferCreateInfo     = {};
-    bufferCreateInfo.sType                  = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferCreateInfo.size                   = bufSize_;
-    bufferCreateInfo.usage                  = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferCreateInfo.sharingMode            = VK_SHARING_MODE_EXCLUSIVE;
-    bufferCreateInfo.pQueueFamilyIndices    = indices.data();
-    bufferCreateInfo.queueFamilyIndexCount  = static_cast< uint32_t >(indices.size());
+    VkBufferCreateInfo stagingCreateInfo    = {};
+    stagingCreateInfo.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    stagingCreateInfo.size                  = bufSize_;
+    stagingCreateInfo.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    stagingCreateInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    stagingCreateInfo.pQueueFamilyIndices   = indices.data();
+    stagingCreateInfo.queueFamilyIndexCount = static_cast< uint32_t >(indices.size());
 
-    BaseBuffer* stagingBuffer               = new BaseBuffer(&bufferCreateInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    BaseBuffer* stagingBuffer               = new BaseBuffer(&stagingCreateInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
     stagingBuffer->fill(bufData_);
 
-    vk::copyBuffer(stagingBuffer->buf, buf, bufSize_);
+    vk::copyBuffer(stagingBuffer->buf, buf, bufSize_, bufferCreateInfo.usage);      // Hands the buffer to the graphics queue
 
     delete stagingBuffer;
 
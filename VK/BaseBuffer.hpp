@@ -64,7 +64,8 @@ public:
     VK_STATUS_CODE fill(const unsigned char* bufData_);
 
     /**
-        Maps data to a buffer using a staging buffer
+        Maps data to a buffer using a staging buffer copied on the transfer queue, the graphics queue acquires the
+        buffer with the next frame
 
         @param      bufData_        Pointer to the data that needs to be copied to the buffer
         @param      bufSize_        The size of the buffer in bytes
@@ -90,6 +91,15 @@ public:
 protected:
 
     VkBufferCreateInfo        bufferCreateInfo           = {};
+    VkDeviceSize              memorySize                 = 0;
+    uint32_t                  memoryType                 = 0;
+
+    /**
+        Adds an allocation to the device memory accounting or, with a negative size, removes it again
+
+        @param      size_       The size of the allocation in bytes
+    */
+    void track(int64_t size_);
 
 };
 #endif  // BASE_BUFFER_HPP
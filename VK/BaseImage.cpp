@@ -14,8 +14,10 @@
 
 BaseImage::~BaseImage() {
 
+    vk::untrackImage(img);
     vkDestroyImageView(vk::core::logicalDevice, imgView, vk::core::allocator);
     vkDestroyImage(vk::core::logicalDevice, img, vk::core::allocator);
     vkFreeMemory(vk::core::logicalDevice, imgMem, vk::core::allocator);
+    vk::counters::add(FC_OBJECTS_DESTROYED);          // The view, untrackImage() counts the image and its memory
 
 }
\ No newline at end of file
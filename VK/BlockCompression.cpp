@@ -0,0 +1,438 @@
+/**
+    Implements the bc namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         BlockCompression.cpp
+    @brief        Implementation of the bc namespace, a small CPU block-compression encoder
+*/
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace vk {
+
+    namespace bc {
+
+        /**
+            Reads a 4x4 block of RGBA8 texels, clamping reads outside of the image to the border
+        */
+        static void fetchBlock(const unsigned char* rgba_, uint32_t width_, uint32_t height_, uint32_t bx_, uint32_t by_, unsigned char block_[16][4]) {
+
+            for (uint32_t y = 0; y < 4; y++) {
+
+                uint32_t sy = std::min(by_ * 4 + y, height_ - 1);
+
+                for (uint32_t x = 0; x < 4; x++) {
+
+                    uint32_t sx = std::min(bx_ * 4 + x, width_ - 1);
+                    std::memcpy(block_[y * 4 + x], rgba_ + (static_cast< size_t >(sy) * width_ + sx) * 4, 4);
+
+                }
+
+            }
+
+        }
+
+        /**
+            Finds per-channel endpoints of the block's bounding box and orients the box along the dominant color axis
+        */
+        static void boundingBox(const unsigned char block_[16][4], uint32_t channels_, int min_[4], int max_[4]) {
+
+            int mean[4] = { 0, 0, 0, 0 };
+            for (uint32_t i = 0; i < 16; i++) {
+
+                for (uint32_t c = 0; c < channels_; c++) {
+
+                    mean[c] += block_[i][c];
+
+                }
+
+            }
+
+            for (uint32_t c = 0; c < channels_; c++) {
+
+                mean[c] /= 16;
+                min_[c] = 255;
+                max_[c] = 0;
+
+            }
+
+            int covariance[4] = { 0, 0, 0, 0 };      // Covariance of each channel with green, the channel carrying most of the luminance
+            for (uint32_t i = 0; i < 16; i++) {
+
+                int g = block_[i][1] - mean[1];
+
+                for (uint32_t c = 0; c < channels_; c++) {
+
+                    min_[c] = std::min(min_[c], static_cast< int >(block_[i][c]));
+                    max_[c] = std::max(max_[c], static_cast< int >(block_[i][c]));
+                    covariance[c] += (block_[i][c] - mean[c]) * g;
+
+                }
+
+            }
+
+            for (uint32_t c = 0; c < channels_; c++) {
+
+                int inset = (max_[c] - min_[c]) >> 4;        // Pull the endpoints in slightly, the interpolated palette covers the extremes better that way
+                min_[c] += inset;
+                max_[c] -= inset;
+
+                if (c != 1 && covariance[c] < 0) {
+
+                    std::swap(min_[c], max_[c]);
+
+                }
+
+            }
+
+        }
+
+        static uint16_t packRGB565(const int col_[4]) {
+
+            return static_cast< uint16_t >(((col_[0] * 31 + 127) / 255) << 11 | ((col_[1] * 63 + 127) / 255) << 5 | ((col_[2] * 31 + 127) / 255));
+
+        }
+
+        static void unpackRGB565(uint16_t col_, int out_[3]) {
+
+            int r = (col_ >> 11) & 31;
+            int g = (col_ >> 5) & 63;
+            int b = col_ & 31;
+
+            out_[0] = (r << 3) | (r >> 2);
+            out_[1] = (g << 2) | (g >> 4);
+            out_[2] = (b << 3) | (b >> 2);
+
+        }
+
+        /**
+            Encodes the color part of a BC1/BC3 block, always using the four-color mode
+        */
+        static void encodeColorBlock(const unsigned char block_[16][4], unsigned char* dst_) {
+
+            int lo[4], hi[4];
+            boundingBox(block_, 3, lo, hi);
+
+            uint16_t c0 = packRGB565(hi);
+            uint16_t c1 = packRGB565(lo);
+
+            if (c0 < c1) {
+
+                std::swap(c0, c1);
+
+            }
+
+            uint32_t indices = 0;
+
+            if (c0 != c1) {
+
+                int palette[4][3];
+                unpackRGB565(c0, palette[0]);
+                unpackRGB565(c1, palette[1]);
+
+                for (uint32_t c = 0; c < 3; c++) {
+
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+
+                }
+
+                for (uint32_t i = 0; i < 16; i++) {
+
+                    int bestError = INT32_MAX;
+                    uint32_t best = 0;
+
+                    for (uint32_t p = 0; p < 4; p++) {
+
+                        int dr = block_[i][0] - palette[p][0];
+                        int dg = block_[i][1] - palette[p][1];
+                        int db = block_[i][2] - palette[p][2];
+                        int error = dr * dr + dg * dg + db * db;
+
+                        if (error < bestError) {
+
+                            bestError = error;
+                            best = p;
+
+                        }
+
+                    }
+
+                    indices |= best << (2 * i);
+
+                }
+
+            }
+
+            dst_[0] = static_cast< unsigned char >(c0 & 0xFF);
+            dst_[1] = static_cast< unsigned char >(c0 >> 8);
+            dst_[2] = static_cast< unsigned char >(c1 & 0xFF);
+            dst_[3] = static_cast< unsigned char >(c1 >> 8);
+            std::memcpy(dst_ + 4, &indices, 4);
+
+        }
+
+        /**
+            Encodes the alpha part of a BC3 block in the eight-value mode
+        */
+        static void encodeAlphaBlock(const unsigned char block_[16][4], unsigned char* dst_) {
+
+            int a0 = 0;
+            int a1 = 255;
+
+            for (uint32_t i = 0; i < 16; i++) {
+
+                a0 = std::max(a0, static_cast< int >(block_[i][3]));
+                a1 = std::min(a1, static_cast< int >(block_[i][3]));
+
+            }
+
+            uint64_t indices = 0;
+
+            if (a0 != a1) {
+
+                int palette[8] = { a0, a1 };
+                for (int p = 1; p < 7; p++) {
+
+                    palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+
+                }
+
+                for (uint32_t i = 0; i < 16; i++) {
+
+                    int bestError = INT32_MAX;
+                    uint64_t best = 0;
+
+                    for (uint32_t p = 0; p < 8; p++) {
+
+                        int error = std::abs(block_[i][3] - palette[p]);
+
+                        if (error < bestError) {
+
+                            bestError = error;
+                            best = p;
+
+                        }
+
+                    }
+
+                    indices |= best << (3 * i);
+
+                }
+
+            }
+
+            dst_[0] = static_cast< unsigned char >(a0);
+            dst_[1] = static_cast< unsigned char >(a1);
+            for (uint32_t i = 0; i < 6; i++) {
+
+                dst_[2 + i] = static_cast< unsigned char >((indices >> (8 * i)) & 0xFF);
+
+            }
+
+        }
+
+        /**
+            Quantizes an 8-bit RGBA endpoint to BC7 mode 6's 7 bits per channel plus a shared p-bit
+        */
+        static void quantizeEndpoint(const int endpoint_[4], int quantized_[4], int& pBit_) {
+
+            int bestError = INT32_MAX;
+
+            for (int p = 0; p < 2; p++) {
+
+                int candidate[4];
+                int error = 0;
+
+                for (uint32_t c = 0; c < 4; c++) {
+
+                    candidate[c] = std::clamp((endpoint_[c] - p + 1) >> 1, 0, 127);
+                    int reconstructed = (candidate[c] << 1) | p;
+                    error += (reconstructed - endpoint_[c]) * (reconstructed - endpoint_[c]);
+
+                }
+
+                if (error < bestError) {
+
+                    bestError = error;
+                    pBit_ = p;
+                    std::memcpy(quantized_, candidate, sizeof(candidate));
+
+                }
+
+            }
+
+        }
+
+        /**
+            Encodes a BC7 block using mode 6 (one subset, RGBA endpoints, 4-bit indices)
+        */
+        static void encodeBC7Block(const unsigned char block_[16][4], unsigned char* dst_) {
+
+            static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+            int lo[4], hi[4];
+            boundingBox(block_, 4, lo, hi);
+
+            int q[2][4];
+            int p[2];
+            quantizeEndpoint(lo, q[0], p[0]);
+            quantizeEndpoint(hi, q[1], p[1]);
+
+            int palette[16][4];
+            for (uint32_t i = 0; i < 16; i++) {
+
+                for (uint32_t c = 0; c < 4; c++) {
+
+                    int e0 = (q[0][c] << 1) | p[0];
+                    int e1 = (q[1][c] << 1) | p[1];
+                    palette[i][c] = ((64 - weights[i]) * e0 + weights[i] * e1 + 32) >> 6;
+
+                }
+
+            }
+
+            uint32_t indices[16];
+            for (uint32_t i = 0; i < 16; i++) {
+
+                int bestError = INT32_MAX;
+
+                for (uint32_t w = 0; w < 16; w++) {
+
+                    int error = 0;
+                    for (uint32_t c = 0; c < 4; c++) {
+
+                        int d = block_[i][c] - palette[w][c];
+                        error += d * d;
+
+                    }
+
+                    if (error < bestError) {
+
+                        bestError = error;
+                        indices[i] = w;
+
+                    }
+
+                }
+
+            }
+
+            if (indices[0] & 8) {        // The anchor index has an implicit zero MSB, mirror the palette to satisfy that
+
+                std::swap(q[0], q[1]);
+                std::swap(p[0], p[1]);
+
+                for (uint32_t i = 0; i < 16; i++) {
+
+                    indices[i] = 15 - indices[i];
+
+                }
+
+            }
+
+            std::memset(dst_, 0, 16);
+            uint32_t bit = 0;
+            auto write = [&](uint32_t value_, uint32_t bits_) {
+
+                for (uint32_t b = 0; b < bits_; b++, bit++) {
+
+                    dst_[bit >> 3] |= static_cast< unsigned char >(((value_ >> b) & 1) << (bit & 7));
+
+                }
+
+            };
+
+            write(1 << 6, 7);       // Mode 6
+            for (uint32_t c = 0; c < 4; c++) {
+
+                write(q[0][c], 7);
+                write(q[1][c], 7);
+
+            }
+            write(p[0], 1);
+            write(p[1], 1);
+            write(indices[0], 3);
+            for (uint32_t i = 1; i < 16; i++) {
+
+                write(indices[i], 4);
+
+            }
+
+        }
+
+        static bool isBC1(VkFormat format_) {
+
+            return format_ == VK_FORMAT_BC1_RGB_UNORM_BLOCK || format_ == VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+
+        }
+
+        static bool isBC3(VkFormat format_) {
+
+            return format_ == VK_FORMAT_BC3_UNORM_BLOCK || format_ == VK_FORMAT_BC3_SRGB_BLOCK;
+
+        }
+
+        bool isCompressed(VkFormat format_) {
+
+            return isBC1(format_) || isBC3(format_) || format_ == VK_FORMAT_BC7_UNORM_BLOCK || format_ == VK_FORMAT_BC7_SRGB_BLOCK;
+
+        }
+
+        VkDeviceSize compressedSize(VkFormat format_, uint32_t width_, uint32_t height_) {
+
+            VkDeviceSize blocks     = static_cast< VkDeviceSize >((width_ + 3) / 4) * ((height_ + 3) / 4);
+
+            return blocks * (isBC1(format_) ? 8 : 16);
+
+        }
+
+        void compress(VkFormat format_, const unsigned char* rgba_, uint32_t width_, uint32_t height_, unsigned char* dst_) {
+
+            uint32_t blocksX = (width_ + 3) / 4;
+            uint32_t blocksY = (height_ + 3) / 4;
+
+            unsigned char block[16][4];
+
+            for (uint32_t by = 0; by < blocksY; by++) {
+
+                for (uint32_t bx = 0; bx < blocksX; bx++) {
+
+                    fetchBlock(rgba_, width_, height_, bx, by, block);
+
+                    if (isBC1(format_)) {
+
+                        encodeColorBlock(block, dst_);
+                        dst_ += 8;
+
+                    }
+                    else if (isBC3(format_)) {
+
+                        encodeAlphaBlock(block, dst_);
+                        encodeColorBlock(block, dst_ + 8);
+                        dst_ += 16;
+
+                    }
+                    else {
+
+                        encodeBC7Block(block, dst_);
+                        dst_ += 16;
+
+                    }
+
+                }
+
+            }
+
+        }
+
+    }
+
+}
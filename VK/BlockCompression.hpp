@@ -0,0 +1,55 @@
+/**
+    Prototypes the bc namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         BlockCompression.hpp
+    @brief        Prototype of the bc namespace, a small CPU block-compression encoder
+*/
+#ifndef BLOCK_COMPRESSION_HPP
+#define BLOCK_COMPRESSION_HPP
+#include <vulkan/vulkan.h>
+
+namespace vk {
+
+    /**
+        Encodes RGBA8 images into BCn block-compressed formats
+    */
+    namespace bc {
+
+        /**
+            Checks whether a VkFormat is one of the block-compressed formats this encoder produces
+
+            @param      format_         The format in question
+
+            @return     Returns true if the format is BC1, BC3 or BC7 (UNORM or sRGB)
+        */
+        bool isCompressed(VkFormat format_);
+
+        /**
+            Calculates the size of a compressed image
+
+            @param      format_         The block-compressed format
+            @param      width_          The width of the image in texels
+            @param      height_         The height of the image in texels
+
+            @return     Returns the size in bytes of the compressed image
+        */
+        VkDeviceSize compressedSize(VkFormat format_, uint32_t width_, uint32_t height_);
+
+        /**
+            Compresses a tightly packed RGBA8 image, partial blocks at the border are padded by clamping
+
+            @param      format_         The target format, the UNORM or sRGB variant of BC1 (RGB), BC3 or BC7
+            @param      rgba_           Pointer to the source texels
+            @param      width_          The width of the image in texels
+            @param      height_         The height of the image in texels
+            @param      dst_            Pointer to at least compressedSize(format_, width_, height_) bytes
+        */
+        void compress(VkFormat format_, const unsigned char* rgba_, uint32_t width_, uint32_t height_, unsigned char* dst_);
+
+    }
+
+}
+#endif  // BLOCK_COMPRESSION_HPP
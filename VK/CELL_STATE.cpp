@@ -0,0 +1,24 @@
+/**
+    Defines the CELL_STATE enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         CELL_STATE.cpp
+    @brief        Definition of the CELL_STATE enumeration
+*/
+#ifndef CELL_STATE_CPP
+#define CELL_STATE_CPP
+
+/**
+ * Enumeration to differenciate between the residency states of a world streaming cell
+ */
+typedef enum CELL_STATE {
+
+    CS_UNLOADED         = 0,
+    CS_LOADING          = 1,        // Loads are queued or running
+    CS_ARRIVING         = 2,        // Every load has completed, the render loop adopts the models with the next frame
+    CS_RESIDENT         = 3
+
+} CELL_STATE;
+#endif  // CELL_STATE_CPP
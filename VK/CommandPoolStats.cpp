@@ -0,0 +1,28 @@
+/**
+    Defines the CommandPoolStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         CommandPoolStats.cpp
+    @brief        Definition of the CommandPoolStats struct
+*/
+#ifndef COMMAND_POOL_STATS_CPP
+#define COMMAND_POOL_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the statistics of the per-thread command pools
+*/
+struct CommandPoolStats {
+
+    uint64_t            pools;                      // Command pools created, one per thread and queue
+    uint64_t            commandBuffers;             // Command buffers allocated from them
+    uint64_t            resets;                     // Times a pool was reset as a whole
+    uint64_t            submissions;
+    uint64_t            lockWaitMicroseconds;       // Time submissions waited for their queue's mutex
+    uint64_t            maxLockWaitMicroseconds;
+    uint64_t            lockHoldMicroseconds;       // Time submissions held their queue's mutex
+
+};
+#endif  // COMMAND_POOL_STATS_CPP
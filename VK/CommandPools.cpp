@@ -0,0 +1,258 @@
+/**
+    Implements the commands namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         CommandPools.cpp
+    @brief        Implementation of the commands namespace, command pools owned by the threads recording into them
+*/
+#include "CommandPools.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "VK.hpp"
+#include "ASSERT.cpp"
+
+namespace vk {
+
+    namespace commands {
+
+        namespace {
+
+            /**
+                The pool of one thread for one queue, only that thread touches it
+            */
+            struct ThreadPool {
+
+                VkCommandPool                                   pool            = VK_NULL_HANDLE;
+                std::vector< VkCommandBuffer >                  ready;                          // Reset, can be begun
+                std::vector< VkCommandBuffer >                  executed;                       // Released, reset with the pool
+                uint32_t                                        recording       = 0;            // Acquired and not released yet
+
+            };
+
+            /**
+                The pools of one thread
+            */
+            struct ThreadPools {
+
+                ThreadPool                                      queues[2];
+
+            };
+
+            const uint32_t                                      BATCH_SIZE                  = 8;        // Command buffers allocated at once, and used between two resets
+
+            uint32_t                                            familyIndices[2]            = {};
+            std::mutex                                          registryMutex;                          // Only taken the first time a thread records
+            std::vector< std::unique_ptr< ThreadPools > >       registry;
+            thread_local ThreadPools*                           threadPools                 = nullptr;
+            std::atomic< uint64_t >                             poolCount                   = 0;
+            std::atomic< uint64_t >                             commandBufferCount          = 0;
+            std::atomic< uint64_t >                             resetCount                  = 0;
+            std::atomic< uint64_t >                             submissionCount             = 0;
+            std::atomic< uint64_t >                             lockWait                    = 0;
+            std::atomic< uint64_t >                             maxLockWait                 = 0;
+            std::atomic< uint64_t >                             lockHold                    = 0;
+
+            uint32_t queueIndex(Queue queue_) {
+
+                return queue_ == TRANSFER_QUEUE ? 1 : 0;
+
+            }
+
+            /**
+                Returns the calling thread's pool for a queue, creating it on first use
+            */
+            ThreadPool& threadPool(Queue queue_) {
+
+                if (threadPools == nullptr) {
+
+                    std::unique_ptr< ThreadPools > pools = std::make_unique< ThreadPools >();
+                    threadPools = pools.get();
+
+                    std::scoped_lock< std::mutex > lock(registryMutex);
+                    registry.push_back(std::move(pools));
+
+                }
+
+                ThreadPool& pool = threadPools->queues[queueIndex(queue_)];
+                if (pool.pool == VK_NULL_HANDLE) {
+
+                    VkCommandPoolCreateInfo commandPoolCreateInfo  = {};
+                    commandPoolCreateInfo.sType                    = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                    commandPoolCreateInfo.flags                    = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+                    commandPoolCreateInfo.queueFamilyIndex         = familyIndices[queueIndex(queue_)];
+
+                    VkResult result = vkCreateCommandPool(
+                        vk::core::logicalDevice,
+                        &commandPoolCreateInfo,
+                        vk::core::allocator,
+                        &pool.pool
+                        );
+                    ASSERT(result, "Failed to create a command pool for a loader thread", VK_SC_COMMAND_POOL_ALLOCATION_ERROR);
+                    poolCount++;
+
+                }
+
+                return pool;
+
+            }
+
+        }
+
+        void init(uint32_t graphicsFamily_, uint32_t transferFamily_) {
+
+            familyIndices[0] = graphicsFamily_;
+            familyIndices[1] = transferFamily_;
+
+        }
+
+        VkCommandBuffer acquire(Queue queue_) {
+
+            ThreadPool& pool = threadPool(queue_);
+
+            if (pool.ready.empty()) {
+
+                if (pool.recording == 0 && pool.executed.size() >= BATCH_SIZE) {
+
+                    VkResult result = vkResetCommandPool(vk::core::logicalDevice, pool.pool, 0);
+                    ASSERT(result, "Failed to reset a loader thread's command pool", VK_SC_COMMAND_POOL_ALLOCATION_ERROR);
+                    pool.ready.swap(pool.executed);
+                    resetCount++;
+
+                }
+                else {
+
+                    VkCommandBufferAllocateInfo allocInfo   = {};
+                    allocInfo.sType                         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                    allocInfo.level                         = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                    allocInfo.commandPool                   = pool.pool;
+                    allocInfo.commandBufferCount            = BATCH_SIZE;
+
+                    pool.ready.resize(BATCH_SIZE);
+                    VkResult result = vkAllocateCommandBuffers(vk::core::logicalDevice, &allocInfo, pool.ready.data());
+                    if (result != VK_SUCCESS) pool.ready.clear();           // The handles are undefined, the next acquire tries again
+                    ASSERT(result, "Failed to allocate command buffers for a loader thread", VK_SC_COMMAND_BUFFER_ALLOCATION_ERROR);
+                    commandBufferCount += BATCH_SIZE;
+
+                }
+
+            }
+
+            VkCommandBuffer commandBuffer = pool.ready.back();
+
+            VkCommandBufferBeginInfo beginInfo      = {};
+            beginInfo.sType                         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags                         = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+            VkResult result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
+            ASSERT(result, "Failed to begin recording a loader thread's command buffer", VK_SC_COMMAND_BUFFER_RECORDING_ERROR);
+
+            pool.ready.pop_back();          // Only once recording began, a failure must not keep the pool from being reset
+            pool.recording++;
+
+            return commandBuffer;
+
+        }
+
+        VkResult submit(VkCommandBuffer commandBuffer_, Queue queue_, uint64_t* value_) {
+
+            static Histogram* lockWaitMetric = vk::metrics::histogram("sync_queue_lock_wait_us", "Time uploads waited for their queue's submission lock in microseconds");
+            static Histogram* lockHoldMetric = vk::metrics::histogram("sync_queue_lock_hold_us", "Time uploads held their queue's submission lock in microseconds");
+
+            VkSubmitInfo submitInfo         = {};
+            submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount   = 1;
+            submitInfo.pCommandBuffers      = &commandBuffer_;
+
+            auto requested = std::chrono::steady_clock::now();
+            std::unique_lock< Mutex > lock(queue_ == TRANSFER_QUEUE ? vk::transferMutex : vk::graphicsMutex);
+            auto acquired = std::chrono::steady_clock::now();
+            VkResult result = vk::timeline::submit(queue_, submitInfo, value_);
+            lock.unlock();
+            auto released = std::chrono::steady_clock::now();
+
+            uint64_t waited = static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::microseconds >(acquired - requested).count());
+            uint64_t held   = static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::microseconds >(released - acquired).count());
+            lockWaitMetric->observe(waited);
+            lockHoldMetric->observe(held);
+
+            submissionCount++;
+            lockWait += waited;
+            lockHold += held;
+            uint64_t max = maxLockWait.load(std::memory_order_relaxed);
+            while (waited > max && !maxLockWait.compare_exchange_weak(max, waited, std::memory_order_relaxed));
+
+            return result;
+
+        }
+
+        void release(VkCommandBuffer commandBuffer_, Queue queue_) {
+
+            ThreadPool& pool = threadPool(queue_);
+            pool.executed.push_back(commandBuffer_);
+            pool.recording--;
+
+        }
+
+        void destroy() {
+
+            std::scoped_lock< std::mutex > lock(registryMutex);
+            for (auto& pools : registry) {
+
+                for (auto& pool : pools->queues) {
+
+                    if (pool.pool == VK_NULL_HANDLE) continue;
+
+                    vkDestroyCommandPool(vk::core::logicalDevice, pool.pool, vk::core::allocator);     // Frees its command buffers
+                    pool.pool = VK_NULL_HANDLE;
+                    pool.ready.clear();
+                    pool.executed.clear();
+
+                }
+
+            }
+            // The ThreadPools stay registered, threads still point to them
+
+        }
+
+        CommandPoolStats stats() {
+
+            CommandPoolStats snapshot               = {};
+            snapshot.pools                          = poolCount.load();
+            snapshot.commandBuffers                 = commandBufferCount.load();
+            snapshot.resets                         = resetCount.load();
+            snapshot.submissions                    = submissionCount.load();
+            snapshot.lockWaitMicroseconds           = lockWait.load();
+            snapshot.maxLockWaitMicroseconds        = maxLockWait.load();
+            snapshot.lockHoldMicroseconds           = lockHold.load();
+
+            return snapshot;
+
+        }
+
+        void logStats() {
+
+            CommandPoolStats snapshot = stats();
+
+            logger::log(EVENT_LOG, "Command pools: "
+                + std::to_string(snapshot.pools) + " pools, "
+                + std::to_string(snapshot.commandBuffers) + " command buffers, "
+                + std::to_string(snapshot.resets) + " resets, "
+                + std::to_string(snapshot.submissions) + " submissions waited "
+                + std::to_string(snapshot.lockWaitMicroseconds) + " us for and held "
+                + std::to_string(snapshot.lockHoldMicroseconds) + " us their queue lock, "
+                + std::to_string(snapshot.maxLockWaitMicroseconds) + " us longest wait"
+                );
+
+        }
+
+    }
+
+}
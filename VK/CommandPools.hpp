@@ -0,0 +1,85 @@
+/**
+    Prototypes the commands namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         CommandPools.hpp
+    @brief        Prototype of the commands namespace, command pools owned by the threads recording into them
+*/
+#ifndef COMMAND_POOLS_HPP
+#define COMMAND_POOLS_HPP
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+#include "Queue.cpp"
+#include "CommandPoolStats.cpp"
+
+namespace vk {
+
+    /**
+        Gives every thread a transient command pool per queue, created the first time the thread records for that
+        queue. Recording never takes a lock, only the submission itself is serialized per queue. Command buffers are
+        allocated in batches and not reset one by one, a pool is reset as a whole once all of them have been used and
+        none is being recorded.
+    */
+    namespace commands {
+
+        /**
+            Sets the queue families the pools are created for, has to be called once the logical device exists
+
+            @param      graphicsFamily_     The queue family index of the graphics queue
+            @param      transferFamily_     The queue family index of the transfer queue
+        */
+        void init(uint32_t graphicsFamily_, uint32_t transferFamily_);
+
+        /**
+            Begins a one-time command buffer from the calling thread's pool
+
+            @param      queue_          GRAPHICS_QUEUE or TRANSFER_QUEUE
+
+            @return     Returns the command buffer, it has to be released by the same thread
+        */
+        VkCommandBuffer acquire(Queue queue_);
+
+        /**
+            Submits an ended command buffer, holding the queue's mutex only for vkQueueSubmit
+
+            @param      commandBuffer_  The command buffer
+            @param      queue_          The queue it was acquired for
+            @param      value_          Is set to the timeline value the submission signals
+
+            @return     Returns the result of vkQueueSubmit
+        */
+        VkResult submit(VkCommandBuffer commandBuffer_, Queue queue_, uint64_t* value_);
+
+        /**
+            Hands a command buffer back to the calling thread's pool, its submission has to have finished
+
+            @param      commandBuffer_  The command buffer
+            @param      queue_          The queue it was acquired for
+        */
+        void release(VkCommandBuffer commandBuffer_, Queue queue_);
+
+        /**
+            Destroys the pools of every thread, the device has to be idle and no thread may record anymore
+        */
+        void destroy(void);
+
+        /**
+            Returns the command pool statistics
+
+            @return     Returns a CommandPoolStats snapshot
+        */
+        CommandPoolStats stats(void);
+
+        /**
+            Writes the command pool statistics to the event log
+        */
+        void logStats(void);
+
+    }
+
+}
+#endif  // COMMAND_POOLS_HPP
@@ -10,6 +10,7 @@
 #include "Core.hpp"
 #include "VK.hpp"
 #include "ASSERT.cpp"
+#include "FileIO.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -26,19 +27,14 @@ namespace vk {
         VkExtent2D                                          swapchainImageExtent;
         BaseCamera*                                         camera;
         VkSampleCountFlagBits                               MSAASampleCount                      = VK_SAMPLE_COUNT_1_BIT;
-        std::queue< ModelInfo >                             modelLoadingQueue;
-        std::mutex                                          modelLoadingQueueMutex;
-        std::condition_variable                             modelLoadingQueueCondVar;
-        bool                                                finished                             = false;
-        bool                                                notified                             = false;
-        std::condition_variable                             assetsLoadedCondVar;
-        std::mutex                                          assetsLoadedMutex;
-        bool                                                assetsLoaded                         = false;
-        std::thread                                         assetThread;
+        ModelHandoff                                        streamedModels;
+        LoadScheduler*                                      loadScheduler                        = nullptr;
+        WorldStreamer*                                      worldStreamer                        = nullptr;
         bool                                                readyToRun                           = false;
         GLFWwindow*                                         window;
         GLFWmonitor*                                        monitor;
         VkInstance                                          instance                             = VK_NULL_HANDLE;
+        bool                                                properties2Enabled                   = false;      // VK_KHR_get_physical_device_properties2, VK_EXT_memory_budget needs it
         const std::vector< const char* >                    validationLayers                     = {
         
             "VK_LAYER_LUNARG_standard_validation"
@@ -68,7 +64,9 @@ namespace vk {
         std::vector< VkCommandBuffer >                      standardCommandBuffers;
         std::vector< VkSemaphore >                          swapchainImageAvailableSemaphores;
         std::vector< VkSemaphore >                          renderingCompletedSemaphores;
-        std::vector< VkFence >                              inFlightFences;
+        std::vector< uint64_t >                             inFlightValues;                                                     // The graphics timeline value of the last submission of each frame in flight
+        std::vector< uint64_t >                             imagesInFlight;                                                     // The graphics timeline value of the last submission that rendered to each swapchain image
+        std::vector< uint64_t >                             submittedFrames;                                                    // One past the frame last submitted in each slot, 0 if none was
         size_t                                              currentSwapchainImage                = 0;
         bool                                                hasFramebufferBeenResized            = false;
         BaseBuffer*                                         vpBuffer;  
@@ -87,13 +85,17 @@ namespace vk {
         bool                                                initialized                          = false;
         std::vector< Model* >                               models;
         bool                                                firstTimeRecreation                  = true;
-        std::vector< std::vector< DescriptorSet* > >        descriptorSets;
+        std::vector< FrameArena* >                          frameArenas;
+        std::vector< DescriptorPool* >                      frameDescriptorPools;
 
-        std::vector< std::thread* >                         modelLoadingQueueThreads;
-        std::vector< AssetLoader* >                         assetLoaders;
         uint32_t                                            maxThreads                           = std::thread::hardware_concurrency();
-
-        std::vector< std::thread* >                         renderThreads;
+        JobSystem*                                          jobSystem                            = nullptr;
+        std::mutex                                          pipelineStateMutex;                                                 // Guards what createStandardPipeline() reads against swapchain recreation
+        uint64_t                                            pipelineGeneration                   = 0;
+    #ifdef VK_HOT_RELOAD
+        HotReloader*                                        hotReloader                          = nullptr;
+    #endif
+        TextureResidency*                                   textureResidency                     = nullptr;
 
         void preInit() {
 
@@ -104,6 +106,18 @@ namespace vk {
 
         VK_STATUS_CODE init() {
 
+            vk::io::mount(vk::ASSET_PACKAGE);       // Before anything reads an asset, the loading screen included
+        #ifdef VK_METRICS
+            vk::metrics::serve(vk::METRICS_SOCKET);
+        #endif
+
+            jobSystem       = new JobSystem(std::max(maxThreads, 1u));
+            loadScheduler   = new LoadScheduler(jobSystem, &streamedModels, std::max(maxThreads, 1u));
+        #ifdef VK_HOT_RELOAD
+            hotReloader     = new HotReloader(jobSystem, { "res", "shaders" });
+        #endif
+            textureResidency = new TextureResidency(jobSystem);
+
             logger::log(EVENT_LOG, "Initializing loading screen...");
             initLoadingScreen();
             ASSERT(initWindow(), "Window initialization error", VK_SC_WINDOW_ERROR);
@@ -118,6 +132,10 @@ namespace vk {
             ASSERT(loop(), "Vulkan runtime error", VK_SC_VULKAN_RUNTIME_ERROR);
             ASSERT(clean(), "Application cleanup error", VK_SC_CLEANUP_ERROR);
             logger::log(START_LOG, "Shutting down...");
+        #ifdef VK_METRICS
+            vk::metrics::stop();
+        #endif
+            logger::shutdown();
 
             return vk::errorCodeBuffer;
 
@@ -184,9 +202,11 @@ namespace vk {
             glfwMakeContextCurrent(window);
             glfwSwapInterval(0);
             
+            std::shared_ptr< FileData > iconFile = vk::io::read("res/textures/loading_screen/infinity.jpg");
             GLFWimage windowIcon[1];
-            windowIcon[0].pixels = stbi_load(
-                "res/textures/loading_screen/infinity.jpg",
+            windowIcon[0].pixels = stbi_load_from_memory(
+                iconFile ? iconFile->data() : nullptr,
+                iconFile ? static_cast< int >(iconFile->size()) : 0,
                 &windowIcon[0].width,
                 &windowIcon[0].height,
                 0,
@@ -214,7 +234,11 @@ namespace vk {
 
         VK_STATUS_CODE initVulkan() {
 
+        #ifdef VK_HOST_ALLOCATOR
+            allocator = vk::hostmemory::callbacks();
+        #else
             allocator = nullptr;
+        #endif
 
             ASSERT(createInstance(), "Failed to create instance", VK_SC_INSTANCE_CREATON_ERROR);
             ASSERT(debugUtilsMessenger(), "Failed to create debug utils messenger", VK_SC_DEBUG_UTILS_MESSENGER_CREATION_ERROR);
@@ -231,7 +255,6 @@ namespace vk {
             ASSERT(allocateUniformBuffers(), "Failed to allocate uniform buffers", VK_SC_UNIFORM_BUFFER_CREATION_ERROR);
             ASSERT(allocateSwapchainFramebuffers(), "Failed to allocate framebuffers", VK_SC_FRAMEBUFFER_ALLOCATION_ERROR);
             ASSERT(createGraphicsPipelines(), "Failed to create graphics pipelines", VK_SC_GRAPHICS_PIPELINE_CREATION_ERROR);
-            assetThread = std::thread(&loadModelsAndVertexData);
 
             return vk::errorCodeBuffer;
 
@@ -239,16 +262,9 @@ namespace vk {
 
         VK_STATUS_CODE loop() {
 
-            std::scoped_lock< std::mutex > lock(vk::loadingMutex);
+            std::scoped_lock< Mutex > lock(vk::loadingMutex);
             readyToRun = true;
 
-            std::unique_lock< std::mutex > assetsLock(assetsLoadedMutex);
-            assetsLoadedCondVar.wait(assetsLock, [=]() { return assetsLoaded; });
-
-            assetThread.join();
-
-            std::scoped_lock< std::mutex > modelLock(modelLoadingQueueMutex);
-
             ASSERT(allocateCommandBuffers(), "Failed to allocate command buffers", VK_SC_COMMAND_BUFFER_ALLOCATION_ERROR);
             ASSERT(createCamera(), "Failed to create camera", VK_SC_CAMERA_CREATION_ERROR);
 
@@ -266,6 +282,7 @@ namespace vk {
             logger::log(EVENT_LOG, "Entering application loop...");
 
             double                    lastTime          = glfwGetTime();
+            vk::counters::countHeapAllocations(true);       // Steady-state frames are expected to allocate nothing
 
             while (!glfwWindowShouldClose(window)) {
 
@@ -288,6 +305,8 @@ namespace vk {
 
                 if (currentTime - lastTime >= seconds) {
 
+                    vk::counters::countHeapAllocations(false);      // The report itself allocates, it is not part of the frame
+
                     std::string fps                = "Average FPS (last " + std::to_string(seconds) + " seconds):    " + std::to_string(double(nbFrames / seconds)) + "\t";
                     std::string frametime          = "Average Frametime (last " + std::to_string(seconds) + " seconds):    " + std::to_string(double((1000.0 * seconds) / nbFrames)) + " ms\t";
                     std::string maxFPS             = "Max FPS:    " + std::to_string(double(maxfps / seconds)) + "\n";
@@ -295,20 +314,67 @@ namespace vk {
                     logger::log(EVENT_LOG, fps);
                     logger::log(EVENT_LOG, frametime);
                     logger::log(EVENT_LOG, maxFPS);
+                    vk::counters::logSummary();
 
                     nbFrames = 0;
                     lastTime += seconds;
 
+                    vk::counters::countHeapAllocations(true);
+
                 }
 
+                jobSystem->runMainThreadJobs();
+                adoptStreamedModels();
+            #ifdef VK_HOT_RELOAD
+                hotReloader->update(models);
+            #endif
+                textureResidency->update();
+                loadScheduler->reprioritize(camera->camPos);
+                if (worldStreamer != nullptr) worldStreamer->update(camera->camPos, models);
                 processKeyboardInput();
                 showNextSwapchainImage();
+                vk::counters::endFrame();
                 glfwPollEvents();
                 glfwSwapBuffers(window);
             
             }
 
-            vkDeviceWaitIdle(logicalDevice);
+            vk::counters::countHeapAllocations(false);
+            loadScheduler->cancelAll();
+        #ifdef VK_HOT_RELOAD
+            hotReloader->logStats();
+            vk::waitForDeviceIdle();
+            delete hotReloader;         // Waits for its reload jobs while the job system is still alive
+            hotReloader = nullptr;
+        #endif
+            textureResidency->logStats();
+            vk::waitForDeviceIdle();
+            delete textureResidency;    // Waits for its replacements while the job system is still alive
+            vk::deletion::flush();      // Retired models and textures may still use the job system when destroyed
+            textureResidency = nullptr;
+            jobSystem->logStats();
+            delete jobSystem;           // Finishes models that are still loading before the device goes idle
+            jobSystem = nullptr;
+            delete loadScheduler;
+            loadScheduler = nullptr;
+            adoptStreamedModels();
+            vk::textures::logStats();
+            vk::io::logStats();
+            if (worldStreamer != nullptr) worldStreamer->logStats();
+            vk::memory::logStats();
+        #ifdef VK_HOST_ALLOCATOR
+            vk::hostmemory::logStats();
+        #endif
+        #ifdef VK_LOCK_PROFILING
+            vk::locks::logStats();
+        #endif
+
+            vk::waitForDeviceIdle();
+            vk::deletion::flush();
+            vk::deletion::logStats();
+            vk::timeline::logStats();
+            vk::commands::logStats();
+            vk::ownership::logStats();
 
             logger::log(EVENT_LOG, "Terminating...");
 
@@ -325,7 +391,7 @@ namespace vk {
             for (auto model : models) {
 
                 delete model;
-                logger::log(EVENT_LOG, "Successfully destroyed model");    
+                VK_LOG_DEBUG(LC_CORE, "Successfully destroyed model");
             
             }
             logger::log(EVENT_LOG, "Successfully destroyed models");
@@ -333,14 +399,25 @@ namespace vk {
             delete camera;
             logger::log(EVENT_LOG, "Successfully destroyed camera");
 
-            std::unique_lock< std::mutex > transferLock(vk::transferMutex);
-            vkDestroyCommandPool(logicalDevice, vk::transferCommandPool, allocator);
-            transferLock.unlock();
-            logger::log(EVENT_LOG, "Successfully destroyed command pool");
+            delete worldStreamer;
+            logger::log(EVENT_LOG, "Successfully destroyed world streamer");
+
+            vk::deletion::flush();      // The device is idle since the end of the loop
+            logger::log(EVENT_LOG, "Successfully destroyed retired resources");
+
+            for (size_t i = 0; i < vk::MAX_IN_FLIGHT_FRAMES; i++) {
+
+                vkDestroySemaphore(logicalDevice, renderingCompletedSemaphores[i], allocator);
+                vkDestroySemaphore(logicalDevice, swapchainImageAvailableSemaphores[i], allocator);
+
+            }
+            vk::timeline::destroy();
+            logger::log(EVENT_LOG, "Successfully destroyed sync-objects");
+
+            vk::commands::destroy();
+            logger::log(EVENT_LOG, "Successfully destroyed command pools");
 
-            std::unique_lock< std::mutex > graphicsLock(vk::graphicsMutex);
             vkDestroyCommandPool(logicalDevice, vk::graphicsCommandPool, allocator);
-            graphicsLock.unlock();
             logger::log(EVENT_LOG, "Successfully destroyed command pool");
 
             vkDestroyDevice(logicalDevice, allocator);
@@ -486,6 +563,17 @@ namespace vk {
 
             }
 
+            for (const auto& ext : availableExtensions) {
+
+                if (std::string(ext.extensionName) == VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) {
+
+                    extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+                    properties2Enabled = true;
+
+                }
+
+            }
+
             return extensions;
 
         }
@@ -745,17 +833,64 @@ namespace vk {
 
             }
 
+            VkPhysicalDeviceFeatures supportedFeatures;
+            vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
             VkPhysicalDeviceFeatures physicalDeviceFeatures            = {};
             physicalDeviceFeatures.samplerAnisotropy                   = VK_TRUE;
             physicalDeviceFeatures.fillModeNonSolid                    = VK_TRUE;
+            physicalDeviceFeatures.textureCompressionBC                = supportedFeatures.textureCompressionBC;      // Optional, block-compressed textures fall back to RGBA8 without it
+        #ifdef VK_PIPELINE_STATISTICS
+            physicalDeviceFeatures.pipelineStatisticsQuery             = supportedFeatures.pipelineStatisticsQuery;   // Optional, shader invocations are not counted without it
+        #endif
+
+            std::vector< const char* > deviceExtensions(requiredExtensions.begin(), requiredExtensions.end());
+            bool memoryBudgetEnabled = false;
+            VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures      = {};
+            timelineFeatures.sType                                              = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+            if (properties2Enabled) {
+
+                uint32_t extensionCount = 0;
+                vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+                std::vector< VkExtensionProperties > availableExtensions(extensionCount);
+                vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+                for (const auto& ext : availableExtensions) {
+
+                    if (std::string(ext.extensionName) == VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) {
+
+                        deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);     // Optional, budgets are estimated from the heap sizes without it
+                        memoryBudgetEnabled = true;
+
+                    }
+                    else if (std::string(ext.extensionName) == VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) {
+
+                        VkPhysicalDeviceFeatures2 features      = {};
+                        features.sType                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+                        features.pNext                          = &timelineFeatures;
+
+                        auto getFeatures2 = reinterpret_cast< PFN_vkGetPhysicalDeviceFeatures2KHR >(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR"));
+                        if (getFeatures2 != nullptr) getFeatures2(physicalDevice, &features);
+                        if (timelineFeatures.timelineSemaphore) {
+
+                            deviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);     // Optional, the queue timelines are emulated with fences without it
+
+                        }
+
+                    }
+
+                }
+
+            }
 
             VkDeviceCreateInfo deviceCreateInfo                        = {};
             deviceCreateInfo.sType                                     = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
             deviceCreateInfo.queueCreateInfoCount                      = static_cast< uint32_t >(deviceQueueCreateInfos.size());
             deviceCreateInfo.pQueueCreateInfos                         = deviceQueueCreateInfos.data();
-            deviceCreateInfo.enabledExtensionCount                     = static_cast< uint32_t >(requiredExtensions.size());
-            deviceCreateInfo.ppEnabledExtensionNames                   = requiredExtensions.data();
+            deviceCreateInfo.enabledExtensionCount                     = static_cast< uint32_t >(deviceExtensions.size());
+            deviceCreateInfo.ppEnabledExtensionNames                   = deviceExtensions.data();
             deviceCreateInfo.pEnabledFeatures                          = &physicalDeviceFeatures;
+            deviceCreateInfo.pNext                                     = timelineFeatures.timelineSemaphore ? &timelineFeatures : nullptr;
 
             if (validationLayersEnabled) {
 
@@ -777,6 +912,7 @@ namespace vk {
                 );
             ASSERT(result, "Failed to create a logical device", VK_SC_LOGICAL_DEVICE_CREATION_ERROR);
             logger::log(EVENT_LOG, "Successfully created logical device");
+            vk::memory::init(instance, physicalDevice, memoryBudgetEnabled);
 
             logger::log(EVENT_LOG, "Retrieving queue handle for graphics queue...");
             vkGetDeviceQueue(
@@ -805,6 +941,8 @@ namespace vk {
                 );
             logger::log(EVENT_LOG, "Successfully retrieved queue handle for transfer queue");
 
+            ASSERT(vk::timeline::init(logicalDevice, timelineFeatures.timelineSemaphore == VK_TRUE), "Failed to create queue timelines", VK_SC_SEMAPHORE_CREATION_ERROR);
+
             return vk::errorCodeBuffer;
 
         }
@@ -861,9 +999,18 @@ namespace vk {
 
             loadingScreen = new LoadingScreen();
 
-            logger::log(EVENT_LOG, "Starting loading screen thread...");
-            std::thread t0(&LoadingScreen::loop, loadingScreen);
-            t0.detach();
+            logger::log(EVENT_LOG, "Starting loading screen...");
+            pumpLoadingScreen();
+
+        }
+
+        void pumpLoadingScreen() {
+
+            if (loadingScreen->tick()) {
+
+                jobSystem->submit(&pumpLoadingScreen, {}, JA_MAIN_THREAD);     // SDL has to be driven from the thread that created the window
+
+            }
 
         }
 
@@ -1033,7 +1180,7 @@ namespace vk {
             swapchainCreateInfo.compositeAlpha                       = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;                   // Window should not be blended with other windows behind it, no thanks
             swapchainCreateInfo.clipped                              = true;                                                // Do not render pixels that are outside the clip space as this is just performance loss
             swapchainCreateInfo.presentMode                          = presentMode;
-            swapchainCreateInfo.oldSwapchain                         = VK_NULL_HANDLE;
+            swapchainCreateInfo.oldSwapchain                         = swapchain;                                           // Retired by cleanSwapchain(), still valid until its last frame has finished
 
             VkResult result = vkCreateSwapchainKHR(
                 logicalDevice,
@@ -1059,6 +1206,7 @@ namespace vk {
                 swapchainImages.data()
                 );
             logger::log(EVENT_LOG, "Successfully retrieved the handles for the swapchain images");
+            imagesInFlight.assign(swapchainImages.size(), 0);
 
             return vk::errorCodeBuffer;
 
@@ -1091,6 +1239,83 @@ namespace vk {
 
             logger::log(EVENT_LOG, "Creating graphics pipeline...");
             
+            noImageSubstituent = new TextureImage(
+                "res/textures/application/transparent.png", 
+                VK_FORMAT_R8G8B8A8_UNORM, 
+                VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+                );
+
+            /* UNIFORM BINDINGS */    
+
+            VkDescriptorBufferInfo vpBufferInfo                                             = {};
+            vpBufferInfo.buffer                                                             = vpBuffer->buf;
+            vpBufferInfo.offset                                                             = 0;
+            vpBufferInfo.range                                                              = sizeof(VPBufferObject);
+                                                                                            
+            UniformInfo vpInfo                                                              = {};
+            vpInfo.binding                                                                  = 0;
+            vpInfo.stageFlags                                                               = VK_SHADER_STAGE_VERTEX_BIT;
+            vpInfo.bufferInfo                                                               = vpBufferInfo;
+            vpInfo.type                                                                     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            
+            vpDescriptor                                                                    = Descriptor(vpInfo);
+
+            VkDescriptorImageInfo noImageSubstituentImageInfo                               = {};
+            noImageSubstituentImageInfo.sampler                                             = noImageSubstituent->imgSampler;
+            noImageSubstituentImageInfo.imageView                                           = noImageSubstituent->imgView;
+            noImageSubstituentImageInfo.imageLayout                                         = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            UniformInfo noImageSubstituentInfo                                              = {};
+            noImageSubstituentInfo.binding                                                  = 15;
+            noImageSubstituentInfo.stageFlags                                               = VK_SHADER_STAGE_FRAGMENT_BIT;
+            noImageSubstituentInfo.imageInfo                                                = noImageSubstituentImageInfo;
+            noImageSubstituentInfo.type                                                     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+            noImageSubstituentDescriptor                                                    = Descriptor(noImageSubstituentInfo);
+
+            UniformInfo diffuseSamplerInfo                                                  = {};
+            diffuseSamplerInfo.binding                                                      = 1;
+            diffuseSamplerInfo.stageFlags                                                   = VK_SHADER_STAGE_FRAGMENT_BIT;
+            diffuseSamplerInfo.type                                                         = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                    
+            diffuseSampler1Descriptor                                                       = Descriptor(diffuseSamplerInfo);
+
+            diffuseSamplerInfo.binding                                                      = 2;
+
+            diffuseSampler2Descriptor                                                       = Descriptor(diffuseSamplerInfo);
+
+            VkDescriptorBufferInfo lightDataBufferInfo                                      = {};
+            lightDataBufferInfo.buffer                                                      = lightDataBuffer->buf;
+            lightDataBufferInfo.offset                                                      = 0;
+            lightDataBufferInfo.range                                                       = sizeof(LightData);
+
+            UniformInfo lightDataInfo                                                       = {};
+            lightDataInfo.binding                                                           = 3;
+            lightDataInfo.stageFlags                                                        = VK_SHADER_STAGE_FRAGMENT_BIT;
+            lightDataInfo.bufferInfo                                                        = lightDataBufferInfo;
+            lightDataInfo.type                                                              = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+
+            lightDataDescriptor = Descriptor(lightDataInfo);
+
+            standardDescriptors.push_back(vpDescriptor);
+            standardDescriptors.push_back(diffuseSampler1Descriptor);
+            standardDescriptors.push_back(diffuseSampler2Descriptor);
+            standardDescriptors.push_back(lightDataDescriptor);
+
+            standardDescriptorLayout = new DescriptorSetLayout(standardDescriptors);
+
+            standardPipeline = createStandardPipeline();
+            pipelineGeneration++;
+
+            logger::log(EVENT_LOG, "Successfully created graphics pipeline");
+
+            return vk::errorCodeBuffer;
+
+        }
+
+        GraphicsPipeline createStandardPipeline() {
+
             auto bindingDesc            = BaseVertex::getBindingDescription();
             auto attribDesc             = BaseVertex::getAttributeDescriptions();
 
@@ -1180,72 +1405,6 @@ namespace vk {
             dynamicStateCreateInfo.dynamicStateCount                                        = static_cast< uint32_t >(dynamicStates.size());
             dynamicStateCreateInfo.pDynamicStates                                           = dynamicStates.data();
                                     
-            noImageSubstituent = new TextureImage(
-                "res/textures/application/transparent.png", 
-                VK_FORMAT_R8G8B8A8_UNORM, 
-                VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
-                );
-
-            /* UNIFORM BINDINGS */    
-
-            VkDescriptorBufferInfo vpBufferInfo                                             = {};
-            vpBufferInfo.buffer                                                             = vpBuffer->buf;
-            vpBufferInfo.offset                                                             = 0;
-            vpBufferInfo.range                                                              = sizeof(VPBufferObject);
-                                                                                            
-            UniformInfo vpInfo                                                              = {};
-            vpInfo.binding                                                                  = 0;
-            vpInfo.stageFlags                                                               = VK_SHADER_STAGE_VERTEX_BIT;
-            vpInfo.bufferInfo                                                               = vpBufferInfo;
-            vpInfo.type                                                                     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            
-            vpDescriptor                                                                    = Descriptor(vpInfo);
-
-            VkDescriptorImageInfo noImageSubstituentImageInfo                               = {};
-            noImageSubstituentImageInfo.sampler                                             = noImageSubstituent->imgSampler;
-            noImageSubstituentImageInfo.imageView                                           = noImageSubstituent->imgView;
-            noImageSubstituentImageInfo.imageLayout                                         = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            UniformInfo noImageSubstituentInfo                                              = {};
-            noImageSubstituentInfo.binding                                                  = 15;
-            noImageSubstituentInfo.stageFlags                                               = VK_SHADER_STAGE_FRAGMENT_BIT;
-            noImageSubstituentInfo.imageInfo                                                = noImageSubstituentImageInfo;
-            noImageSubstituentInfo.type                                                     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-
-            noImageSubstituentDescriptor                                                    = Descriptor(noImageSubstituentInfo);
-
-            UniformInfo diffuseSamplerInfo                                                  = {};
-            diffuseSamplerInfo.binding                                                      = 1;
-            diffuseSamplerInfo.stageFlags                                                   = VK_SHADER_STAGE_FRAGMENT_BIT;
-            diffuseSamplerInfo.type                                                         = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                    
-            diffuseSampler1Descriptor                                                       = Descriptor(diffuseSamplerInfo);
-
-            diffuseSamplerInfo.binding                                                      = 2;
-
-            diffuseSampler2Descriptor                                                       = Descriptor(diffuseSamplerInfo);
-
-            VkDescriptorBufferInfo lightDataBufferInfo                                      = {};
-            lightDataBufferInfo.buffer                                                      = lightDataBuffer->buf;
-            lightDataBufferInfo.offset                                                      = 0;
-            lightDataBufferInfo.range                                                       = sizeof(LightData);
-
-            UniformInfo lightDataInfo                                                       = {};
-            lightDataInfo.binding                                                           = 3;
-            lightDataInfo.stageFlags                                                        = VK_SHADER_STAGE_FRAGMENT_BIT;
-            lightDataInfo.bufferInfo                                                        = lightDataBufferInfo;
-            lightDataInfo.type                                                              = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-
-            lightDataDescriptor = Descriptor(lightDataInfo);
-
-            standardDescriptors.push_back(vpDescriptor);
-            standardDescriptors.push_back(diffuseSampler1Descriptor);
-            standardDescriptors.push_back(diffuseSampler2Descriptor);
-            standardDescriptors.push_back(lightDataDescriptor);
-
-            standardDescriptorLayout = new DescriptorSetLayout(standardDescriptors);
-
             glm::mat4 modelMatrixSizeMatrix(1.0f);
             std::vector< VkPushConstantRange > pushConstants;
             VkPushConstantRange modelPushConstantRange                                      = {};
@@ -1255,7 +1414,7 @@ namespace vk {
 
             pushConstants.push_back(modelPushConstantRange);
 
-            standardPipeline = GraphicsPipeline(
+            return GraphicsPipeline(
                 "shaders/standard/vert.spv", 
                 "shaders/standard/frag.spv",
                 &vertexInputStateCreateInfo,
@@ -1273,10 +1432,6 @@ namespace vk {
                 renderPass
                 );
 
-            logger::log(EVENT_LOG, "Successfully created graphics pipeline");
-
-            return vk::errorCodeBuffer;
-
         }
 
         VK_STATUS_CODE createRenderPasses() {
@@ -1415,7 +1570,7 @@ namespace vk {
                     );
                 ASSERT(result, "Failed to create framebuffer", VK_SC_FRAMEBUFFER_ALLOCATION_ERROR);
 
-                logger::log(EVENT_LOG, "Successfully allocated framebuffer");
+                VK_LOG_DEBUG(LC_RENDER, "Successfully allocated framebuffer");
 
             }
 
@@ -1436,7 +1591,6 @@ namespace vk {
             commandPoolCreateInfo.flags                            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
             commandPoolCreateInfo.queueFamilyIndex                 = family.graphicsFamilyIndex.value();
 
-            std::unique_lock< std::mutex > graphicsLock(vk::graphicsMutex);
             VkResult result = vkCreateCommandPool(
                 logicalDevice,
                 &commandPoolCreateInfo,
@@ -1444,26 +1598,11 @@ namespace vk {
                 &vk::graphicsCommandPool
                 );
             ASSERT(result, "Failed to create command pool", VK_SC_COMMAND_POOL_ALLOCATION_ERROR);
-            graphicsLock.unlock();
 
             logger::log(EVENT_LOG, "Successfully allocated command pool");
 
-            logger::log(EVENT_LOG, "Allocating command pool...");
-
-            commandPoolCreateInfo                                  = {};
-            commandPoolCreateInfo.sType                            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-            commandPoolCreateInfo.queueFamilyIndex                 = family.transferFamilyIndex.value();
-
-            std::unique_lock< std::mutex > transferLock(vk::transferMutex);
-            result = vkCreateCommandPool(
-                logicalDevice,
-                &commandPoolCreateInfo,
-                allocator,
-                &vk::transferCommandPool
-                );
-            transferLock.unlock();
-
-            logger::log(EVENT_LOG, "Successfully allocated command pool");
+            vk::commands::init(family.graphicsFamilyIndex.value(), family.transferFamilyIndex.value());     // Uploads record into pools of their own thread
+            vk::ownership::init(family.graphicsFamilyIndex.value(), family.transferFamilyIndex.value());    // Uploads hand their resources from one to the other
 
             return vk::errorCodeBuffer;
 
@@ -1475,7 +1614,6 @@ namespace vk {
 
             standardCommandBuffers.resize(swapchainFramebuffers.size());        // For every frame in the swapchain, create a command buffer
 
-            std::scoped_lock< std::mutex > graphicsLock(vk::graphicsMutex);
             VkCommandBufferAllocateInfo commandBufferAllocateInfo          = {};
             commandBufferAllocateInfo.sType                                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
             commandBufferAllocateInfo.commandPool                          = vk::graphicsCommandPool;
@@ -1489,12 +1627,14 @@ namespace vk {
                 );
             ASSERT(result, "Failed to allocate command buffers", VK_SC_COMMAND_BUFFER_ALLOCATION_ERROR);
             logger::log(EVENT_LOG, "Successfully allocated command buffers");
-            descriptorSets.resize(swapchainImages.size());
+            vk::counters::createQueries(static_cast< uint32_t >(standardCommandBuffers.size()));
             for (uint32_t i = 0; i < swapchainImages.size(); i++) {
 
-                recordCommandBuffer(i);
+                frameArenas.push_back(new FrameArena(vk::FRAME_ARENA_SIZE));
+                frameDescriptorPools.push_back(new DescriptorPool(standardDescriptorLayout, vk::FRAME_DESCRIPTOR_SETS));
 
             }
+            // Recorded by showNextSwapchainImage() right before each submission, a recording that is never submitted would lose the acquires it took
 
             return vk::errorCodeBuffer;
 
@@ -1502,12 +1642,31 @@ namespace vk {
 
         VK_STATUS_CODE recordCommandBuffer(uint32_t imageIndex_) {
 
-            for (auto desc : descriptorSets[imageIndex_]) {
+            vk::counters::collectQuery(imageIndex_);       // The last submission of this command buffer has finished, it was waited on
+
+            FrameArena* arena = frameArenas[imageIndex_];
+            arena->reset();         // Everything the last recording of this command buffer allocated is unused now
+
+            uint32_t meshCount = 0;
+            for (Model* model : models) {
 
-                delete desc;
+                meshCount += static_cast< uint32_t >(model->meshes.size());
+
+            }
+
+            if (meshCount > frameDescriptorPools[imageIndex_]->maxSets) {
+
+                uint32_t maxSets = std::max(frameDescriptorPools[imageIndex_]->maxSets * 2, meshCount);
+                delete frameDescriptorPools[imageIndex_];
+                frameDescriptorPools[imageIndex_] = new DescriptorPool(standardDescriptorLayout, maxSets);
+                VK_LOG_DEBUG(LC_RENDER, "Grew the descriptor pool of command buffer {} to {} sets", imageIndex_, maxSets);
+
+            }
+            else {
+
+                frameDescriptorPools[imageIndex_]->reset();
 
             }
-            descriptorSets[imageIndex_].clear();
 
             VkCommandBufferBeginInfo commandBufferBeginInfo            = {};
             commandBufferBeginInfo.sType                               = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -1515,6 +1674,8 @@ namespace vk {
 
             VkResult result = vkBeginCommandBuffer(standardCommandBuffers[imageIndex_], &commandBufferBeginInfo);
             ASSERT(result, "Failed to begin command buffer", VK_SC_COMMAND_BUFFER_ALLOCATION_ERROR);
+            vk::counters::resetQuery(standardCommandBuffers[imageIndex_], imageIndex_);      // Has to happen outside of the render pass
+            vk::ownership::acquire(standardCommandBuffers[imageIndex_]);       // Every upload finished so far, before any model that uses it is drawn
 
             VkRenderPassBeginInfo renderPassBeginInfo                  = {};
             renderPassBeginInfo.sType                                  = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -1531,57 +1692,66 @@ namespace vk {
             renderPassBeginInfo.pClearValues                           = clearColorValues.data();
 
             vkCmdBeginRenderPass(standardCommandBuffers[imageIndex_], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);        // Rendering commands will be embedded in the primary command buffer
+            vk::counters::beginQuery(standardCommandBuffers[imageIndex_], imageIndex_);
 
                 vkCmdBindPipeline(standardCommandBuffers[imageIndex_], VK_PIPELINE_BIND_POINT_GRAPHICS, standardPipeline.pipeline);
+                vk::counters::add(FC_PIPELINE_BINDS);
 
                     for (Model* model : models) {
                         
                         for (Mesh* mesh : model->meshes) {
 
-                            std::vector< Descriptor > descriptors;
+                            FrameVector< Descriptor > descriptors{ FrameAllocator< Descriptor >(arena) };
+                            descriptors.reserve(standardDescriptors.size());
 
                             descriptors.push_back(vpDescriptor);
                             descriptors.push_back(lightDataDescriptor);
 
-                            auto meshDescriptors = mesh->getDescriptors();
-                            descriptors.insert(descriptors.end(), meshDescriptors.begin(), meshDescriptors.end());
+                            mesh->getDescriptors(descriptors);
 
-                            if (meshDescriptors.size() != standardDescriptors.size()) {
+                            descriptors.erase(std::remove_if(descriptors.begin(), descriptors.end(), [](const Descriptor& descriptor_) {        // The set is allocated with the standard layout
 
-                                for (auto standardDescriptor : standardDescriptors) {
+                                for (const auto& standardDescriptor : standardDescriptors) {
 
-                                    if (standardDescriptor.info.type != VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) continue;
+                                    if (standardDescriptor.info.binding == descriptor_.info.binding && standardDescriptor.info.type == descriptor_.info.type) return false;
 
-                                    uint32_t binding            = standardDescriptor.info.binding;
-                                    bool hasCorrectBinding      = false;
+                                }
 
-                                    for (auto meshDescriptor : meshDescriptors) {
+                                return true;
 
-                                        if (meshDescriptor.info.binding == binding) {
+                                }), descriptors.end());
 
-                                            hasCorrectBinding = true;
+                            for (const auto& standardDescriptor : standardDescriptors) {
 
-                                        }
+                                if (standardDescriptor.info.type != VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) continue;
 
-                                    }
+                                uint32_t binding            = standardDescriptor.info.binding;
+                                bool hasCorrectBinding      = false;
 
-                                    if (!hasCorrectBinding) {
-                                                                            
-                                        noImageSubstituentDescriptor.info.binding = binding;
+                                for (const auto& descriptor : descriptors) {
 
-                                        descriptors.push_back(noImageSubstituentDescriptor);
+                                    if (descriptor.info.binding == binding) {
+
+                                        hasCorrectBinding = true;
 
                                     }
 
                                 }
 
+                                if (!hasCorrectBinding) {
+
+                                    noImageSubstituentDescriptor.info.binding = binding;
+
+                                    descriptors.push_back(noImageSubstituentDescriptor);
+
+                                }
+
                             }
 
-                            DescriptorSet* descSet = new DescriptorSet(descriptors);
+                            DescriptorSet* descSet = arena->create< DescriptorSet >(frameDescriptorPools[imageIndex_], standardDescriptorLayout);
                             descSet->update(descriptors);
 
                             descSet->bind(standardCommandBuffers, static_cast< uint32_t >(imageIndex_), standardPipeline);
-                            descriptorSets[imageIndex_].push_back(descSet);
 
                             glm::mat4 modelMatrix = model->getModelMatrix();
 
@@ -1600,6 +1770,7 @@ namespace vk {
                       
                     }
 
+            vk::counters::endQuery(standardCommandBuffers[imageIndex_], imageIndex_);
             vkCmdEndRenderPass(standardCommandBuffers[imageIndex_]);
 
             result = vkEndCommandBuffer(standardCommandBuffers[imageIndex_]);
@@ -1608,16 +1779,25 @@ namespace vk {
         }
 
         VK_STATUS_CODE showNextSwapchainImage() {
+
+            static Counter*     framesMetric        = vk::metrics::counter("render_frames_total", "Frames submitted");
+            static Histogram*   frameTimeMetric     = vk::metrics::histogram("render_frame_time_us", "Time between the starts of two frames in microseconds");
+            static Histogram*   fenceWaitMetric     = vk::metrics::histogram("render_fence_wait_us", "Time spent waiting for a frame in flight to retire in microseconds");
+            static Gauge*       modelsMetric        = vk::metrics::gauge("render_models", "Models being drawn");
+            static auto         lastFrame           = std::chrono::steady_clock::now();
+
+            auto frameStart = std::chrono::steady_clock::now();
+            frameTimeMetric->observe(static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::microseconds >(frameStart - lastFrame).count()));
+            lastFrame = frameStart;
             
-            vkWaitForFences(
-                logicalDevice,
-                1,
-                &inFlightFences[currentSwapchainImage],
-                VK_TRUE,
-                std::numeric_limits< uint64_t >::max()
-                );
+            vk::timeline::wait(GRAPHICS_QUEUE, inFlightValues[currentSwapchainImage]);
+            fenceWaitMetric->observe(static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::microseconds >(std::chrono::steady_clock::now() - frameStart).count()));
 
-            vkResetFences(logicalDevice, 1, &inFlightFences[currentSwapchainImage]);
+            if (submittedFrames[currentSwapchainImage] > 0) {
+
+                vk::deletion::collect(submittedFrames[currentSwapchainImage] - 1);         // Submissions retire in order, so everything up to that frame is done
+
+            }
 
             uint32_t swapchainImageIndex;
             VkResult result = vkAcquireNextImageKHR(
@@ -1638,17 +1818,17 @@ namespace vk {
             }
             ASSERT(result, "Failed to acquire swapchain image", VK_SC_SWAPCHAIN_IMAGE_ACQUIRE_ERROR);
 
-            std::unique_lock< std::mutex > gLock(vk::graphicsMutex);
-            vkResetCommandBuffer(standardCommandBuffers[swapchainImageIndex], 0);
+            vk::timeline::wait(GRAPHICS_QUEUE, imagesInFlight[swapchainImageIndex]);          // The image's command buffer, frame arena and descriptor pool may belong to another frame in flight
+
+            vkResetCommandBuffer(standardCommandBuffers[swapchainImageIndex], 0);      // The graphics command pool belongs to this thread, uploads use their own
             recordCommandBuffer(static_cast<uint32_t>(swapchainImageIndex));
-            gLock.unlock();
 
             ASSERT(updateUniformBuffers(), "Failed to update uniform buffers", VK_SC_UNIFORM_BUFFER_UPDATE_ERROR);
 
             VkSubmitInfo submitInfo                            = {};
             submitInfo.sType                                   = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-            std::unique_lock< std::mutex > lock(vk::graphicsMutex);
+            std::unique_lock< Mutex > lock(vk::graphicsMutex);
             VkSemaphore waitSemaphores[]                       = {swapchainImageAvailableSemaphores[currentSwapchainImage]};
             VkPipelineStageFlags waitStages[]                  = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
             submitInfo.waitSemaphoreCount                      = 1;
@@ -1656,19 +1836,20 @@ namespace vk {
             submitInfo.pWaitDstStageMask                       = waitStages;
             submitInfo.commandBufferCount                      = 1;
             submitInfo.pCommandBuffers                         = &standardCommandBuffers[swapchainImageIndex];
-            lock.unlock();
 
             VkSemaphore signalSemaphores[]                     = {renderingCompletedSemaphores[currentSwapchainImage]};
             submitInfo.signalSemaphoreCount                    = 1;
             submitInfo.pSignalSemaphores                       = signalSemaphores;
 
-            result = vkQueueSubmit(
-                vk::graphicsQueue,
-                1,
-                &submitInfo,
-                inFlightFences[currentSwapchainImage]
-                );
+            uint64_t value = 0;
+            result = vk::timeline::submit(GRAPHICS_QUEUE, submitInfo, &value);       // Loader jobs submit uploads to the same queue while the loop is running
+            lock.unlock();
             ASSERT(result, "Draw buffer submission failed", VK_SC_QUEUE_SUBMISSION_ERROR);
+            inFlightValues[currentSwapchainImage]   = value;
+            imagesInFlight[swapchainImageIndex]     = value;
+            submittedFrames[currentSwapchainImage]  = vk::counters::frame() + 1;
+            framesMetric->add();
+            modelsMetric->set(static_cast< int64_t >(models.size()));
 
             VkPresentInfoKHR presentationInfo                  = {};
             presentationInfo.sType                             = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -1680,10 +1861,13 @@ namespace vk {
             presentationInfo.pSwapchains                       = swapchains;
             presentationInfo.pImageIndices                     = &swapchainImageIndex;
 
-            result = vkQueuePresentKHR(presentationQueue, &presentationInfo);
+            lock.lock();
+            result = vkQueuePresentKHR(presentationQueue, &presentationInfo);       // The presentation queue may be the graphics queue
+            lock.unlock();
             if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || hasFramebufferBeenResized) {
 
                 hasFramebufferBeenResized = false;
+                currentSwapchainImage = (currentSwapchainImage + 1) % vk::MAX_IN_FLIGHT_FRAMES;        // The frame was submitted, its semaphores are in use
                 recreateSwapchain();
 
                 return VK_SC_SWAPCHAIN_RECREATED;
@@ -1703,15 +1887,12 @@ namespace vk {
 
             swapchainImageAvailableSemaphores.resize(vk::MAX_IN_FLIGHT_FRAMES);
             renderingCompletedSemaphores.resize(vk::MAX_IN_FLIGHT_FRAMES);
-            inFlightFences.resize(vk::MAX_IN_FLIGHT_FRAMES);
+            inFlightValues.assign(vk::MAX_IN_FLIGHT_FRAMES, 0);
+            submittedFrames.assign(vk::MAX_IN_FLIGHT_FRAMES, 0);
 
             VkSemaphoreCreateInfo semaphoreCreateInfo        = {};
             semaphoreCreateInfo.sType                        = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-            VkFenceCreateInfo fenceCreateInfo                = {};
-            fenceCreateInfo.sType                            = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-            fenceCreateInfo.flags                            = VK_FENCE_CREATE_SIGNALED_BIT;
-
             for (size_t i = 0; i < vk::MAX_IN_FLIGHT_FRAMES; i++) {
 
                 VkResult result = vkCreateSemaphore(
@@ -1721,7 +1902,7 @@ namespace vk {
                     &swapchainImageAvailableSemaphores[i]
                     );
                 ASSERT(result, "Failed to create semaphore", VK_SC_SEMAPHORE_CREATION_ERROR);
-                logger::log(EVENT_LOG, "Successfully initialized semaphore");
+                VK_LOG_DEBUG(LC_RENDER, "Successfully initialized semaphore");
 
                 result = vkCreateSemaphore(
                     logicalDevice,
@@ -1730,37 +1911,10 @@ namespace vk {
                     &renderingCompletedSemaphores[i]
                     );
                 ASSERT(result, "Failed to create semaphore", VK_SC_SEMAPHORE_CREATION_ERROR);
-                logger::log(EVENT_LOG, "Successfully initialized semaphore");
-
-                result = vkCreateFence(
-                    logicalDevice,
-                    &fenceCreateInfo,
-                    allocator,
-                    &inFlightFences[i]
-                    );
-                ASSERT(result, "Failed to create fence", VK_SC_FENCE_CREATION_ERROR);
-                logger::log(EVENT_LOG, "Successfully initialized fence");
+                VK_LOG_DEBUG(LC_RENDER, "Successfully initialized semaphore");
 
             }
 
-            VkResult result = vkCreateFence(
-                logicalDevice,
-                &fenceCreateInfo,
-                allocator,
-                &vk::graphicsFence
-                );
-            ASSERT(result, "Failed to create fence", VK_SC_FENCE_CREATION_ERROR);
-            logger::log(EVENT_LOG, "Successfully initialized graphics fence");
-
-            result = vkCreateFence(
-                logicalDevice,
-                &fenceCreateInfo,
-                allocator,
-                &vk::transferFence
-                );
-            ASSERT(result, "Failed to create fence", VK_SC_FENCE_CREATION_ERROR);
-            logger::log(EVENT_LOG, "Successfully initialized transfer fence");
-
             logger::log(EVENT_LOG, "Successfully initialized sync-objects");
 
             return vk::errorCodeBuffer;
@@ -1771,8 +1925,6 @@ namespace vk {
 
             if (!firstTimeRecreation) {
 
-                vkDeviceWaitIdle(logicalDevice);
-                std::unique_lock< std::mutex > commandLock(vk::commandBufferMutex);
                 int width = 0;
                 int height = 0;
                 while (width == 0 || height == 0) {
@@ -1782,18 +1934,17 @@ namespace vk {
 
                 }
 
-                commandLock.unlock();
-
+                std::unique_lock< std::mutex > pipelineLock(pipelineStateMutex);
                 cleanSwapchain();
 
                 ASSERT(createSwapchain(), "Failed to create a swapchain with the given parameters", VK_SC_SWAPCHAIN_CREATION_ERROR);
                 ASSERT(createSwapchainImageViews(), "Failed to create swapchain image views", VK_SC_SWAPCHAIN_IMAGE_VIEWS_CREATION_ERROR);
-                ASSERT(initializeSynchronizationObjects(), "Failed to initialize sync-objects", VK_SC_SYNCHRONIZATION_OBJECT_INITIALIZATION_ERROR);
                 ASSERT(allocateMSAABufferedImage(), "Failed to allocate multisampling-buffer", VK_SC_MSAA_BUFFER_CREATION_ERROR);
                 ASSERT(allocateDepthBuffer(), "Failed to allocate depth buffer", VK_SC_DEPTH_BUFFER_CREATION_ERROR);
                 ASSERT(createRenderPasses(), "Failed to create render passes", VK_SC_RENDER_PASS_CREATION_ERROR);
                 ASSERT(allocateUniformBuffers(), "Failed to allocate uniform buffers", VK_SC_UNIFORM_BUFFER_CREATION_ERROR);
                 ASSERT(createGraphicsPipelines(), "Failed to create graphics pipelines", VK_SC_GRAPHICS_PIPELINE_CREATION_ERROR);
+                pipelineLock.unlock();
                 ASSERT(allocateSwapchainFramebuffers(), "Failed to allocate framebuffers", VK_SC_FRAMEBUFFER_ALLOCATION_ERROR);
                 ASSERT(allocateCommandBuffers(), "Failed to allocate command buffers", VK_SC_COMMAND_BUFFER_ALLOCATION_ERROR);
 
@@ -1809,78 +1960,49 @@ namespace vk {
 
             logger::log(EVENT_LOG, "Cleaning swapchain...");
 
-            delete standardDescriptorLayout;
-            logger::log(EVENT_LOG, "Successfully destroyed descriptor set layout");
-            standardDescriptors.clear();
+            retirePipelineResources();
 
-            for (auto vec : descriptorSets) {
+            BaseBuffer* viewProjection  = vpBuffer;
+            BaseBuffer* lightData       = lightDataBuffer;
+            vk::deletion::retire([viewProjection, lightData]() {
 
-                for (auto descriptorSet : vec) {
+                delete viewProjection;
+                delete lightData;
 
-                    delete descriptorSet;
-                    logger::log(EVENT_LOG, "Successfully destroyed descriptor set");
+            });
+            logger::log(EVENT_LOG, "Successfully retired uniform buffers");
 
-                }
-
-            }
-            logger::log(EVENT_LOG, "Successfully destroyed descriptor sets");
-            descriptorSets.clear();
-
-            delete vpBuffer;
-            delete lightDataBuffer;
-            logger::log(EVENT_LOG, "Successfully destroyed uniform buffers");
-
-            delete depthBuffer;
-            logger::log(EVENT_LOG, "Successfully destroyed depth buffer");
+            BaseImage* depth = depthBuffer;
+            vk::deletion::retire([depth]() { delete depth; });
+            logger::log(EVENT_LOG, "Successfully retired depth buffer");
         #ifndef VK_MULTISAMPLING_NONE
-            delete msaaBufferImage;
-            logger::log(EVENT_LOG, "Successfully destroyed multisampled color-buffer");
+            BaseImage* msaa = msaaBufferImage;
+            vk::deletion::retire([msaa]() { delete msaa; });
+            logger::log(EVENT_LOG, "Successfully retired multisampled color-buffer");
         #endif
 
-            logger::log(EVENT_LOG, "Destroying framebuffers...");
-            for (auto framebuffer : swapchainFramebuffers) {
-
-                vkDestroyFramebuffer(logicalDevice, framebuffer, allocator);
-                logger::log(EVENT_LOG, "Successfully destroyed framebuffer");
-
-            }
-            logger::log(EVENT_LOG, "Successfully destroyed framebuffers");
-
-            std::unique_lock< std::mutex > lock(vk::graphicsMutex);
-            vkFreeCommandBuffers(
-                logicalDevice,
-                vk::graphicsCommandPool,
-                static_cast< uint32_t >(standardCommandBuffers.size()),
-                standardCommandBuffers.data()
-                );
-            lock.unlock();
-            logger::log(EVENT_LOG, "Successfully freed command buffers");
-
-            standardPipeline.destroy();
-
-            vkDestroyRenderPass(logicalDevice, renderPass, allocator);
-            logger::log(EVENT_LOG, "Successfully destroyed render pass");
+            std::vector< VkFramebuffer > framebuffers   = swapchainFramebuffers;
+            std::vector< VkImageView > imageViews       = swapchainImageViews;
+            VkRenderPass pass                           = renderPass;
+            VkSwapchainKHR retiredSwapchain             = swapchain;           // Stays in swapchain as the oldSwapchain of its successor
+            vk::deletion::retire([framebuffers, imageViews, pass, retiredSwapchain]() {
 
-            for (auto imageView : swapchainImageViews) {
+                for (auto framebuffer : framebuffers) {
 
-                vkDestroyImageView(logicalDevice, imageView, allocator);
-                logger::log(EVENT_LOG, "Successfully destroyed image view");
+                    vkDestroyFramebuffer(logicalDevice, framebuffer, allocator);
 
-            }
-
-            vkDestroySwapchainKHR(logicalDevice, swapchain, allocator);
-            logger::log(EVENT_LOG, "Successfully destroyed swapchain");
+                }
+                vkDestroyRenderPass(logicalDevice, pass, allocator);
+                for (auto imageView : imageViews) {
 
-            for (size_t i = 0; i < vk::MAX_IN_FLIGHT_FRAMES; i++) {
+                    vkDestroyImageView(logicalDevice, imageView, allocator);
 
-                vkDestroySemaphore(logicalDevice, renderingCompletedSemaphores[i], allocator);
-                vkDestroySemaphore(logicalDevice, swapchainImageAvailableSemaphores[i], allocator);
-                vkDestroyFence(logicalDevice, inFlightFences[i], allocator);
+                }
+                vkDestroySwapchainKHR(logicalDevice, retiredSwapchain, allocator);
+                VK_LOG_DEBUG(LC_RENDER, "Successfully destroyed retired swapchain");
 
-            }
-            vkDestroyFence(logicalDevice, vk::graphicsFence, allocator);
-            vkDestroyFence(logicalDevice, vk::transferFence, allocator);
-            logger::log(EVENT_LOG, "Successfully destroyed sync-objects");
+            });
+            logger::log(EVENT_LOG, "Successfully retired framebuffers, render pass, image views and swapchain");
             
             logger::log(EVENT_LOG, "Successfully cleaned swapchain");
 
@@ -1965,24 +2087,21 @@ namespace vk {
             if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS) {
 
                 polygonMode = VK_POLYGON_MODE_FILL;
-                std::thread t0(&recreateGraphicsPipelines);
-                t0.join();
+                recreateGraphicsPipelines();
 
             }
 
             if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS) {
 
                 polygonMode = VK_POLYGON_MODE_LINE;
-                std::thread t0(&recreateGraphicsPipelines);
-                t0.join();
+                recreateGraphicsPipelines();
 
             }
 
             if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS) {
 
                 polygonMode = VK_POLYGON_MODE_POINT;
-                std::thread t0(&recreateGraphicsPipelines);
-                t0.join();
+                recreateGraphicsPipelines();
 
             }
 
@@ -2067,114 +2186,104 @@ namespace vk {
 
         }
 
-        VK_STATUS_CODE loadModelsAndVertexData() {
+        void adoptStreamedModels() {
 
-            for (uint32_t i = 0; i < maxThreads; i++) {
-            
-                AssetLoader* loader = new AssetLoader();
+            size_t count = streamedModels.adopt(models);        // Command buffers are re-recorded every frame, so adopted models are drawn from this frame on
+
+            if (count > 0) {
 
-                std::thread* t0 = new std::thread(std::ref(*loader));
-                assetLoaders.push_back(loader);
-                modelLoadingQueueThreads.push_back(t0);
+                logger::log(EVENT_LOG, "Streamed in " + std::to_string(count) + " model(s)");
 
             }
 
-            std::unique_lock< std::mutex > stopLock(modelLoadingQueueMutex);
-            finished = true;
-            notified = true;
-            modelLoadingQueueCondVar.notify_all();
-            stopLock.unlock();
+        }
 
-            for (uint32_t i = 0; i < modelLoadingQueueThreads.size(); i++) {
+        ModelHandle push(const char* path_, glm::mat4 (*modelMatrixFunc_)()) {
 
-                modelLoadingQueueThreads[i]->join();
-                auto threadModels = assetLoaders[i]->get();
-                models.insert(models.end(), threadModels.begin(), threadModels.end());
-                delete modelLoadingQueueThreads[i];
+            return loadScheduler->push({ path_, standardPipeline, VK_STANDARD_MODEL_LOADING_LIB, modelMatrixFunc_ });
 
-            }
+        }
 
-            std::scoped_lock< std::mutex > lock(assetsLoadedMutex);
-            assetsLoaded = true;
-            assetsLoadedCondVar.notify_all();
+        ModelHandle push(ModelInfo info_, float bias_) {
 
-            return vk::errorCodeBuffer;
+            return loadScheduler->push(info_, bias_);
 
         }
 
-        VK_STATUS_CODE push(const char* path_, glm::mat4 (*modelMatrixFunc_)()) {
+        VK_STATUS_CODE stream(const char* manifest_) {
 
-            std::unique_lock< std::mutex > lock(modelLoadingQueueMutex);
-            modelLoadingQueue.push({ path_, standardPipeline, VK_STANDARD_MODEL_LOADING_LIB, modelMatrixFunc_ });
-            notified = true;
-            modelLoadingQueueCondVar.notify_one();
-            lock.unlock();
+            if (worldStreamer != nullptr) {
+
+                logger::log(ERROR_LOG, "A scene manifest is already being streamed");
+
+            }
+
+            worldStreamer = new WorldStreamer(
+                manifest_,
+                loadScheduler,
+                standardPipeline,
+                vk::WORLD_CELL_SIZE,
+                vk::WORLD_LOAD_RADIUS,
+                vk::WORLD_UNLOAD_RADIUS,
+                vk::WORLD_MEMORY_BUDGET
+                );
 
             return vk::errorCodeBuffer;
 
         }
 
-        VK_STATUS_CODE push(ModelInfo info_) {
+        VK_STATUS_CODE recreateGraphicsPipelines() {
 
-            std::unique_lock< std::mutex > lock(modelLoadingQueueMutex);
-            modelLoadingQueue.push(info_);
-            notified = true;
-            modelLoadingQueueCondVar.notify_one();
-            lock.unlock();
+            std::scoped_lock< std::mutex > pipelineLock(pipelineStateMutex);
+            retirePipelineResources();
+            TextureImage* substitute = noImageSubstituent;
+            vk::deletion::retire([substitute]() { delete substitute; });
+            ASSERT(createGraphicsPipelines(), "Failed to create graphics pipelines", VK_SC_GRAPHICS_PIPELINE_CREATION_ERROR);
+            ASSERT(allocateCommandBuffers(), "Failed to allocate command buffers", VK_SC_COMMAND_BUFFER_ALLOCATION_ERROR);
 
             return vk::errorCodeBuffer;
 
         }
 
-        void multithreadedNextSwapchainImage() {
-
-            renderThreads.resize(swapchainImages.size());
+        void retirePipelineResources() {
 
-            for (uint32_t i = 0; i < renderThreads.size(); i++) {
-            
-                renderThreads[i] = new std::thread([=]() {
-                    
+            std::vector< VkCommandBuffer > commandBuffers = standardCommandBuffers;
+            standardCommandBuffers.clear();
+            vk::deletion::retire([commandBuffers]() {
 
-                    
-                });
+                vkFreeCommandBuffers(
+                    logicalDevice,
+                    vk::graphicsCommandPool,
+                    static_cast< uint32_t >(commandBuffers.size()),
+                    commandBuffers.data()
+                    );
 
-            
-            }
+            });
+            logger::log(EVENT_LOG, "Successfully retired command buffers");
+            vk::counters::destroyQueries();
 
-        }
+            DescriptorSetLayout* layout = standardDescriptorLayout;
+            vk::deletion::retire([layout]() { delete layout; });
+            standardDescriptors.clear();
 
-        VK_STATUS_CODE recreateGraphicsPipelines() {
+            std::vector< FrameArena* > arenas           = frameArenas;
+            std::vector< DescriptorPool* > pools        = frameDescriptorPools;
+            vk::deletion::retire([arenas, pools]() {
 
-            vkDeviceWaitIdle(logicalDevice);
-            std::unique_lock< std::mutex > lock(vk::graphicsMutex);
-            vkFreeCommandBuffers(
-                logicalDevice,
-                vk::graphicsCommandPool,
-                static_cast< uint32_t >(standardCommandBuffers.size()),
-                standardCommandBuffers.data()
-                );
-            lock.unlock();
-            logger::log(EVENT_LOG, "Successfully freed command buffers");
-            delete standardDescriptorLayout;
-            standardDescriptors.clear();
-            for (auto vec : descriptorSets) {
-                
-                for (auto descSet : vec) {
+                for (size_t i = 0; i < arenas.size(); i++) {
 
-                    delete descSet;
-                    logger::log(EVENT_LOG, "Successfully destroyed descriptor set");
+                    delete arenas[i];           // Runs the destructors of the descriptor sets before their pool goes away
+                    delete pools[i];
 
-             
                 }
-            }
-            descriptorSets.clear();
-            logger::log(EVENT_LOG, "Successfully destroyed descriptor sets");
-            delete noImageSubstituent;
-            standardPipeline.destroy();
-            ASSERT(createGraphicsPipelines(), "Failed to create graphics pipelines", VK_SC_GRAPHICS_PIPELINE_CREATION_ERROR);
-            ASSERT(allocateCommandBuffers(), "Failed to allocate command buffers", VK_SC_COMMAND_BUFFER_ALLOCATION_ERROR);
 
-            return vk::errorCodeBuffer;
+            });
+            frameArenas.clear();
+            frameDescriptorPools.clear();
+            logger::log(EVENT_LOG, "Successfully retired descriptor sets");
+
+            GraphicsPipeline pipeline = standardPipeline;
+            vk::deletion::retire([pipeline]() mutable { pipeline.destroy(); });
 
         }
 
@@ -48,6 +48,7 @@
 #include "UniformBuffer.hpp"
 #include "MVPBufferObject.cpp"
 #include "TextureImage.hpp"
+#include "TextureRegistry.hpp"
 #include "BaseCamera.hpp"
 #include "FPSCamera.hpp"
 #include "CenterCamera.hpp"
@@ -56,9 +57,23 @@
 #include "Model.hpp"
 #include "Descriptor.hpp"
 #include "DescriptorSet.hpp"
+#include "FrameArena.hpp"
 #include "ModelInfo.cpp"
 #include "Queue.cpp"
-#include "AssetLoader.hpp"
+#include "JobSystem.hpp"
+#include "ModelHandoff.hpp"
+#include "LoadScheduler.hpp"
+#include "WorldStreamer.hpp"
+#include "HotReloader.hpp"
+#include "Metrics.hpp"
+#include "FrameCounters.hpp"
+#include "HostAllocator.hpp"
+#include "MemoryBudget.hpp"
+#include "TextureResidency.hpp"
+#include "DeletionQueue.hpp"
+#include "Timeline.hpp"
+#include "CommandPools.hpp"
+#include "Ownership.hpp"
 #include "LightData.cpp"
 
 namespace vk {
@@ -76,15 +91,9 @@ namespace vk {
         extern VkExtent2D                                       swapchainImageExtent;
         extern BaseCamera*                                      camera;
         extern VkSampleCountFlagBits                            MSAASampleCount;
-        extern std::queue< ModelInfo >                          modelLoadingQueue;
-        extern std::mutex                                       modelLoadingQueueMutex;
-        extern std::condition_variable                          modelLoadingQueueCondVar;
-        extern bool                                             finished;
-        extern bool                                             notified;
-        extern std::condition_variable                          assetsLoadedCondVar;
-        extern std::mutex                                       assetsLoadedMutex;
-        extern bool                                             assetsLoaded;
-        extern std::thread                                      assetThread;
+        extern ModelHandoff                                     streamedModels;
+        extern LoadScheduler*                                   loadScheduler;
+        extern WorldStreamer*                                   worldStreamer;
         extern bool                                             readyToRun;
         extern GLFWwindow*                                      window;
         extern GLFWmonitor*                                     monitor;
@@ -106,7 +115,9 @@ namespace vk {
         extern std::vector< VkCommandBuffer >                   standardCommandBuffers;
         extern std::vector< VkSemaphore >                       swapchainImageAvailableSemaphores;
         extern std::vector< VkSemaphore >                       renderingCompletedSemaphores;
-        extern std::vector< VkFence >                           inFlightFences;
+        extern std::vector< uint64_t >                          inFlightValues;
+        extern std::vector< uint64_t >                          imagesInFlight;
+        extern std::vector< uint64_t >                          submittedFrames;
         extern size_t                                           currentSwapchainImage;
         extern bool                                             hasFramebufferBeenResized;
         extern BaseBuffer*                                      vpBuffer;  
@@ -125,13 +136,17 @@ namespace vk {
         extern bool                                             initialized;
         extern std::vector< Model* >                            models;
         extern bool                                             firstTimeRecreation;
-        extern std::vector< std::vector< DescriptorSet* > >     descriptorSets;
+        extern std::vector< FrameArena* >                       frameArenas;
+        extern std::vector< DescriptorPool* >                   frameDescriptorPools;
         
-        extern std::vector< std::thread* >                      modelLoadingQueueThreads;
-        extern std::vector< AssetLoader* >                      assetLoaders;
         extern uint32_t                                         maxThreads;
-        
-        extern std::vector< std::thread* >                      renderThreads;
+        extern JobSystem*                                       jobSystem;
+        extern std::mutex                                       pipelineStateMutex;
+        extern uint64_t                                         pipelineGeneration;
+    #ifdef VK_HOT_RELOAD
+        extern HotReloader*                                     hotReloader;
+    #endif
+        extern TextureResidency*                                textureResidency;
 
         /**
             Pre-runs before init()
@@ -165,6 +180,11 @@ namespace vk {
         */
         void initLoadingScreen(void);
 
+        /**
+            Renders a frame of the loading screen and resubmits itself as a main-thread job until the screen is closed
+        */
+        void pumpLoadingScreen(void);
+
         /**
             Initializes the windowing library
 
@@ -185,16 +205,28 @@ namespace vk {
             @param      path_                   The path to the model
             @param      modelMatrixFunc_        The function pointer to calculate the models model matrix
 
-            @return     Returns OGL_SC_SUCCESS on success
+            @return     Returns a handle to poll, wait on or cancel the load
         */
-        VK_STATUS_CODE push(const char* path_, glm::mat4 (*modelMatrixFunc_)());
+        ModelHandle push(const char* path_, glm::mat4 (*modelMatrixFunc_)());
 
         /**
             Adds a model to the model loading queue
 
             @param      info_       A model info struct
+            @param      bias_       Subtracted from the distance to the camera, larger values load earlier
+
+            @return     Returns a handle to poll, wait on or cancel the load
+        */
+        ModelHandle push(ModelInfo info_, float bias_ = 0.0f);
+
+        /**
+            Replaces the streamed world with the cells of a scene manifest
+
+            @param      manifest_       The path to the scene manifest
+
+            @return     Returns VK_SC_SUCCESS on success
         */
-        VK_STATUS_CODE push(ModelInfo info_);
+        VK_STATUS_CODE stream(const char* manifest_);
 
         /**
             Finds queue families that are suitable for the operations that are about to be performed on them
@@ -374,6 +406,14 @@ namespace vk {
             @return        Returns VK_SC_SUCCESS on success
         */
         VK_STATUS_CODE createGraphicsPipelines(void);
+
+        /**
+            Creates the standard graphics pipeline from the current shaders, render pass and descriptor set layout, the
+            caller has to hold pipelineStateMutex if it does not run on the main thread
+
+            @return        Returns the new pipeline
+        */
+        GraphicsPipeline createStandardPipeline(void);
         
         /**
             Creates the necessary render pass(es)
@@ -514,16 +554,9 @@ namespace vk {
         VK_STATUS_CODE allocateMSAABufferedImage(void);
 
         /**
-            Loads all necessary models and vertex data such as texture coordinates and actual textures
-
-            @return     Returns VK_SC_SUCCESS on success
+            Appends the models that finished loading since the last frame to the models drawn by the render loop
         */
-        VK_STATUS_CODE loadModelsAndVertexData(void);
-
-        /**
-            Executes commands for multithreaded image presentation
-        */
-        void multithreadedNextSwapchainImage(void);
+        void adoptStreamedModels(void);
 
         /**
             Recreates the graphics pipelines
@@ -532,6 +565,12 @@ namespace vk {
         */
         VK_STATUS_CODE recreateGraphicsPipelines(void);
 
+        /**
+            Hands the command buffers, descriptor sets and the standard pipeline to the deletion queue, they are
+            destroyed once the frames recorded with them have finished
+        */
+        void retirePipelineResources(void);
+
     }
 
 }
@@ -0,0 +1,122 @@
+/**
+    Implements the deletion namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         DeletionQueue.cpp
+    @brief        Implementation of the deletion namespace, destroys GPU resources once no frame in flight uses them
+*/
+#include "DeletionQueue.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "VK.hpp"
+
+namespace vk {
+
+    namespace deletion {
+
+        Mutex                                                               queueMutex("deletion_queue");
+        std::deque< std::pair< uint64_t, std::function< void() > > >       queue;              // Ordered by frame, frames only ever grow
+        std::vector< std::function< void() > >                             collecting;         // Scratch space of collect(), kept to avoid per-frame allocations
+        DeletionStats                                                       deletionStats       = {};
+        Gauge*                                                              pendingMetric       = vk::metrics::gauge("render_deferred_destructions_pending", "Destructions waiting for their frame to finish on the GPU");
+
+        void retire(std::function< void() > destroy_) {
+
+            std::scoped_lock< Mutex > lock(queueMutex);
+            queue.emplace_back(vk::counters::frame(), std::move(destroy_));
+
+            deletionStats.retired++;
+            deletionStats.pending       = queue.size();
+            deletionStats.maxPending    = std::max(deletionStats.maxPending, deletionStats.pending);
+            pendingMetric->set(static_cast< int64_t >(queue.size()));
+
+        }
+
+        void collect(uint64_t frame_) {
+
+            std::unique_lock< Mutex > lock(queueMutex);
+            while (!queue.empty() && queue.front().first <= frame_) {
+
+                collecting.push_back(std::move(queue.front().second));
+                queue.pop_front();
+
+            }
+
+            if (collecting.empty()) return;
+
+            deletionStats.destroyed    += collecting.size();
+            deletionStats.pending       = queue.size();
+            pendingMetric->set(static_cast< int64_t >(queue.size()));
+            lock.unlock();
+
+            for (auto& destroy : collecting) {
+
+                destroy();          // Outside of the lock, destroying a model may retire its own resources
+
+            }
+            collecting.clear();
+
+        }
+
+        uint64_t flush() {
+
+            uint64_t flushed = 0;
+
+            std::unique_lock< Mutex > lock(queueMutex);
+            while (!queue.empty()) {
+
+                std::deque< std::pair< uint64_t, std::function< void() > > > all;
+                all.swap(queue);
+                lock.unlock();
+
+                for (auto& entry : all) {
+
+                    entry.second();
+
+                }
+                flushed += all.size();
+
+                lock.lock();
+
+            }
+
+            deletionStats.flushed  += flushed;
+            deletionStats.pending   = 0;
+            pendingMetric->set(0);
+
+            return flushed;
+
+        }
+
+        DeletionStats stats() {
+
+            std::scoped_lock< Mutex > lock(queueMutex);
+
+            return deletionStats;
+
+        }
+
+        void logStats() {
+
+            DeletionStats snapshot = stats();
+
+            logger::log(EVENT_LOG, "Deferred deletion: "
+                + std::to_string(snapshot.retired) + " retired, "
+                + std::to_string(snapshot.destroyed) + " destroyed after their frame, "
+                + std::to_string(snapshot.flushed) + " flushed, "
+                + std::to_string(snapshot.maxPending) + " pending at most"
+                );
+
+        }
+
+    }
+
+}
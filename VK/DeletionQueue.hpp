@@ -0,0 +1,63 @@
+/**
+    Prototypes the deletion namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         DeletionQueue.hpp
+    @brief        Prototype of the deletion namespace, destroys GPU resources once no frame in flight uses them
+*/
+#ifndef DELETION_QUEUE_HPP
+#define DELETION_QUEUE_HPP
+#include <cstdint>
+#include <functional>
+
+#include "DeletionStats.cpp"
+
+namespace vk {
+
+    /**
+        Defers the destruction of buffers, images, pipelines, descriptor pools, memory and everything else a recorded
+        command buffer may reference. A destruction is tagged with the frame it was requested in and runs once that
+        frame's submission has been waited on, so nothing has to wait for the device to go idle.
+    */
+    namespace deletion {
+
+        /**
+            Queues a destruction, any thread may call it
+
+            @param      destroy_        Destroys the resource, runs on the main thread
+        */
+        void retire(std::function< void() > destroy_);
+
+        /**
+            Runs every destruction requested in a frame that has finished on the GPU, has to be called by the main
+            thread after waiting for a frame's submission
+
+            @param      frame_          The number of the latest frame whose submission has finished
+        */
+        void collect(uint64_t frame_);
+
+        /**
+            Runs every queued destruction, the device has to be idle
+
+            @return     Returns the number of destructions that ran
+        */
+        uint64_t flush(void);
+
+        /**
+            Returns the deletion statistics
+
+            @return     Returns a DeletionStats snapshot
+        */
+        DeletionStats stats(void);
+
+        /**
+            Writes the deletion statistics to the event log
+        */
+        void logStats(void);
+
+    }
+
+}
+#endif  // DELETION_QUEUE_HPP
@@ -0,0 +1,26 @@
+/**
+    Defines the DeletionStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         DeletionStats.cpp
+    @brief        Definition of the DeletionStats struct
+*/
+#ifndef DELETION_STATS_CPP
+#define DELETION_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the statistics of the deferred deletion queue
+*/
+struct DeletionStats {
+
+    uint64_t            retired;            // Destructions queued
+    uint64_t            destroyed;          // Destructions run after their frame had finished
+    uint64_t            flushed;            // Destructions run by flush() on an idle device
+    uint64_t            pending;            // Destructions waiting for their frame
+    uint64_t            maxPending;         // The most destructions that were waiting at once
+
+};
+#endif  // DELETION_STATS_CPP
@@ -12,7 +12,7 @@
 #include "ASSERT.cpp"
 
 
-DescriptorPool::DescriptorPool(const DescriptorSetLayout* layout_) {
+DescriptorPool::DescriptorPool(const DescriptorSetLayout* layout_, uint32_t maxSets_) : maxSets(maxSets_) {
 
     std::vector< VkDescriptorPoolSize > descriptorPoolSizes;
     descriptorPoolSizes.resize(layout_->descriptors.size());
@@ -20,7 +20,7 @@ DescriptorPool::DescriptorPool(const DescriptorSetLayout* layout_) {
     for (uint32_t i = 0; i < layout_->descriptors.size(); i++) {
 
         descriptorPoolSizes[i].type                         = layout_->descriptors[i].info.type;
-        descriptorPoolSizes[i].descriptorCount              = static_cast< uint32_t > (vk::core::swapchainImages.size());
+        descriptorPoolSizes[i].descriptorCount              = maxSets_;
 
     }
 
@@ -28,7 +28,7 @@ DescriptorPool::DescriptorPool(const DescriptorSetLayout* layout_) {
     descriptorPoolCreateInfo.sType                          = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     descriptorPoolCreateInfo.poolSizeCount                  = static_cast< uint32_t >(descriptorPoolSizes.size());
     descriptorPoolCreateInfo.pPoolSizes                     = descriptorPoolSizes.data();
-    descriptorPoolCreateInfo.maxSets                        = static_cast< uint32_t >(vk::core::swapchainImages.size());
+    descriptorPoolCreateInfo.maxSets                        = maxSets_;
 
     VkResult result = vkCreateDescriptorPool(
         vk::core::logicalDevice,
@@ -37,12 +37,23 @@ DescriptorPool::DescriptorPool(const DescriptorSetLayout* layout_) {
         &descriptorPool
         );
     ASSERT(result, "Failed to create descriptor pool", VK_SC_DESCRIPTOR_POOL_ERROR);
+    vk::counters::add(FC_OBJECTS_CREATED);
+
+}
+
+VK_STATUS_CODE DescriptorPool::reset() {
+
+    VkResult result = vkResetDescriptorPool(vk::core::logicalDevice, descriptorPool, 0);
+    ASSERT(result, "Failed to reset descriptor pool", VK_SC_DESCRIPTOR_POOL_ERROR);
+
+    return vk::errorCodeBuffer;
 
 }
 
 DescriptorPool::~DescriptorPool() {
 
     vkDestroyDescriptorPool(vk::core::logicalDevice, descriptorPool, vk::core::allocator);
+    vk::counters::add(FC_OBJECTS_DESTROYED);
     logger::log(EVENT_LOG, "Successfully destroyed descriptor pool");
 
 }
\ No newline at end of file
@@ -12,19 +12,29 @@
 #include <vulkan/vulkan.h>
 
 #include "DescriptorSetLayout.hpp"
+#include "VK_STATUS_CODE.hpp"
 
 class DescriptorPool
 {
 public:
 
-    VkDescriptorPool descriptorPool;
+    VkDescriptorPool    descriptorPool;
+    uint32_t            maxSets;
 
     /**
         Constructor
 
         @param      layout_     The descriptor set layout
+        @param      maxSets_    The number of sets with this layout the pool holds
     */
-    DescriptorPool(const DescriptorSetLayout* layout_);
+    DescriptorPool(const DescriptorSetLayout* layout_, uint32_t maxSets_);
+
+    /**
+        Returns every set allocated from the pool to it at once, none of them may be in use by the GPU
+
+        @return     Returns VK_SC_SUCCESS on success
+    */
+    VK_STATUS_CODE reset(void);
 
     /**
         Default destructor
@@ -12,74 +12,60 @@
 #include "ASSERT.cpp"
 
 
-DescriptorSet::DescriptorSet(std::vector< Descriptor > descriptors_) {
-
-    descriptorSetLayout = new DescriptorSetLayout(descriptors_);
-    descriptorPool = new DescriptorPool(descriptorSetLayout);
-
-    std::vector< VkDescriptorSetLayout > layouts(vk::core::swapchainImages.size(), descriptorSetLayout->descriptorSetLayout);
+DescriptorSet::DescriptorSet(DescriptorPool* pool_, const DescriptorSetLayout* layout_) {
 
     VkDescriptorSetAllocateInfo allocateInfo        = {};
     allocateInfo.sType                              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocateInfo.descriptorPool                     = descriptorPool->descriptorPool;
-    allocateInfo.descriptorSetCount                 = static_cast< uint32_t >(vk::core::swapchainImages.size());
-    allocateInfo.pSetLayouts                        = layouts.data();
+    allocateInfo.descriptorPool                     = pool_->descriptorPool;
+    allocateInfo.descriptorSetCount                 = 1;
+    allocateInfo.pSetLayouts                        = &(layout_->descriptorSetLayout);
 
-    descriptorSets.resize(vk::core::swapchainImages.size());
-    VkResult result = vkAllocateDescriptorSets(vk::core::logicalDevice, &allocateInfo, descriptorSets.data());
+    VkResult result = vkAllocateDescriptorSets(vk::core::logicalDevice, &allocateInfo, &descriptorSet);
     ASSERT(result, "Failed to allocate descriptor sets", VK_SC_DESCRIPTOR_SET_CREATION_ERROR);
 
 }
 
-void DescriptorSet::update(std::vector< Descriptor > descriptors_) {
-
-    for (size_t i = 0; i < vk::core::swapchainImages.size(); i++) {
-        
-        for (size_t j = 0; j < descriptors_.size(); j++) {
+void DescriptorSet::update(const FrameVector< Descriptor >& descriptors_) {
 
-            VkWriteDescriptorSet writeDescriptorSet         = {};
-            writeDescriptorSet.sType                        = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            writeDescriptorSet.dstSet                       = descriptorSets[i];
-            writeDescriptorSet.dstBinding                   = descriptors_[j].info.binding;
-            writeDescriptorSet.dstArrayElement              = 0;
-            writeDescriptorSet.descriptorType               = descriptors_[j].info.type;
-            writeDescriptorSet.descriptorCount              = 1;
-            writeDescriptorSet.pBufferInfo                  = &(descriptors_[j].info.bufferInfo);
-            writeDescriptorSet.pImageInfo                   = &(descriptors_[j].info.imageInfo);
+    FrameVector< VkWriteDescriptorSet > writeDescriptorSets(descriptors_.size(), VkWriteDescriptorSet{}, descriptors_.get_allocator());
 
-            vkUpdateDescriptorSets(
-                vk::core::logicalDevice,
-                1,
-                &writeDescriptorSet,
-                0,
-                nullptr
-                );
+    for (size_t i = 0; i < descriptors_.size(); i++) {
 
-        }
+        VkWriteDescriptorSet& writeDescriptorSet        = writeDescriptorSets[i];
+        writeDescriptorSet.sType                        = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writeDescriptorSet.dstSet                       = descriptorSet;
+        writeDescriptorSet.dstBinding                   = descriptors_[i].info.binding;
+        writeDescriptorSet.dstArrayElement              = 0;
+        writeDescriptorSet.descriptorType               = descriptors_[i].info.type;
+        writeDescriptorSet.descriptorCount              = 1;
+        writeDescriptorSet.pBufferInfo                  = &(descriptors_[i].info.bufferInfo);
+        writeDescriptorSet.pImageInfo                   = &(descriptors_[i].info.imageInfo);
 
     }
 
+    vkUpdateDescriptorSets(
+        vk::core::logicalDevice,
+        static_cast< uint32_t >(writeDescriptorSets.size()),
+        writeDescriptorSets.data(),
+        0,
+        nullptr
+        );
+    vk::counters::add(FC_DESCRIPTOR_WRITES, writeDescriptorSets.size());
+
 }
 
-void DescriptorSet::bind(std::vector< VkCommandBuffer >& commandBuffers_, uint32_t imageIndex_, GraphicsPipeline pipeline_) {
+void DescriptorSet::bind(std::vector< VkCommandBuffer >& commandBuffers_, uint32_t imageIndex_, const GraphicsPipeline& pipeline_) {
 
+    vk::counters::add(FC_DESCRIPTOR_SET_BINDS);
     vkCmdBindDescriptorSets(
         commandBuffers_[imageIndex_],
         VK_PIPELINE_BIND_POINT_GRAPHICS,
         pipeline_.pipelineLayout,
         0,
         1,
-        &(descriptorSets[imageIndex_]),
+        &descriptorSet,
         0,
         nullptr
         );
 
 }
-
-DescriptorSet::~DescriptorSet() {
-
-     delete descriptorSetLayout;
-
-     delete descriptorPool;
-
-}
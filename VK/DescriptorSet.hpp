@@ -15,14 +15,13 @@
 #include "DescriptorSetLayout.hpp"
 #include "DescriptorPool.hpp"
 #include "GraphicsPipeline.hpp"
+#include "FrameArena.hpp"
 
 class DescriptorSet
 {
 public:
 
-    DescriptorPool*                         descriptorPool;
-    DescriptorSetLayout*                    descriptorSetLayout;
-    std::vector< VkDescriptorSet >          descriptorSets;
+    VkDescriptorSet                         descriptorSet;
 
     /**
         Default constructor
@@ -30,11 +29,12 @@ public:
     DescriptorSet(void) = default;
 
     /**
-        Constructor
+        Constructor, the set is returned to the pool when the pool is reset
 
-        @param      descriptors_        An std::vector containing the actual descriptors
+        @param      pool_               The pool to allocate the set from
+        @param      layout_             The layout of the set
     */
-    DescriptorSet(std::vector< Descriptor > descriptors_);
+    DescriptorSet(DescriptorPool* pool_, const DescriptorSetLayout* layout_);
 
     /**
         Binds the descriptor set
@@ -43,19 +43,14 @@ public:
         @param      imageIndex_         The swapchain image index
         @param      pipeline_           The pipeline that the command buffer is recorded for
     */
-    void bind(std::vector< VkCommandBuffer >& commandBuffers_, uint32_t imageIndex_, GraphicsPipeline pipeline_);
+    void bind(std::vector< VkCommandBuffer >& commandBuffers_, uint32_t imageIndex_, const GraphicsPipeline& pipeline_);
 
     /**
-        Updates a descriptor sets info
+        Updates a descriptor sets info with a single vkUpdateDescriptorSets call
 
-        @param      descriptors_        The new desriptors
+        @param      descriptors_        The new desriptors, the writes are allocated from the same arena
     */
-    void update(std::vector< Descriptor > descriptors_);
-
-    /**
-        Default destructor
-    */
-    ~DescriptorSet(void);
+    void update(const FrameVector< Descriptor >& descriptors_);
 
 };
 #endif  // DESCRIPTOR_SET_HPP
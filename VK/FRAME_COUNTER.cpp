@@ -0,0 +1,52 @@
+/**
+    Implements the FRAME_COUNTER enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FRAME_COUNTER.cpp
+    @brief        Implementation of the FRAME_COUNTER enumeration
+*/
+#ifndef FRAME_COUNTER_CPP
+#define FRAME_COUNTER_CPP
+
+/**
+    Enumeration to differenciate between the per-frame counters
+*/
+typedef enum FRAME_COUNTER {
+
+    FC_DRAW_CALLS,
+    FC_TRIANGLES,
+    FC_PIPELINE_BINDS,
+    FC_DESCRIPTOR_SET_BINDS,
+    FC_VERTEX_BUFFER_BINDS,
+    FC_INDEX_BUFFER_BINDS,
+    FC_DESCRIPTOR_WRITES,           // Descriptors written with vkUpdateDescriptorSets
+    FC_OBJECTS_CREATED,             // Vulkan objects and device memory allocations
+    FC_OBJECTS_DESTROYED,
+    FC_BYTES_UPLOADED,              // Bytes written into host-visible buffers, staging buffers included
+    FC_HEAP_ALLOCATIONS,            // Only with VK_HEAP_TRACKING, operator new calls made by the main thread
+    FC_VERTEX_INVOCATIONS,          // Only with VK_PIPELINE_STATISTICS, lags a few frames behind
+    FC_FRAGMENT_INVOCATIONS,        // Only with VK_PIPELINE_STATISTICS, lags a few frames behind
+    FC_COUNT
+
+} FRAME_COUNTER;
+
+static const char* const FRAME_COUNTER_NAMES[] = {
+
+    "draw_calls",
+    "triangles",
+    "pipeline_binds",
+    "descriptor_set_binds",
+    "vertex_buffer_binds",
+    "index_buffer_binds",
+    "descriptor_writes",
+    "objects_created",
+    "objects_destroyed",
+    "bytes_uploaded",
+    "heap_allocations",
+    "vertex_invocations",
+    "fragment_invocations"
+
+};
+#endif  // FRAME_COUNTER_CPP
@@ -0,0 +1,151 @@
+/**
+    Implements the FileData class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FileData.cpp
+    @brief        Implementation of the FileData class, a read-only view of a whole file
+*/
+#include "FileData.hpp"
+
+#include <cstdint>
+
+#include "Version.hpp"
+
+#if defined WIN_64 || defined WIN_32
+    #include <windows.h>
+#elif defined LINUX
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+    const size_t            PAGE_SIZE_HINT          = 4096;         // Smallest page size of every supported platform, touching more often is harmless
+
+}
+
+std::shared_ptr< FileData > FileData::map(const std::string& path_) {
+
+    std::shared_ptr< FileData > file(new FileData());
+
+#if defined WIN_64 || defined WIN_32
+    HANDLE handle = CreateFileA(path_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(handle, &fileSize);
+    file->mappingSize = static_cast< size_t >(fileSize.QuadPart);
+
+    if (file->mappingSize > 0) {
+
+        HANDLE fileMapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (fileMapping) {
+
+            file->mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(fileMapping);
+
+        }
+
+    }
+    CloseHandle(handle);
+#elif defined LINUX
+    int handle = open(path_.c_str(), O_RDONLY);
+    if (handle < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(handle, &st) != 0 || !S_ISREG(st.st_mode)) {
+
+        close(handle);
+        return nullptr;
+
+    }
+    file->mappingSize = static_cast< size_t >(st.st_size);
+
+    if (file->mappingSize > 0) {
+
+        void* address = mmap(nullptr, file->mappingSize, PROT_READ, MAP_PRIVATE, handle, 0);
+        file->mapping = address == MAP_FAILED ? nullptr : address;
+
+    }
+    close(handle);
+#endif
+
+    if (file->mappingSize > 0 && file->mapping == nullptr) return nullptr;
+
+    file->bytes     = static_cast< const unsigned char* >(file->mapping);
+    file->length    = file->mappingSize;
+
+    return file;
+
+}
+
+std::shared_ptr< FileData > FileData::view(const std::shared_ptr< FileData >& parent_, size_t offset_, size_t size_) {
+
+    std::shared_ptr< FileData > file(new FileData());
+    file->parent    = parent_;
+    file->bytes     = parent_->bytes + offset_;
+    file->length    = size_;
+
+    return file;
+
+}
+
+std::shared_ptr< FileData > FileData::adopt(std::vector< unsigned char >&& bytes_) {
+
+    std::shared_ptr< FileData > file(new FileData());
+    file->buffer    = std::move(bytes_);
+    file->bytes     = file->buffer.data();
+    file->length    = file->buffer.size();
+
+    return file;
+
+}
+
+void FileData::touch() {
+
+    if (bytes == nullptr || !buffer.empty()) return;        // Heap buffers are resident already
+
+#if defined LINUX
+    static const uintptr_t pageSize = static_cast< uintptr_t >(sysconf(_SC_PAGESIZE));
+    uintptr_t begin = reinterpret_cast< uintptr_t >(bytes) & ~(pageSize - 1);       // Views into a package do not start on a page boundary necessarily
+    madvise(reinterpret_cast< void* >(begin), reinterpret_cast< uintptr_t >(bytes) + length - begin, MADV_WILLNEED);
+#endif
+
+    const volatile unsigned char* page = bytes;
+    unsigned char sink = 0;
+    for (size_t offset = 0; offset < length; offset += PAGE_SIZE_HINT) {
+
+        sink ^= page[offset];
+
+    }
+    (void) sink;
+
+}
+
+const unsigned char* FileData::data() const {
+
+    return bytes;
+
+}
+
+size_t FileData::size() const {
+
+    return length;
+
+}
+
+FileData::~FileData() {
+
+    if (mapping == nullptr) return;
+
+#if defined WIN_64 || defined WIN_32
+    UnmapViewOfFile(mapping);
+#elif defined LINUX
+    munmap(mapping, mappingSize);
+#endif
+
+}
@@ -0,0 +1,97 @@
+/**
+    Declares the FileData class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FileData.hpp
+    @brief        Declaration of the FileData class, a read-only view of a whole file
+*/
+#ifndef FILE_DATA_HPP
+#define FILE_DATA_HPP
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+    A read-only view of a whole file, shared by everybody who reads the file while it is alive. The bytes are either
+    a memory mapping of the file, a range of a parent mapping (an uncompressed package entry) or a heap buffer
+    (a decompressed package entry).
+*/
+class FileData {
+public:
+
+    /**
+        Maps a file into memory
+
+        @param      path_       (Relative) filepath to the file
+
+        @return     Returns the mapped file or nullptr if the file could not be opened
+    */
+    static std::shared_ptr< FileData > map(const std::string& path_);
+
+    /**
+        Creates a view of a range of another file, which stays mapped as long as the view is alive
+
+        @param      parent_     The file to view
+        @param      offset_     The offset of the range in bytes
+        @param      size_       The size of the range in bytes
+
+        @return     Returns the view
+    */
+    static std::shared_ptr< FileData > view(const std::shared_ptr< FileData >& parent_, size_t offset_, size_t size_);
+
+    /**
+        Wraps bytes that have been read or decoded into memory already
+
+        @param      bytes_      The content of the file, moved into the FileData
+
+        @return     Returns the file
+    */
+    static std::shared_ptr< FileData > adopt(std::vector< unsigned char >&& bytes_);
+
+    /**
+        Hints the kernel to read the whole file ahead and faults every page in on the calling thread, so a later
+        reader finds the file resident
+    */
+    void touch(void);
+
+    /**
+        Returns the first byte of the file
+
+        @return     Returns a pointer to the mapped bytes, nullptr for empty files
+    */
+    const unsigned char* data(void) const;
+
+    /**
+        Returns the size of the file
+
+        @return     Returns the size of the file in bytes
+    */
+    size_t size(void) const;
+
+    FileData(const FileData&) = delete;
+    FileData& operator=(const FileData&) = delete;
+
+    /**
+        Default destructor, unmaps the file
+    */
+    ~FileData(void);
+
+private:
+
+    void*                           mapping         = nullptr;
+    size_t                          mappingSize     = 0;
+    const unsigned char*            bytes           = nullptr;
+    size_t                          length          = 0;
+    std::shared_ptr< FileData >     parent;
+    std::vector< unsigned char >    buffer;
+
+    /**
+        Default constructor, only map creates FileData objects
+    */
+    FileData(void) = default;
+
+};
+#endif  // FILE_DATA_HPP
@@ -0,0 +1,492 @@
+/**
+    Implements the io namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FileIO.cpp
+    @brief        Implementation of the io namespace, the memory-mapped asset I/O layer
+*/
+#include "FileIO.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
+#include <vector>
+
+#include "VK.hpp"
+#include "Package.hpp"
+
+#if defined WIN_64 || defined WIN_32
+    #include <sys/types.h>
+    #include <sys/stat.h>
+#elif defined LINUX
+    #include <sys/stat.h>
+#endif
+
+namespace vk {
+
+    namespace io {
+
+        /**
+            Enumeration to differenciate between the follow-up work of a prefetch
+        */
+        typedef enum PREFETCH_KIND {
+
+            PK_FILE = 0,        // Just the file
+            PK_OBJ,             // An OBJ model, followed by its material libraries
+            PK_MTL              // A material library, followed by its textures
+
+        } PREFETCH_KIND;
+
+        /**
+            A cached file, filled in by a prefetch job or by a direct read
+        */
+        struct Slot {
+
+            JobHandle                           job;            // Null for files that were read directly
+            std::shared_ptr< FileData >         file;
+
+        };
+
+        Mutex                                                               ioMutex("io_cache");
+        std::unordered_map< std::string, std::shared_ptr< Slot > >          cache;
+        std::deque< std::string >                                           cacheOrder;         // Oldest first, evicted once the cache is over budget
+        size_t                                                              cachedBytes         = 0;
+        uint64_t                                                            busyNanoseconds     = 0;
+        IOStats                                                             ioStats             = {};
+        std::vector< std::shared_ptr< Package > >                           packages;           // Searched last mounted first, only changed by mount
+        Mutex                                                               packageMutex("io_packages");
+        std::unordered_set< std::string >                                   overridden;         // Files changed on disk since their package was built
+
+        static void submitPrefetch(const std::string& path_, PREFETCH_KIND kind_);
+
+        std::string canonicalPath(const std::string& path_) {
+
+#if defined WIN_64 || defined WIN_32
+            char resolved[_MAX_PATH];
+            if (_fullpath(resolved, path_.c_str(), _MAX_PATH)) return std::string(resolved);
+#elif defined LINUX
+            char resolved[PATH_MAX];
+            if (realpath(path_.c_str(), resolved)) return std::string(resolved);
+#endif
+            return path_;
+
+        }
+
+        bool mount(const std::string& path_) {
+
+            auto package = std::make_shared< Package >(path_, canonicalPath("."));
+            if (!package->isValid()) {
+
+                logger::log(EVENT_LOG, "No valid asset package at '" + path_ + "', reading loose files");
+                return false;
+
+            }
+
+            std::scoped_lock< Mutex > lock(packageMutex);
+            packages.insert(packages.begin(), package);
+            logger::log(EVENT_LOG, "Mounted asset package '" + path_ + "' with " + std::to_string(package->getEntryCount()) + " entries");
+
+            return true;
+
+        }
+
+        /**
+            Returns the mounted packages, a copy so lookups do not hold packageMutex
+        */
+        static std::vector< std::shared_ptr< Package > > mounted(void) {
+
+            std::scoped_lock< Mutex > lock(packageMutex);
+
+            return packages;
+
+        }
+
+        /**
+            Reads a file from the first package that contains it, or maps it from the file system, faults it in on the
+            calling thread and accounts the time it took
+        */
+        static std::shared_ptr< FileData > mapFile(const std::string& path_) {
+
+            auto begin = std::chrono::steady_clock::now();
+
+            std::shared_ptr< FileData > file;
+            bool packaged = false;
+            std::vector< std::shared_ptr< Package > > candidates;
+
+            {
+
+                std::scoped_lock< Mutex > lock(packageMutex);
+                if (overridden.find(path_) == overridden.end()) candidates = packages;
+
+            }
+
+            for (const auto& package : candidates) {
+
+                if (package->contains(path_)) {
+
+                    file        = package->read(path_);
+                    packaged    = true;
+                    break;
+
+                }
+
+            }
+
+            if (!packaged) {
+
+                file = FileData::map(path_);
+
+            }
+
+            if (file) {
+
+                file->touch();
+
+            }
+
+            uint64_t nanoseconds = static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now() - begin).count());
+
+            std::scoped_lock< Mutex > lock(ioMutex);
+            busyNanoseconds += nanoseconds;
+            if (file) {
+
+                ioStats.filesRead++;
+                ioStats.bytesRead += file->size();
+                if (packaged) ioStats.packageReads++;
+
+            }
+
+            static Counter* bytesRead = vk::metrics::counter("io_bytes_read_total", "Bytes of asset files mapped or read");
+            if (file) bytesRead->add(file->size());
+
+            return file;
+
+        }
+
+        /**
+            Accounts a finished file to the cache and evicts the oldest files while the cache is over budget, has to be
+            called with ioMutex held
+        */
+        static void retain(const std::string& key_, size_t size_) {
+
+            cachedBytes += size_;
+
+            while (cachedBytes > IO_PREFETCH_BUDGET && cacheOrder.size() > 1) {
+
+                std::string oldest = cacheOrder.front();
+                cacheOrder.pop_front();
+
+                if (oldest == key_) {
+
+                    cacheOrder.push_back(oldest);       // Never evict the file that is being accounted
+                    continue;
+
+                }
+
+                auto it = cache.find(oldest);
+                if (it == cache.end()) continue;
+
+                if (it->second->file) {
+
+                    cachedBytes -= it->second->file->size();        // Readers still holding the file keep it mapped
+
+                }
+                cache.erase(it);
+
+            }
+
+        }
+
+        /**
+            Returns the directory part of a path, "." for bare file names
+        */
+        static std::string directoryOf(const std::string& path_) {
+
+            size_t separator = path_.find_last_of("/\\");
+
+            return separator == std::string::npos ? std::string(".") : path_.substr(0, separator);
+
+        }
+
+        /**
+            Scans an OBJ file for material libraries or a material library for texture maps and prefetches them
+        */
+        static void scan(const FileData& file_, const std::string& directory_, PREFETCH_KIND kind_) {
+
+            const char* cursor  = reinterpret_cast< const char* >(file_.data());
+            const char* end     = cursor + file_.size();
+
+            while (cursor < end) {
+
+                const char* lineEnd = static_cast< const char* >(std::memchr(cursor, '\n', end - cursor));
+                if (lineEnd == nullptr) lineEnd = end;
+
+                while (cursor < lineEnd && (*cursor == ' ' || *cursor == '\t')) cursor++;
+
+                char first = cursor < lineEnd ? *cursor : '\0';
+                bool candidate = kind_ == PK_OBJ ? first == 'm' : (first == 'm' || first == 'b' || first == 'n' || first == 'd' || first == 'r');
+
+                if (candidate) {        // Vertex and face lines, the bulk of every OBJ, never allocate
+
+                    std::vector< std::string > tokens;
+                    const char* token = cursor;
+                    for (const char* c = cursor; c <= lineEnd; c++) {
+
+                        if (c == lineEnd || std::isspace(static_cast< unsigned char >(*c))) {
+
+                            if (c > token) tokens.emplace_back(token, c);
+                            token = c + 1;
+
+                        }
+
+                    }
+
+                    if (kind_ == PK_OBJ && !tokens.empty() && tokens[0] == "mtllib") {
+
+                        for (size_t i = 1; i < tokens.size(); i++) {
+
+                            submitPrefetch(directory_ + '/' + tokens[i], PK_MTL);
+
+                        }
+
+                    }
+                    else if (kind_ == PK_MTL && tokens.size() > 1) {
+
+                        std::string keyword = tokens[0];
+                        std::transform(keyword.begin(), keyword.end(), keyword.begin(), [](unsigned char c_) { return static_cast< char >(std::tolower(c_)); });
+
+                        if (keyword.compare(0, 4, "map_") == 0 || keyword == "bump" || keyword == "norm" || keyword == "disp" || keyword == "refl") {
+
+                            submitPrefetch(directory_ + '/' + tokens.back(), PK_FILE);        // Texture options come first, the file name last
+
+                        }
+
+                    }
+
+                }
+
+                cursor = lineEnd + 1;
+
+            }
+
+        }
+
+        static void submitPrefetch(const std::string& path_, PREFETCH_KIND kind_) {
+
+            if (vk::core::jobSystem == nullptr) return;
+
+            std::string key = canonicalPath(path_);
+            std::shared_ptr< Slot > slot = std::make_shared< Slot >();
+
+            std::scoped_lock< Mutex > lock(ioMutex);       // Held across submit so no reader can see the slot without its job
+            if (cache.find(key) != cache.end()) return;
+
+            if (cachedBytes >= IO_PREFETCH_BUDGET) {
+
+                ioStats.prefetchSkipped++;
+                return;
+
+            }
+
+            cache[key] = slot;
+            cacheOrder.push_back(key);
+            ioStats.queueDepth++;
+            ioStats.peakQueueDepth = std::max(ioStats.peakQueueDepth, ioStats.queueDepth);
+
+            slot->job = vk::core::jobSystem->submit([key, slot, kind_]() {
+
+                std::shared_ptr< FileData > file = mapFile(key);
+                slot->file = file;
+
+                {
+
+                    std::scoped_lock< Mutex > lock(ioMutex);
+                    ioStats.queueDepth--;
+
+                    auto it = cache.find(key);
+                    if (it != cache.end() && it->second == slot) {
+
+                        if (file) {
+
+                            retain(key, file->size());
+
+                        }
+                        else {
+
+                            cache.erase(it);        // Missing files are looked up again by the next reader
+
+                        }
+
+                    }
+
+                }
+
+                if (file && kind_ != PK_FILE) {
+
+                    scan(*file, directoryOf(key), kind_);
+
+                }
+
+                });
+
+        }
+
+        std::shared_ptr< FileData > read(const std::string& path_) {
+
+            std::string key = canonicalPath(path_);
+            std::shared_ptr< Slot > slot;
+
+            {
+
+                std::scoped_lock< Mutex > lock(ioMutex);
+                auto it = cache.find(key);
+                if (it != cache.end()) {
+
+                    slot = it->second;
+                    ioStats.prefetchHits++;
+
+                }
+                else {
+
+                    ioStats.prefetchMisses++;
+
+                }
+
+            }
+
+            if (slot) {
+
+                if (slot->job && !slot->job->done) {
+
+                    vk::core::jobSystem->wait(slot->job);       // Helps with other jobs meanwhile, a blocked worker could starve the prefetch
+
+                }
+
+                if (slot->file) {
+
+                    return slot->file;
+
+                }
+
+            }
+
+            std::shared_ptr< FileData > file = mapFile(key);
+            if (file) {
+
+                std::scoped_lock< Mutex > lock(ioMutex);
+                if (cache.find(key) == cache.end()) {
+
+                    slot                = std::make_shared< Slot >();
+                    slot->file          = file;
+                    cache[key]          = slot;
+                    cacheOrder.push_back(key);
+                    retain(key, file->size());
+
+                }
+
+            }
+
+            return file;
+
+        }
+
+        bool exists(const std::string& path_) {
+
+            for (const auto& package : mounted()) {
+
+                if (package->contains(path_)) return true;
+
+            }
+
+#if defined WIN_64 || defined WIN_32
+            struct _stat64 st;
+            return _stat64(path_.c_str(), &st) == 0 && (st.st_mode & _S_IFREG) != 0;
+#elif defined LINUX
+            struct stat st;
+            return stat(path_.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+#endif
+
+        }
+
+        void invalidate(const std::string& path_) {
+
+            std::string key = canonicalPath(path_);
+
+            {
+
+                std::scoped_lock< Mutex > lock(packageMutex);
+                overridden.insert(key);
+
+            }
+
+            std::scoped_lock< Mutex > lock(ioMutex);
+            auto it = cache.find(key);
+            if (it == cache.end()) return;
+
+            if (it->second->file) {
+
+                cachedBytes -= it->second->file->size();
+
+            }
+            cache.erase(it);
+
+            auto position = std::find(cacheOrder.begin(), cacheOrder.end(), key);
+            if (position != cacheOrder.end()) cacheOrder.erase(position);
+
+        }
+
+        void prefetch(const std::string& path_) {
+
+            submitPrefetch(path_, PK_FILE);
+
+        }
+
+        void prefetchModel(const std::string& path_) {
+
+            std::string extension = path_.substr(path_.find_last_of('.') + 1);
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c_) { return static_cast< char >(std::tolower(c_)); });
+
+            submitPrefetch(path_, extension == "obj" ? PK_OBJ : PK_FILE);
+
+        }
+
+        IOStats stats() {
+
+            std::scoped_lock< Mutex > lock(ioMutex);
+
+            IOStats snapshot        = ioStats;
+            snapshot.bytesPerSecond = busyNanoseconds > 0 ? static_cast< double >(ioStats.bytesRead) / (static_cast< double >(busyNanoseconds) * 1e-9) : 0.0;
+
+            return snapshot;
+
+        }
+
+        void logStats() {
+
+            IOStats snapshot = stats();
+
+            logger::log(EVENT_LOG, "Asset I/O: "
+                + std::to_string(snapshot.filesRead) + " files, "
+                + std::to_string(snapshot.bytesRead >> 20) + " MiB at "
+                + std::to_string(snapshot.bytesPerSecond / (1 << 20)) + " MiB/s, "
+                + std::to_string(snapshot.packageReads) + " from packages, "
+                + std::to_string(snapshot.prefetchHits) + " prefetch hits, "
+                + std::to_string(snapshot.prefetchMisses) + " misses, "
+                + std::to_string(snapshot.prefetchSkipped) + " skipped, "
+                + std::to_string(snapshot.peakQueueDepth) + " peak queue depth"
+                );
+
+        }
+
+    }
+
+}
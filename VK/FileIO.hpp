@@ -0,0 +1,102 @@
+/**
+    Prototypes the io namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FileIO.hpp
+    @brief        Prototype of the io namespace, the memory-mapped asset I/O layer
+*/
+#ifndef FILE_IO_HPP
+#define FILE_IO_HPP
+#include <memory>
+#include <string>
+
+#include "FileData.hpp"
+#include "IOStats.cpp"
+
+namespace vk {
+
+    /**
+        Maps asset files into memory and prefetches whole models (OBJ, MTL and textures) on the job system, so
+        loaders find their files resident instead of blocking on the file system one small read at a time
+    */
+    namespace io {
+
+        /**
+            Resolves relative components and symbolic links so different spellings of a path share one entry
+
+            @param      path_       (Relative) filepath
+
+            @return     Returns the canonical path or path_ itself if it cannot be resolved
+        */
+        std::string canonicalPath(const std::string& path_);
+
+        /**
+            Mounts an asset package, files it contains are read from it before the file system is asked. Packages
+            mounted later take precedence.
+
+            @param      path_       (Relative) filepath to the package
+
+            @return     Returns true if the package was mapped and is valid
+        */
+        bool mount(const std::string& path_);
+
+        /**
+            Returns the content of a file, waiting for an in-flight prefetch of it instead of reading it twice
+
+            @param      path_       (Relative) filepath to the file
+
+            @return     Returns the mapped file or nullptr if the file could not be opened
+        */
+        std::shared_ptr< FileData > read(const std::string& path_);
+
+        /**
+            Checks whether a file exists in a mounted package or on the file system
+
+            @param      path_       (Relative) filepath to the file
+
+            @return     Returns true if the file exists
+        */
+        bool exists(const std::string& path_);
+
+        /**
+            Drops the cached content of a file that changed on disk and reads it from the file system from now on,
+            even if a mounted package contains an older version of it
+
+            @param      path_       (Relative) filepath to the file
+        */
+        void invalidate(const std::string& path_);
+
+        /**
+            Starts reading a file in the background, does nothing if the file is cached already, the cache is over
+            budget or there is no job system
+
+            @param      path_       (Relative) filepath to the file
+        */
+        void prefetch(const std::string& path_);
+
+        /**
+            Starts reading a model in the background, for OBJ files followed by its material libraries and every
+            texture they reference, all in one batch
+
+            @param      path_       (Relative) filepath to the model
+        */
+        void prefetchModel(const std::string& path_);
+
+        /**
+            Returns the throughput and prefetch statistics
+
+            @return     Returns an IOStats snapshot
+        */
+        IOStats stats(void);
+
+        /**
+            Writes the throughput and prefetch statistics to the event log
+        */
+        void logStats(void);
+
+    }
+
+}
+#endif  // FILE_IO_HPP
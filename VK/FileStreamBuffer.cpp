@@ -0,0 +1,17 @@
+/**
+    Implements the FileStreamBuffer class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FileStreamBuffer.cpp
+    @brief        Implementation of the FileStreamBuffer class, a std::streambuf over a FileData
+*/
+#include "FileStreamBuffer.hpp"
+
+FileStreamBuffer::FileStreamBuffer(std::shared_ptr< FileData > file_) : file(std::move(file_)) {
+
+    char* begin = const_cast< char* >(reinterpret_cast< const char* >(file->data()));      // Never written through, std::streambuf just has no const get area
+    setg(begin, begin, begin + file->size());
+
+}
@@ -0,0 +1,35 @@
+/**
+    Declares the FileStreamBuffer class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FileStreamBuffer.hpp
+    @brief        Declaration of the FileStreamBuffer class, a std::streambuf over a FileData
+*/
+#ifndef FILE_STREAM_BUFFER_HPP
+#define FILE_STREAM_BUFFER_HPP
+#include <memory>
+#include <streambuf>
+
+#include "FileData.hpp"
+
+/**
+    Exposes a file read through the io namespace as a read-only std::streambuf for parsers that only take streams
+*/
+class FileStreamBuffer : public std::streambuf {
+public:
+
+    /**
+        Constructor, keeps the file alive for as long as the buffer is
+
+        @param      file_       The file to read from
+    */
+    explicit FileStreamBuffer(std::shared_ptr< FileData > file_);
+
+private:
+
+    std::shared_ptr< FileData >     file;
+
+};
+#endif  // FILE_STREAM_BUFFER_HPP
@@ -0,0 +1,156 @@
+/**
+    Implements the FileWatcher class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FileWatcher.cpp
+    @brief        Implementation of the FileWatcher class, reports files that were written below a set of directories
+*/
+#include "FileWatcher.hpp"
+
+#if defined LINUX
+    #include <sys/inotify.h>
+    #include <dirent.h>
+    #include <unistd.h>
+    #include <cstring>
+#endif
+
+namespace {
+
+#if !defined LINUX
+    const std::chrono::milliseconds     SCAN_INTERVAL           = std::chrono::milliseconds(500);
+#endif
+
+}
+
+FileWatcher::FileWatcher(const std::vector< std::string >& directories_) {
+
+#if defined LINUX
+    descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (descriptor < 0) return;
+
+    for (const auto& directory : directories_) {
+
+        watch(directory);
+
+    }
+#else
+    roots       = directories_;
+    lastScan    = std::chrono::steady_clock::now();
+    scan(nullptr);      // Remember the current modification times without reporting them
+#endif
+
+}
+
+bool FileWatcher::isValid() {
+
+#if defined LINUX
+    return descriptor >= 0;
+#else
+    return true;
+#endif
+
+}
+
+#if defined LINUX
+void FileWatcher::watch(const std::string& directory_) {
+
+    int watchDescriptor = inotify_add_watch(descriptor, directory_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+    if (watchDescriptor < 0) return;
+
+    directories[watchDescriptor] = directory_;
+
+    DIR* dir = opendir(directory_.c_str());
+    if (dir == nullptr) return;
+
+    while (dirent* entry = readdir(dir)) {
+
+        if ((entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN) || std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0) continue;
+        watch(directory_ + '/' + entry->d_name);
+
+    }
+    closedir(dir);
+
+}
+
+void FileWatcher::poll(std::vector< std::string >& changed_) {
+
+    if (descriptor < 0) return;
+
+    alignas(inotify_event) char buffer[1 << 14];
+    while (true) {
+
+        ssize_t length = read(descriptor, buffer, sizeof(buffer));
+        if (length <= 0) break;     // EAGAIN once the queue is drained
+
+        for (char* cursor = buffer; cursor < buffer + length; ) {
+
+            auto event = reinterpret_cast< inotify_event* >(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+
+            auto directory = directories.find(event->wd);
+            if (directory == directories.end() || event->len == 0) continue;
+
+            std::string path = directory->second + '/' + event->name;
+            if (event->mask & IN_ISDIR) {
+
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) watch(path);
+
+            }
+            else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {        // Editors either rewrite in place or rename a temporary over the file
+
+                changed_.push_back(path);
+
+            }
+
+        }
+
+    }
+
+}
+
+FileWatcher::~FileWatcher() {
+
+    if (descriptor >= 0) close(descriptor);
+
+}
+#else
+void FileWatcher::scan(std::vector< std::string >* changed_) {
+
+    std::error_code error;
+    for (const auto& root : roots) {
+
+        for (auto it = std::filesystem::recursive_directory_iterator(root, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+
+            if (!it->is_regular_file(error)) continue;
+
+            std::string path = it->path().generic_string();
+            auto stamp = it->last_write_time(error);
+            auto known = stamps.find(path);
+
+            if (known == stamps.end() || known->second != stamp) {
+
+                if (changed_ != nullptr) changed_->push_back(path);
+                stamps[path] = stamp;
+
+            }
+
+        }
+
+    }
+
+}
+
+void FileWatcher::poll(std::vector< std::string >& changed_) {
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastScan < SCAN_INTERVAL) return;
+
+    lastScan = now;
+    scan(&changed_);
+
+}
+
+FileWatcher::~FileWatcher() {}
+#endif
@@ -0,0 +1,81 @@
+/**
+    Declares the FileWatcher class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FileWatcher.hpp
+    @brief        Declaration of the FileWatcher class, reports files that were written below a set of directories
+*/
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+#include "Version.hpp"
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if !defined LINUX
+    #include <filesystem>
+#endif
+
+/**
+    Watches directory trees for files that have been written, through inotify on Linux and by comparing modification
+    times twice a second elsewhere. Never blocks, poll is meant to be called once per frame.
+*/
+class FileWatcher {
+public:
+
+    /**
+        Constructor, starts watching the directories and everything below them
+
+        @param      directories_    (Relative) paths of the directories to watch
+    */
+    explicit FileWatcher(const std::vector< std::string >& directories_);
+
+    /**
+        Collects the files that have been written completely since the last call
+
+        @param      changed_        Receives the (relative) paths of the changed files, may contain duplicates
+    */
+    void poll(std::vector< std::string >& changed_);
+
+    /**
+        Checks whether the platform mechanism could be set up
+
+        @return     Returns true if changes are reported
+    */
+    bool isValid(void);
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+        Default destructor, stops watching
+    */
+    ~FileWatcher(void);
+
+private:
+
+#if defined LINUX
+    int                                                                         descriptor      = -1;
+    std::unordered_map< int, std::string >                                      directories;            // Watch descriptor to directory path
+
+    /**
+        Watches a directory and, recursively, its subdirectories
+    */
+    void watch(const std::string& directory_);
+#else
+    std::vector< std::string >                                                  roots;
+    std::unordered_map< std::string, std::filesystem::file_time_type >          stamps;
+    std::chrono::steady_clock::time_point                                       lastScan;
+
+    /**
+        Walks the watched trees and reports files whose modification time changed
+    */
+    void scan(std::vector< std::string >* changed_);
+#endif
+
+};
+#endif  // FILE_WATCHER_HPP
@@ -0,0 +1,116 @@
+/**
+    Implements the FrameArena class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FrameArena.cpp
+    @brief        Implementation of the FrameArena class, a linear allocator for memory that lives for one frame
+*/
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Metrics.hpp"
+
+FrameArena::FrameArena(size_t capacity_) : capacity(capacity_) {
+
+    block = static_cast< unsigned char* >(::operator new(capacity));
+
+}
+
+void* FrameArena::allocate(size_t size_, size_t alignment_) {
+
+    uintptr_t base      = reinterpret_cast< uintptr_t >(block);
+    uintptr_t aligned   = (base + offset + alignment_ - 1) & ~static_cast< uintptr_t >(alignment_ - 1);
+
+    if (aligned + size_ <= base + capacity) {
+
+        offset = aligned + size_ - base;
+
+        return reinterpret_cast< void* >(aligned);
+
+    }
+
+    Spill* spill    = static_cast< Spill* >(::operator new(sizeof(Spill) + size_ + alignment_));       // Only until the next reset grows the block
+    spill->next     = spills;
+    spills          = spill;
+    spilled        += size_ + alignment_;
+
+    uintptr_t memory = reinterpret_cast< uintptr_t >(spill + 1);
+
+    return reinterpret_cast< void* >((memory + alignment_ - 1) & ~static_cast< uintptr_t >(alignment_ - 1));
+
+}
+
+void FrameArena::reset() {
+
+    static Gauge* arenaBytes = vk::metrics::gauge("memory_frame_arena_bytes", "Bytes the last recorded frame allocated from its frame arena");
+
+    while (finalizers != nullptr) {
+
+        Finalizer* finalizer = finalizers;
+        finalizers = finalizer->next;
+        finalizer->destroy(finalizer->object);
+
+    }
+
+    arenaBytes->set(static_cast< int64_t >(getUsed()));
+
+    if (spills != nullptr) {
+
+        size_t needed = offset + spilled;
+
+        while (spills != nullptr) {
+
+            Spill* spill = spills;
+            spills = spill->next;
+            ::operator delete(spill);
+
+        }
+
+        capacity = std::max(capacity * 2, needed);
+        ::operator delete(block);
+        block = static_cast< unsigned char* >(::operator new(capacity));
+
+    }
+
+    offset  = 0;
+    spilled = 0;
+
+}
+
+size_t FrameArena::getUsed() {
+
+    return offset + spilled;
+
+}
+
+size_t FrameArena::getCapacity() {
+
+    return capacity;
+
+}
+
+FrameArena::~FrameArena() {
+
+    while (finalizers != nullptr) {
+
+        Finalizer* finalizer = finalizers;
+        finalizers = finalizer->next;
+        finalizer->destroy(finalizer->object);
+
+    }
+
+    while (spills != nullptr) {
+
+        Spill* spill = spills;
+        spills = spill->next;
+        ::operator delete(spill);
+
+    }
+
+    ::operator delete(block);
+
+}
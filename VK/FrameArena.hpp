@@ -0,0 +1,175 @@
+/**
+    Declares the FrameArena class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FrameArena.hpp
+    @brief        Declaration of the FrameArena class, a linear allocator for memory that lives for one frame
+*/
+#ifndef FRAME_ARENA_HPP
+#define FRAME_ARENA_HPP
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+    Hands out memory by bumping an offset into a single block, nothing is freed individually. The whole arena is
+    reset at once when the frame that used it has finished on the GPU. A frame that does not fit spills into
+    extra blocks, the next reset replaces them with one block large enough for it, so the steady state never
+    touches the heap.
+*/
+class FrameArena {
+public:
+
+    /**
+        Constructor
+
+        @param      capacity_       The initial size of the block in bytes
+    */
+    explicit FrameArena(size_t capacity_);
+
+    /**
+        Allocates memory that stays valid until the next reset
+
+        @param      size_           The size in bytes
+        @param      alignment_      The alignment, has to be a power of two
+
+        @return     Returns a pointer to uninitialized memory
+    */
+    void* allocate(size_t size_, size_t alignment_);
+
+    /**
+        Constructs an object in the arena, its destructor runs at the next reset
+
+        @param      args_           The constructor arguments
+
+        @return     Returns a pointer to the new object
+    */
+    template< typename T, typename... Args >
+    T* create(Args&&... args_) {
+
+        T* object = new(allocate(sizeof(T), alignof(T))) T(std::forward< Args >(args_)...);
+
+        if (!std::is_trivially_destructible< T >::value) {
+
+            Finalizer* finalizer    = new(allocate(sizeof(Finalizer), alignof(Finalizer))) Finalizer();
+            finalizer->destroy      = [](void* object_) { static_cast< T* >(object_)->~T(); };
+            finalizer->object       = object;
+            finalizer->next         = finalizers;
+            finalizers              = finalizer;
+
+        }
+
+        return object;
+
+    }
+
+    /**
+        Destroys the objects created since the last reset and makes the whole block available again
+    */
+    void reset(void);
+
+    /**
+        Returns the number of bytes allocated since the last reset
+
+        @return     Returns the used size, blocks the frame spilled into included
+    */
+    size_t getUsed(void);
+
+    /**
+        Returns the size of the block
+
+        @return     Returns the capacity in bytes
+    */
+    size_t getCapacity(void);
+
+    /**
+        Default destructor, runs pending destructors and frees the blocks
+    */
+    ~FrameArena(void);
+
+private:
+
+    /**
+        Destroys an object created with create() at reset, lives in the arena itself
+    */
+    struct Finalizer {
+
+        void                            (*destroy)(void*);
+        void*                           object;
+        Finalizer*                      next;
+
+    };
+
+    /**
+        A block allocated because the frame did not fit, chained in front of its memory
+    */
+    struct Spill {
+
+        Spill*                          next;
+
+    };
+
+    unsigned char*                      block           = nullptr;
+    size_t                              capacity        = 0;
+    size_t                              offset          = 0;
+    size_t                              spilled         = 0;            // Bytes served from spill blocks since the last reset
+    Spill*                              spills          = nullptr;
+    Finalizer*                          finalizers      = nullptr;
+
+};
+
+/**
+    Allocator adaptor so standard containers can live in a FrameArena, deallocation is a no-op
+*/
+template< typename T >
+class FrameAllocator {
+public:
+
+    typedef T value_type;
+
+    FrameArena*                         arena;
+
+    /**
+        Constructor
+
+        @param      arena_          The arena to allocate from
+    */
+    explicit FrameAllocator(FrameArena* arena_) : arena(arena_) {}
+
+    /**
+        Rebinding constructor, shares the arena of another allocator
+    */
+    template< typename U >
+    FrameAllocator(const FrameAllocator< U >& other_) : arena(other_.arena) {}
+
+    T* allocate(size_t count_) {
+
+        return static_cast< T* >(arena->allocate(count_ * sizeof(T), alignof(T)));
+
+    }
+
+    void deallocate(T*, size_t) {}          // Reclaimed by the next reset
+
+    template< typename U >
+    bool operator==(const FrameAllocator< U >& other_) const {
+
+        return arena == other_.arena;
+
+    }
+
+    template< typename U >
+    bool operator!=(const FrameAllocator< U >& other_) const {
+
+        return arena != other_.arena;
+
+    }
+
+};
+
+template< typename T >
+using FrameVector = std::vector< T, FrameAllocator< T > >;
+#endif  // FRAME_ARENA_HPP
@@ -0,0 +1,256 @@
+/**
+    Implements the counters namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FrameCounters.cpp
+    @brief        Implementation of the counters namespace, per-frame counts of draws, binds, descriptor writes and uploads
+*/
+#include "FrameCounters.hpp"
+
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "VK.hpp"
+
+namespace vk {
+
+    namespace counters {
+
+        Slot                                    current[FC_COUNT];
+        std::atomic< uint64_t >                 frameNumber         = { 0 };
+        std::mutex                              statsMutex;
+        FrameStats                              lastFrame           = {};
+        FrameStats                              frameTotals         = {};
+        FrameStats                              summaryStart        = {};       // Totals at the previous summary
+        VkQueryPool                             queryPool           = VK_NULL_HANDLE;
+        std::vector< bool >                     queryPending;                   // Whether a command buffer's query was recorded and not collected yet
+
+        thread_local bool                       countingHeap        = false;
+
+        void countHeapAllocations(bool enabled_) {
+
+            countingHeap = enabled_;
+
+        }
+
+        void endFrame() {
+
+            static Counter* metrics[FC_COUNT] = {};
+            if (metrics[0] == nullptr) {
+
+                for (uint32_t i = 0; i < FC_COUNT; i++) {
+
+                    metrics[i] = vk::metrics::counter(std::string("render_") + FRAME_COUNTER_NAMES[i] + "_total", std::string("Sum of the per-frame counter ") + FRAME_COUNTER_NAMES[i]);
+
+                }
+
+            }
+
+            FrameStats frame    = {};
+            frame.frames        = 1;
+            for (uint32_t i = 0; i < FC_COUNT; i++) {
+
+                frame.values[i] = current[i].value.exchange(0, std::memory_order_relaxed);
+                metrics[i]->add(frame.values[i]);
+
+            }
+
+            frameNumber.fetch_add(1, std::memory_order_relaxed);
+
+            std::scoped_lock< std::mutex > lock(statsMutex);
+            lastFrame = frame;
+            frameTotals.frames++;
+            for (uint32_t i = 0; i < FC_COUNT; i++) {
+
+                frameTotals.values[i] += frame.values[i];
+
+            }
+
+        }
+
+        FrameStats last() {
+
+            std::scoped_lock< std::mutex > lock(statsMutex);
+
+            return lastFrame;
+
+        }
+
+        FrameStats totals() {
+
+            std::scoped_lock< std::mutex > lock(statsMutex);
+
+            return frameTotals;
+
+        }
+
+        void logSummary() {
+
+            std::unique_lock< std::mutex > lock(statsMutex);
+            uint64_t frames = frameTotals.frames - summaryStart.frames;
+            if (frames == 0) return;
+
+            std::string summary = "Per frame (" + std::to_string(frames) + " frames):";
+            for (uint32_t i = 0; i < FC_COUNT; i++) {
+
+                uint64_t sum = frameTotals.values[i] - summaryStart.values[i];
+#ifndef VK_PIPELINE_STATISTICS
+                if (i == FC_VERTEX_INVOCATIONS || i == FC_FRAGMENT_INVOCATIONS) continue;
+#endif
+#ifndef VK_HEAP_TRACKING
+                if (i == FC_HEAP_ALLOCATIONS) continue;
+#endif
+                summary += " " + std::string(FRAME_COUNTER_NAMES[i]) + " " + std::to_string(sum / frames);
+
+            }
+            summaryStart = frameTotals;
+            lock.unlock();
+
+            logger::log(EVENT_LOG, summary);
+
+        }
+
+        void createQueries(uint32_t count_) {
+
+#ifdef VK_PIPELINE_STATISTICS
+            VkPhysicalDeviceFeatures supportedFeatures;
+            vkGetPhysicalDeviceFeatures(vk::core::physicalDevice, &supportedFeatures);
+            if (!supportedFeatures.pipelineStatisticsQuery) {
+
+                logger::log(EVENT_LOG, "The device does not support pipeline statistics queries, shader invocations are not counted");
+                return;
+
+            }
+
+            VkQueryPoolCreateInfo queryPoolCreateInfo       = {};
+            queryPoolCreateInfo.sType                       = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            queryPoolCreateInfo.queryType                   = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            queryPoolCreateInfo.queryCount                  = count_;
+            queryPoolCreateInfo.pipelineStatistics          = VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+            VkResult result = vkCreateQueryPool(vk::core::logicalDevice, &queryPoolCreateInfo, vk::core::allocator, &queryPool);
+            if (result != VK_SUCCESS) {
+
+                queryPool = VK_NULL_HANDLE;
+                logger::log(EVENT_LOG, "Failed to create the pipeline statistics query pool, shader invocations are not counted");
+                return;
+
+            }
+
+            queryPending.assign(count_, false);
+            add(FC_OBJECTS_CREATED);
+#else
+            (void) count_;
+#endif
+
+        }
+
+        void destroyQueries() {
+
+            if (queryPool == VK_NULL_HANDLE) return;
+
+            VkQueryPool pool = queryPool;
+            vk::deletion::retire([pool]() {
+
+                vkDestroyQueryPool(vk::core::logicalDevice, pool, vk::core::allocator);
+                add(FC_OBJECTS_DESTROYED);
+
+            });
+            queryPool = VK_NULL_HANDLE;
+            queryPending.clear();
+
+        }
+
+        void resetQuery(VkCommandBuffer commandBuffer_, uint32_t index_) {
+
+            if (queryPool == VK_NULL_HANDLE) return;
+
+            vkCmdResetQueryPool(commandBuffer_, queryPool, index_, 1);
+
+        }
+
+        void beginQuery(VkCommandBuffer commandBuffer_, uint32_t index_) {
+
+            if (queryPool == VK_NULL_HANDLE) return;
+
+            vkCmdBeginQuery(commandBuffer_, queryPool, index_, 0);
+
+        }
+
+        void endQuery(VkCommandBuffer commandBuffer_, uint32_t index_) {
+
+            if (queryPool == VK_NULL_HANDLE) return;
+
+            vkCmdEndQuery(commandBuffer_, queryPool, index_);
+            queryPending[index_] = true;
+
+        }
+
+        void collectQuery(uint32_t index_) {
+
+            if (queryPool == VK_NULL_HANDLE || !queryPending[index_]) return;
+
+            uint64_t results[2];        // In bit order: vertex, then fragment shader invocations
+            VkResult result = vkGetQueryPoolResults(
+                vk::core::logicalDevice,
+                queryPool,
+                index_,
+                1,
+                sizeof(results),
+                results,
+                sizeof(results),
+                VK_QUERY_RESULT_64_BIT
+                );
+            queryPending[index_] = false;       // Not ready means it is being overwritten anyway, never wait for the GPU here
+            if (result != VK_SUCCESS) return;
+
+            add(FC_VERTEX_INVOCATIONS, results[0]);
+            add(FC_FRAGMENT_INVOCATIONS, results[1]);
+
+        }
+
+    }
+
+}
+
+#ifdef VK_HEAP_TRACKING
+/**
+    Replaces the global allocation functions to count what the threads marked with countHeapAllocations() allocate,
+    the array and nothrow forms forward to these
+*/
+void* operator new(std::size_t size_) {
+
+    if (vk::counters::countingHeap) {
+
+        vk::counters::add(FC_HEAP_ALLOCATIONS);
+
+    }
+
+    void* memory = std::malloc(size_ > 0 ? size_ : 1);
+    if (memory == nullptr) {
+
+        throw std::bad_alloc();
+
+    }
+
+    return memory;
+
+}
+
+void operator delete(void* memory_) noexcept {
+
+    std::free(memory_);
+
+}
+
+void operator delete(void* memory_, std::size_t) noexcept {
+
+    std::free(memory_);
+
+}
+#endif
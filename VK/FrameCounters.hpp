@@ -0,0 +1,141 @@
+/**
+    Prototypes the counters namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FrameCounters.hpp
+    @brief        Prototype of the counters namespace, per-frame counts of draws, binds, descriptor writes and uploads
+*/
+#ifndef FRAME_COUNTERS_HPP
+#define FRAME_COUNTERS_HPP
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "Version.hpp"
+#include "FrameStats.cpp"
+
+namespace vk {
+
+    /**
+        Counts what the renderer, the loaders and the upload paths do per frame. Any thread may count, the main thread
+        closes a frame with endFrame().
+    */
+    namespace counters {
+
+        /**
+            A counter on its own cache line, loader threads count uploads while the render thread counts draws
+        */
+        struct alignas(64) Slot {
+
+            std::atomic< uint64_t >             value;
+
+        };
+
+        extern Slot                             current[FC_COUNT];
+        extern std::atomic< uint64_t >          frameNumber;
+
+        /**
+            Returns the number of the frame being recorded, any thread may call it
+
+            @return     Returns the number of frames closed with endFrame() so far
+        */
+        inline uint64_t frame(void) {
+
+            return frameNumber.load(std::memory_order_relaxed);
+
+        }
+
+        /**
+            Adds to a counter of the current frame
+
+            @param      counter_        The counter
+            @param      value_          The amount to add
+        */
+        inline void add(FRAME_COUNTER counter_, uint64_t value_ = 1) {
+
+            current[counter_].value.fetch_add(value_, std::memory_order_relaxed);
+
+        }
+
+        /**
+            Counts the heap allocations of the calling thread as FC_HEAP_ALLOCATIONS, does nothing without VK_HEAP_TRACKING
+
+            @param      enabled_            Whether to count them
+        */
+        void countHeapAllocations(bool enabled_);
+
+        /**
+            Closes the current frame: its counts become the last frame and are added to the totals and the metrics
+        */
+        void endFrame(void);
+
+        /**
+            Returns the counts of the last finished frame
+
+            @return     Returns a FrameStats with frames set to 1
+        */
+        FrameStats last(void);
+
+        /**
+            Returns the counts summed over all finished frames
+
+            @return     Returns a FrameStats
+        */
+        FrameStats totals(void);
+
+        /**
+            Writes the per-frame averages since the previous summary to the event log
+        */
+        void logSummary(void);
+
+        /**
+            Creates one pipeline statistics query per command buffer, does nothing without VK_PIPELINE_STATISTICS
+
+            @param      count_      The number of command buffers
+        */
+        void createQueries(uint32_t count_);
+
+        /**
+            Retires the pipeline statistics queries, their pool is destroyed once the frames using it have finished
+        */
+        void destroyQueries(void);
+
+        /**
+            Resets the query of a command buffer, has to be recorded outside of a render pass
+
+            @param      commandBuffer_      The command buffer being recorded
+            @param      index_              The index of the command buffer
+        */
+        void resetQuery(VkCommandBuffer commandBuffer_, uint32_t index_);
+
+        /**
+            Begins the query of a command buffer
+
+            @param      commandBuffer_      The command buffer being recorded
+            @param      index_              The index of the command buffer
+        */
+        void beginQuery(VkCommandBuffer commandBuffer_, uint32_t index_);
+
+        /**
+            Ends the query of a command buffer
+
+            @param      commandBuffer_      The command buffer being recorded
+            @param      index_              The index of the command buffer
+        */
+        void endQuery(VkCommandBuffer commandBuffer_, uint32_t index_);
+
+        /**
+            Adds the results of the last submission of a command buffer to the current frame if they are available,
+            has to be called before the command buffer is recorded again
+
+            @param      index_              The index of the command buffer
+        */
+        void collectQuery(uint32_t index_);
+
+    }
+
+}
+#endif  // FRAME_COUNTERS_HPP
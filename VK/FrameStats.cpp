@@ -0,0 +1,25 @@
+/**
+    Defines the FrameStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         FrameStats.cpp
+    @brief        Definition of the FrameStats struct
+*/
+#ifndef FRAME_STATS_CPP
+#define FRAME_STATS_CPP
+#include <cstdint>
+
+#include "FRAME_COUNTER.cpp"
+
+/**
+    Holds the per-frame counters of one frame or their sum over several frames
+*/
+struct FrameStats {
+
+    uint64_t            frames;                 // Number of frames the values were summed over
+    uint64_t            values[FC_COUNT];       // Indexed by FRAME_COUNTER
+
+};
+#endif  // FRAME_STATS_CPP
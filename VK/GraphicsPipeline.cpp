@@ -75,6 +75,7 @@ GraphicsPipeline::GraphicsPipeline(
         &pipeline
         );
     ASSERT(result, "Failed to create graphics pipeline", VK_SC_GRAPHICS_PIPELINE_CREATION_ERROR);
+    vk::counters::add(FC_OBJECTS_CREATED, 2);       // The pipeline and its layout
 
     destroyShaderModules();
 
@@ -93,6 +94,7 @@ VK_STATUS_CODE GraphicsPipeline::destroy() {
 
     vkDestroyPipelineLayout(vk::core::logicalDevice, pipelineLayout, vk::core::allocator);
     logger::log(EVENT_LOG, "Successfully destroyed pipeline layout");
+    vk::counters::add(FC_OBJECTS_DESTROYED, 2);
 
     return vk::errorCodeBuffer;
 
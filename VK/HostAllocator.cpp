@@ -0,0 +1,350 @@
+/**
+    Implements the hostmemory namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         HostAllocator.cpp
+    @brief        Implementation of the hostmemory namespace, the VkAllocationCallbacks that track the driver's host memory
+*/
+#include "HostAllocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "Logger.hpp"
+#include "Metrics.hpp"
+
+namespace vk {
+
+    namespace hostmemory {
+
+        namespace {
+
+            const uint32_t          SCOPE_COUNT             = VK_SYSTEM_ALLOCATION_SCOPE_RANGE_SIZE;
+            const size_t            ARENA_CHUNK_SIZE        = 64 * 1024;
+            const size_t            ARENA_MAX_ALLOCATION    = 4 * 1024;         // Larger command scope allocations go to malloc, they would waste most of a chunk
+            const char*             SCOPE_NAMES[]           = { "command", "object", "cache", "device", "instance" };
+
+            /**
+                Sits right in front of every block handed to the driver, realloc and free only get the pointer
+            */
+            struct Header {
+
+                void*                               raw;            // What malloc returned, or the arena chunk
+                size_t                              size;
+                uint8_t                             scope;
+                bool                                arena;
+
+            };
+
+            /**
+                A block of command scope allocations, freed once the owning thread moved on and every allocation is gone
+            */
+            struct Chunk {
+
+                std::atomic< uint32_t >             references;     // Live allocations, plus one while it is the owner's current chunk
+                size_t                              used;
+                alignas(16) unsigned char           data[ARENA_CHUNK_SIZE];
+
+            };
+
+            void releaseChunk(Chunk* chunk_) {
+
+                if (chunk_ != nullptr && chunk_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+
+                    delete chunk_;
+
+                }
+
+            }
+
+            /**
+                The arena chunk of a thread, only the owning thread allocates from it
+            */
+            struct Arena {
+
+                Chunk*                              chunk           = nullptr;
+
+                ~Arena(void) {
+
+                    releaseChunk(chunk);
+
+                }
+
+            };
+
+            std::atomic< uint64_t >     scopeBytes[SCOPE_COUNT];
+            std::atomic< uint64_t >     scopePeakBytes[SCOPE_COUNT];
+            std::atomic< uint64_t >     scopeLive[SCOPE_COUNT];
+            std::atomic< uint64_t >     scopeAllocations[SCOPE_COUNT];
+            std::atomic< uint64_t >     scopeInternalBytes[SCOPE_COUNT];
+            std::atomic< uint64_t >     totalBytes;
+            std::atomic< uint64_t >     peakTotalBytes;
+            std::atomic< uint64_t >     arenaAllocations;
+            thread_local Arena          arena;
+
+            void raise(std::atomic< uint64_t >& peak_, uint64_t value_) {
+
+                uint64_t peak = peak_.load(std::memory_order_relaxed);
+                while (value_ > peak && !peak_.compare_exchange_weak(peak, value_, std::memory_order_relaxed)) {}
+
+            }
+
+            void track(uint8_t scope_, size_t size_, bool allocated_) {
+
+                static Gauge*   hostBytes           = vk::metrics::gauge("memory_host_bytes", "Host memory the driver allocated through the engine");
+                static Gauge*   hostPeakBytes       = vk::metrics::gauge("memory_host_peak_bytes", "Highest memory_host_bytes seen");
+                static Counter* hostAllocations     = vk::metrics::counter("memory_host_allocations_total", "Host allocations the driver made through the engine");
+
+                if (allocated_) {
+
+                    uint64_t bytes = scopeBytes[scope_].fetch_add(size_, std::memory_order_relaxed) + size_;
+                    uint64_t total = totalBytes.fetch_add(size_, std::memory_order_relaxed) + size_;
+                    scopeLive[scope_].fetch_add(1, std::memory_order_relaxed);
+                    scopeAllocations[scope_].fetch_add(1, std::memory_order_relaxed);
+                    raise(scopePeakBytes[scope_], bytes);
+                    raise(peakTotalBytes, total);
+
+                    hostBytes->add(static_cast< int64_t >(size_));
+                    hostPeakBytes->set(static_cast< int64_t >(peakTotalBytes.load(std::memory_order_relaxed)));
+                    hostAllocations->add();
+
+                }
+                else {
+
+                    scopeBytes[scope_].fetch_sub(size_, std::memory_order_relaxed);
+                    totalBytes.fetch_sub(size_, std::memory_order_relaxed);
+                    scopeLive[scope_].fetch_sub(1, std::memory_order_relaxed);
+
+                    hostBytes->add(-static_cast< int64_t >(size_));
+
+                }
+
+            }
+
+            uintptr_t alignUp(uintptr_t address_, size_t alignment_) {
+
+                return (address_ + alignment_ - 1) & ~(static_cast< uintptr_t >(alignment_) - 1);
+
+            }
+
+        #ifdef VK_HOST_ALLOCATOR_ARENA
+            void* allocateFromArena(size_t size_, size_t alignment_) {
+
+                size_t worstCase = size_ + sizeof(Header) + alignment_ - 1;
+
+                if (arena.chunk != nullptr && arena.chunk->references.load(std::memory_order_acquire) == 1) {
+
+                    arena.chunk->used = 0;         // Every allocation in it was freed, start over instead of taking a new chunk
+
+                }
+
+                if (arena.chunk == nullptr || arena.chunk->used + worstCase > ARENA_CHUNK_SIZE) {
+
+                    releaseChunk(arena.chunk);
+                    arena.chunk = new Chunk;
+                    arena.chunk->references.store(1, std::memory_order_relaxed);
+                    arena.chunk->used = 0;
+
+                }
+
+                Chunk* chunk        = arena.chunk;
+                uintptr_t begin     = reinterpret_cast< uintptr_t >(chunk->data) + chunk->used;
+                uintptr_t aligned   = alignUp(begin + sizeof(Header), alignment_);
+                chunk->used         = aligned + size_ - reinterpret_cast< uintptr_t >(chunk->data);
+                chunk->references.fetch_add(1, std::memory_order_relaxed);
+
+                Header* header      = reinterpret_cast< Header* >(aligned) - 1;
+                header->raw         = chunk;
+                header->arena       = true;
+                arenaAllocations.fetch_add(1, std::memory_order_relaxed);
+
+                return reinterpret_cast< void* >(aligned);
+
+            }
+        #endif
+
+            void* VKAPI_CALL allocate(
+                void*                               userData_,
+                size_t                              size_,
+                size_t                              alignment_,
+                VkSystemAllocationScope             scope_
+                ) {
+
+                (void) userData_;
+                if (size_ == 0) return nullptr;
+
+                size_t alignment    = std::max(alignment_, alignof(Header));
+                void* memory        = nullptr;
+
+            #ifdef VK_HOST_ALLOCATOR_ARENA
+                if (scope_ == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND && size_ <= ARENA_MAX_ALLOCATION && alignment <= 256) {
+
+                    memory = allocateFromArena(size_, alignment);
+
+                }
+            #endif
+
+                if (memory == nullptr) {
+
+                    void* raw = std::malloc(size_ + sizeof(Header) + alignment - 1);
+                    if (raw == nullptr) return nullptr;
+
+                    memory              = reinterpret_cast< void* >(alignUp(reinterpret_cast< uintptr_t >(raw) + sizeof(Header), alignment));
+                    Header* header      = static_cast< Header* >(memory) - 1;
+                    header->raw         = raw;
+                    header->arena       = false;
+
+                }
+
+                Header* header      = static_cast< Header* >(memory) - 1;
+                header->size        = size_;
+                header->scope       = static_cast< uint8_t >(scope_);
+                track(header->scope, size_, true);
+
+                return memory;
+
+            }
+
+            void VKAPI_CALL deallocate(void* userData_, void* memory_) {
+
+                (void) userData_;
+                if (memory_ == nullptr) return;
+
+                Header* header = static_cast< Header* >(memory_) - 1;
+                track(header->scope, header->size, false);
+
+                if (header->arena) {
+
+                    releaseChunk(static_cast< Chunk* >(header->raw));
+
+                }
+                else {
+
+                    std::free(header->raw);
+
+                }
+
+            }
+
+            void* VKAPI_CALL reallocate(
+                void*                               userData_,
+                void*                               original_,
+                size_t                              size_,
+                size_t                              alignment_,
+                VkSystemAllocationScope             scope_
+                ) {
+
+                if (original_ == nullptr) return allocate(userData_, size_, alignment_, scope_);
+
+                if (size_ == 0) {
+
+                    deallocate(userData_, original_);
+                    return nullptr;
+
+                }
+
+                void* memory = allocate(userData_, size_, alignment_, scope_);
+                if (memory == nullptr) return nullptr;         // The original stays valid, as the specification requires
+
+                std::memcpy(memory, original_, std::min(size_, (static_cast< Header* >(original_) - 1)->size));
+                deallocate(userData_, original_);
+
+                return memory;
+
+            }
+
+            void VKAPI_CALL internalAllocation(
+                void*                               userData_,
+                size_t                              size_,
+                VkInternalAllocationType            type_,
+                VkSystemAllocationScope             scope_
+                ) {
+
+                (void) userData_;
+                (void) type_;
+                scopeInternalBytes[scope_].fetch_add(size_, std::memory_order_relaxed);
+
+            }
+
+            void VKAPI_CALL internalFree(
+                void*                               userData_,
+                size_t                              size_,
+                VkInternalAllocationType            type_,
+                VkSystemAllocationScope             scope_
+                ) {
+
+                (void) userData_;
+                (void) type_;
+                scopeInternalBytes[scope_].fetch_sub(size_, std::memory_order_relaxed);
+
+            }
+
+        }
+
+        VkAllocationCallbacks* callbacks() {
+
+            static VkAllocationCallbacks allocationCallbacks = {
+                nullptr,
+                allocate,
+                reallocate,
+                deallocate,
+                internalAllocation,
+                internalFree
+            };
+
+            return &allocationCallbacks;
+
+        }
+
+        HostMemoryStats stats() {
+
+            HostMemoryStats snapshot = {};
+            for (uint32_t i = 0; i < SCOPE_COUNT; i++) {
+
+                snapshot.bytes[i]           = scopeBytes[i].load(std::memory_order_relaxed);
+                snapshot.peakBytes[i]       = scopePeakBytes[i].load(std::memory_order_relaxed);
+                snapshot.live[i]            = scopeLive[i].load(std::memory_order_relaxed);
+                snapshot.allocations[i]     = scopeAllocations[i].load(std::memory_order_relaxed);
+                snapshot.internalBytes[i]   = scopeInternalBytes[i].load(std::memory_order_relaxed);
+
+            }
+            snapshot.totalBytes             = totalBytes.load(std::memory_order_relaxed);
+            snapshot.peakTotalBytes         = peakTotalBytes.load(std::memory_order_relaxed);
+            snapshot.arenaAllocations       = arenaAllocations.load(std::memory_order_relaxed);
+
+            return snapshot;
+
+        }
+
+        void logStats() {
+
+            HostMemoryStats snapshot = stats();
+
+            logger::log(EVENT_LOG, "Driver host memory: "
+                + std::to_string(snapshot.totalBytes) + " bytes, "
+                + std::to_string(snapshot.peakTotalBytes) + " peak, "
+                + std::to_string(snapshot.arenaAllocations) + " arena allocations"
+                );
+
+            for (uint32_t i = 0; i < SCOPE_COUNT; i++) {
+
+                logger::log(EVENT_LOG, "Driver host memory (" + std::string(SCOPE_NAMES[i]) + " scope): "
+                    + std::to_string(snapshot.bytes[i]) + " bytes in "
+                    + std::to_string(snapshot.live[i]) + " allocations, "
+                    + std::to_string(snapshot.peakBytes[i]) + " peak, "
+                    + std::to_string(snapshot.allocations[i]) + " allocated in total, "
+                    + std::to_string(snapshot.internalBytes[i]) + " internal"
+                    );
+
+            }
+
+        }
+
+    }
+
+}
@@ -0,0 +1,47 @@
+/**
+    Prototypes the hostmemory namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         HostAllocator.hpp
+    @brief        Prototype of the hostmemory namespace, the VkAllocationCallbacks that track the driver's host memory
+*/
+#ifndef HOST_ALLOCATOR_HPP
+#define HOST_ALLOCATOR_HPP
+#include <vulkan/vulkan.h>
+
+#include "Version.hpp"
+#include "HostMemoryStats.cpp"
+
+namespace vk {
+
+    /**
+        Routes the driver's host allocations through the engine so they can be counted by scope. With
+        VK_HOST_ALLOCATOR_ARENA small command scope allocations come from a per-thread bump arena instead of malloc.
+    */
+    namespace hostmemory {
+
+        /**
+            Returns the allocation callbacks, they stay valid for the lifetime of the process
+
+            @return     Returns a pointer to pass wherever the Vulkan API takes a VkAllocationCallbacks*
+        */
+        VkAllocationCallbacks* callbacks(void);
+
+        /**
+            Returns current and peak usage by scope
+
+            @return     Returns a HostMemoryStats snapshot
+        */
+        HostMemoryStats stats(void);
+
+        /**
+            Writes current and peak usage by scope to the event log
+        */
+        void logStats(void);
+
+    }
+
+}
+#endif  // HOST_ALLOCATOR_HPP
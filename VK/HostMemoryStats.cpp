@@ -0,0 +1,31 @@
+/**
+    Defines the HostMemoryStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         HostMemoryStats.cpp
+    @brief        Definition of the HostMemoryStats struct
+*/
+#ifndef HOST_MEMORY_STATS_CPP
+#define HOST_MEMORY_STATS_CPP
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+/**
+    Holds the host memory the driver allocated through the engine's allocation callbacks, indexed by VkSystemAllocationScope
+*/
+struct HostMemoryStats {
+
+    uint64_t            bytes[VK_SYSTEM_ALLOCATION_SCOPE_RANGE_SIZE];               // Bytes currently allocated
+    uint64_t            peakBytes[VK_SYSTEM_ALLOCATION_SCOPE_RANGE_SIZE];           // Highest bytes seen
+    uint64_t            live[VK_SYSTEM_ALLOCATION_SCOPE_RANGE_SIZE];                // Allocations not freed yet
+    uint64_t            allocations[VK_SYSTEM_ALLOCATION_SCOPE_RANGE_SIZE];         // Allocations and reallocations ever made
+    uint64_t            internalBytes[VK_SYSTEM_ALLOCATION_SCOPE_RANGE_SIZE];       // Bytes the driver allocated itself and only reported
+    uint64_t            totalBytes;                                                 // Sum of bytes over every scope
+    uint64_t            peakTotalBytes;                                             // Highest totalBytes seen
+    uint64_t            arenaAllocations;                                           // Command scope allocations served by a per-thread arena
+
+};
+#endif  // HOST_MEMORY_STATS_CPP
@@ -0,0 +1,305 @@
+/**
+    Implements the HotReloader class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         HotReloader.cpp
+    @brief        Implementation of the HotReloader class, swaps in assets that changed on disk while the engine runs
+*/
+#include "HotReloader.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <memory>
+
+#include "VK.hpp"
+#include "FileIO.hpp"
+
+namespace {
+
+    const std::chrono::milliseconds     SETTLE_TIME             = std::chrono::milliseconds(50);        // Editors often write a file several times in a row
+
+    std::string extensionOf(const std::string& path_) {
+
+        size_t dot = path_.find_last_of('.');
+        std::string extension = dot == std::string::npos ? std::string() : path_.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c_) { return static_cast< char >(std::tolower(c_)); });
+
+        return extension;
+
+    }
+
+    std::string directoryOf(const std::string& path_) {
+
+        size_t separator = path_.find_last_of("/\\");
+
+        return separator == std::string::npos ? std::string(".") : path_.substr(0, separator);
+
+    }
+
+}
+
+HotReloader::HotReloader(
+    JobSystem*                          jobSystem_,
+    const std::vector< std::string >&   directories_
+    ) : jobSystem(jobSystem_), watcher(directories_) {
+
+    if (!watcher.isValid()) {
+
+        logger::log(EVENT_LOG, "Failed to watch the asset directories, hot reloading is disabled");
+
+    }
+
+}
+
+void HotReloader::update(std::vector< Model* >& models_) {
+
+    TimePoint now = std::chrono::steady_clock::now();
+
+    changed.clear();
+    watcher.poll(changed);
+    for (const auto& path : changed) {
+
+        auto it = changes.find(path);
+        if (it == changes.end()) changes.emplace(path, Change{ now, now });
+        else it->second.last = now;
+
+    }
+
+    for (auto it = changes.begin(); it != changes.end(); ) {
+
+        if (now - it->second.last < SETTLE_TIME) {
+
+            ++it;
+            continue;
+
+        }
+
+        dispatch(it->first, it->second.first, models_);
+        it = changes.erase(it);
+
+    }
+
+    pending.erase(std::remove_if(pending.begin(), pending.end(), [](const JobHandle& job_) { return job_->done.load(); }), pending.end());
+
+    applying.clear();
+    {
+
+        std::scoped_lock< std::mutex > lock(readyMutex);
+        applying.swap(ready);
+
+    }
+
+    for (auto& replacement : applying) {
+
+        if (replacement.texture != nullptr && vk::core::textureResidency != nullptr && vk::core::textureResidency->holds(replacement.texture)) {
+
+            std::scoped_lock< std::mutex > lock(readyMutex);
+            ready.push_back(std::move(replacement));        // A streaming job may still copy into the old image, which the swap would retire
+            continue;
+
+        }
+
+        if (!replacement.apply(models_)) {
+
+            replacement.discard();      // Never drawn, so it can go right away
+            continue;
+
+        }
+
+        double milliseconds = std::chrono::duration< double, std::milli >(now - replacement.detected).count();
+        reloadStats.reloads++;
+        reloadStats.lastMilliseconds    = milliseconds;
+        reloadStats.maxMilliseconds     = std::max(reloadStats.maxMilliseconds, milliseconds);
+        reloadStats.averageMilliseconds += (milliseconds - reloadStats.averageMilliseconds) / static_cast< double >(reloadStats.reloads);
+
+        VK_LOG_INFO(LC_ASSETS, "Reloaded '{}' in {} ms", replacement.path, milliseconds);
+
+    }
+
+}
+
+void HotReloader::dispatch(const std::string& path_, TimePoint detected_, std::vector< Model* >& models_) {
+
+    std::string extension   = extensionOf(path_);
+    std::string key         = vk::io::canonicalPath(path_);
+    vk::io::invalidate(path_);
+
+    if (extension == "spv") {
+
+        submit(path_, detected_, [this]() {
+
+            std::unique_lock< std::mutex > lock(vk::core::pipelineStateMutex);      // The render pass and layout must not be recreated meanwhile
+            uint64_t generation = vk::core::pipelineGeneration;
+            auto pipeline = std::make_shared< GraphicsPipeline >(vk::core::createStandardPipeline());
+            lock.unlock();
+
+            Replacement replacement;
+            replacement.apply = [this, pipeline, generation](std::vector< Model* >&) {
+
+                if (generation != vk::core::pipelineGeneration) return false;      // The swapchain was recreated, its pipeline uses the new shaders already
+
+                GraphicsPipeline old        = vk::core::standardPipeline;
+                vk::core::standardPipeline  = *pipeline;
+                vk::deletion::retire([old]() mutable { old.destroy(); });
+
+                return true;
+
+            };
+            replacement.discard = [pipeline]() { pipeline->destroy(); };
+
+            return replacement;
+
+            });
+
+        return;
+
+    }
+
+    if (extension == "obj" || extension == "mtl") {
+
+        for (Model* model : models_) {
+
+            std::string modelPath = vk::io::canonicalPath(model->getPath());
+            bool affected = extension == "obj" ? modelPath == key : directoryOf(modelPath) == directoryOf(key);
+            if (!affected) continue;
+
+            std::function< Model*() > load = model->reloader();
+            submit(path_, detected_, [this, model, load]() {
+
+                Model* fresh = load();
+
+                Replacement replacement;
+                replacement.apply = [this, model, fresh](std::vector< Model* >& models_) {
+
+                    if (std::find(models_.begin(), models_.end(), model) == models_.end()) return false;     // Unloaded meanwhile
+
+                    model->swap(*fresh);
+                    vk::deletion::retire([fresh]() { delete fresh; });      // Now holds the old meshes and textures
+
+                    return true;
+
+                };
+                replacement.discard = [fresh]() { delete fresh; };
+
+                return replacement;
+
+                });
+
+        }
+
+        return;
+
+    }
+
+    TextureImage* target = vk::textures::find(path_);
+    if (target == nullptr) return;      // Not a texture that is in use
+
+    submit(path_, detected_, [this, target, path = path_, key]() {
+
+        TextureImage* fresh = new TextureImage(
+            path.c_str(),
+            VK_FORMAT_R8G8B8A8_UNORM,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+            );
+        uint64_t hash = vk::textures::hash(path);      // Of the file that changed, not of a sibling with the old content
+
+        Replacement replacement;
+        replacement.apply = [this, target, fresh, path, key, hash](std::vector< Model* >& models_) {
+
+            if (vk::textures::find(path) != target) return false;      // Released meanwhile
+
+            if (!vk::textures::shared(path)) {
+
+                target->swap(*fresh);
+                vk::textures::rehash(target, hash);
+                vk::deletion::retire([fresh]() { delete fresh; });      // Now holds the old image
+
+                return true;
+
+            }
+
+            // Other paths had the same content, they keep the old texture and only the models using this path move
+            uint32_t moved = 0;
+            for (Model* model : models_) {
+
+                moved += model->retarget(key, target, fresh);
+
+            }
+
+            if (vk::textures::split(path, fresh, moved, hash)) vk::deletion::retire([target]() { delete target; });
+            if (moved == 0) vk::deletion::retire([fresh]() { delete fresh; });
+
+            return true;
+
+        };
+        replacement.discard = [fresh]() { delete fresh; };
+        replacement.texture = target;
+
+        return replacement;
+
+        });
+
+}
+
+void HotReloader::submit(const std::string& path_, TimePoint detected_, std::function< Replacement() > load_) {
+
+    pending.push_back(jobSystem->submit([this, path_, detected_, load_]() {
+
+        try {
+
+            Replacement replacement = load_();
+            replacement.path        = path_;
+            replacement.detected    = detected_;
+
+            std::scoped_lock< std::mutex > lock(readyMutex);
+            ready.push_back(std::move(replacement));
+
+        }
+        catch (const std::exception& exception) {
+
+            std::scoped_lock< std::mutex > lock(readyMutex);
+            reloadStats.failures++;
+            VK_LOG_WARNING(LC_ASSETS, "Failed to reload '{}', keeping the old version: {}", path_, exception.what());
+
+        }
+
+        }));
+
+}
+
+ReloadStats HotReloader::stats() {
+
+    std::scoped_lock< std::mutex > lock(readyMutex);
+
+    return reloadStats;
+
+}
+
+void HotReloader::logStats() {
+
+    ReloadStats snapshot = stats();
+
+    logger::log(EVENT_LOG, "Hot reload: "
+        + std::to_string(snapshot.reloads) + " reloads, "
+        + std::to_string(snapshot.failures) + " failures, "
+        + std::to_string(snapshot.averageMilliseconds) + " ms average, "
+        + std::to_string(snapshot.maxMilliseconds) + " ms max latency"
+        );
+
+}
+
+HotReloader::~HotReloader() {
+
+    jobSystem->wait(pending);
+
+    for (auto& replacement : ready) {
+
+        replacement.discard();
+
+    }
+
+}
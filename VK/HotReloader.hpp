@@ -0,0 +1,121 @@
+/**
+    Declares the HotReloader class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         HotReloader.hpp
+    @brief        Declaration of the HotReloader class, swaps in assets that changed on disk while the engine runs
+*/
+#ifndef HOT_RELOADER_HPP
+#define HOT_RELOADER_HPP
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "FileWatcher.hpp"
+#include "JobSystem.hpp"
+#include "Model.hpp"
+#include "ReloadStats.cpp"
+
+/**
+    Watches the asset directories and reloads what depends on a changed file on the job system: textures are decoded
+    and uploaded again, models are parsed and uploaded again (their textures are registry hits) and changed SPIR-V
+    rebuilds the standard pipeline. Replacements are swapped in at the start of a frame, and what they replace is
+    destroyed once no frame in flight can reference it anymore.
+*/
+class HotReloader {
+public:
+
+    /**
+        Constructor, starts watching
+
+        @param      jobSystem_      The job system to reload on
+        @param      directories_    (Relative) paths of the directories to watch
+    */
+    HotReloader(
+        JobSystem*                          jobSystem_,
+        const std::vector< std::string >&   directories_
+        );
+
+    /**
+        Starts reloads for files that changed and swaps in finished ones, has to be called by the main thread once per
+        frame before the frame is recorded
+
+        @param      models_     The models being drawn
+    */
+    void update(std::vector< Model* >& models_);
+
+    /**
+        Returns the reload statistics
+
+        @return     Returns a ReloadStats snapshot
+    */
+    ReloadStats stats(void);
+
+    /**
+        Writes the reload statistics to the event log
+    */
+    void logStats(void);
+
+    /**
+        Default destructor, destroys pending replacements, the device has to be idle
+    */
+    ~HotReloader(void);
+
+private:
+
+    typedef std::chrono::steady_clock::time_point       TimePoint;
+
+    /**
+        A file that changed, reloaded once it has not changed for a moment
+    */
+    struct Change {
+
+        TimePoint                                       first;
+        TimePoint                                       last;
+
+    };
+
+    /**
+        A finished reload waiting for the next frame boundary
+    */
+    struct Replacement {
+
+        std::string                                     path;
+        TimePoint                                       detected;
+        std::function< bool(std::vector< Model* >&) >   apply;          // Swaps the resource in, false if its target is gone
+        std::function< void() >                         discard;        // Destroys the replacement if it could not be applied
+        TextureImage*                                   texture         = nullptr;      // The texture a texture reload swaps out, waits while residency writes to it
+
+    };
+
+    JobSystem*                                          jobSystem;
+    FileWatcher                                         watcher;
+    std::vector< std::string >                          changed;        // Scratch space of update(), kept to avoid per-frame allocations
+    std::unordered_map< std::string, Change >           changes;
+    std::vector< JobHandle >                            pending;        // Reload jobs that may still touch this object
+    std::vector< Replacement >                          ready;
+    std::vector< Replacement >                          applying;       // Scratch space of update()
+    std::mutex                                          readyMutex;
+    ReloadStats                                         reloadStats     = {};
+
+    /**
+        Starts the reloads that depend on a changed file
+
+        @param      path_       (Relative) path of the file
+        @param      detected_   When the change was first noticed
+        @param      models_     The models being drawn
+    */
+    void dispatch(const std::string& path_, TimePoint detected_, std::vector< Model* >& models_);
+
+    /**
+        Runs a reload on the job system and queues its replacement, failures are logged and counted
+    */
+    void submit(const std::string& path_, TimePoint detected_, std::function< Replacement() > load_);
+};
+#endif  // HOT_RELOADER_HPP
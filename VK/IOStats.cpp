@@ -0,0 +1,30 @@
+/**
+    Defines the IOStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         IOStats.cpp
+    @brief        Definition of the IOStats struct
+*/
+#ifndef IO_STATS_CPP
+#define IO_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the throughput and prefetch statistics of the asset I/O layer
+*/
+struct IOStats {
+
+    uint64_t            filesRead;          // Files mapped and faulted in, by prefetches and by direct reads
+    uint64_t            bytesRead;          // Bytes faulted in
+    uint64_t            packageReads;       // Files served by a mounted package instead of the file system
+    double              bytesPerSecond;     // bytesRead over the time spent faulting them in
+    uint64_t            prefetchHits;       // Reads served by a prefetched or still cached file
+    uint64_t            prefetchMisses;     // Reads that had to go to the file system themselves
+    uint64_t            prefetchSkipped;    // Prefetches dropped because the cache was over budget
+    uint64_t            queueDepth;         // Prefetches submitted but not finished yet
+    uint64_t            peakQueueDepth;     // Highest queueDepth seen
+
+};
+#endif  // IO_STATS_CPP
@@ -0,0 +1,22 @@
+/**
+    Defines the JOB_AFFINITY enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         JOB_AFFINITY.cpp
+    @brief        Definition of the JOB_AFFINITY enumeration
+*/
+#ifndef JOB_AFFINITY_CPP
+#define JOB_AFFINITY_CPP
+
+/**
+ * Enumeration to differenciate between jobs any worker may run and jobs that must run on the main thread
+ */
+typedef enum JOB_AFFINITY {
+
+    JA_MAIN_THREAD      = 1,
+    JA_ANY              = 0
+
+} JOB_AFFINITY;
+#endif  // JOB_AFFINITY_CPP
@@ -0,0 +1,380 @@
+/**
+    Implements the JobSystem class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         JobSystem.cpp
+    @brief        Implementation of the JobSystem class, the engine-wide work-stealing scheduler
+*/
+#include "JobSystem.hpp"
+
+#include <string>
+
+#include "Logger.hpp"
+
+namespace {
+
+    thread_local int            currentWorker           = -1;       // Index of the worker owning the calling thread, -1 for other threads
+
+}
+
+JobSystem::JobSystem(uint32_t workerCount_) {
+
+    mainThread  = std::this_thread::get_id();
+    startTime   = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < workerCount_; i++) {
+
+        workers.push_back(std::make_unique< Worker >());
+
+    }
+
+    for (uint32_t i = 0; i < workerCount_; i++) {      // Start only once every deque exists, workers steal from each other right away
+
+        workers[i]->thread = std::thread(&JobSystem::work, this, i);
+
+    }
+
+}
+
+JobHandle JobSystem::submit(
+    std::function< void() >             task_,
+    const std::vector< JobHandle >&     dependencies_,
+    JOB_AFFINITY                        affinity_
+    ) {
+
+    JobHandle job       = std::make_shared< Job >();
+    job->task           = std::move(task_);
+    job->affinity       = affinity_;
+    job->unfinished     = 1;
+    job->done           = false;
+
+    for (const auto& dependency : dependencies_) {
+
+        std::scoped_lock< std::mutex > lock(dependency->continuationMutex);
+        if (!dependency->done) {
+
+            job->unfinished++;
+            dependency->continuations.push_back(job);
+
+        }
+
+    }
+
+    if (--job->unfinished == 0) {
+
+        schedule(job);
+
+    }
+
+    return job;
+
+}
+
+void JobSystem::schedule(const JobHandle& job_) {
+
+    if (job_->affinity == JA_MAIN_THREAD) {
+
+        std::scoped_lock< std::mutex > lock(mainThreadMutex);
+        mainThreadJobs.push_back(job_);
+        return;
+
+    }
+
+    if (currentWorker >= 0) {
+
+        Worker& worker = *workers[currentWorker];
+        std::scoped_lock< std::mutex > lock(worker.jobsMutex);
+        worker.jobs.push_back(job_);
+
+    }
+    else {
+
+        std::scoped_lock< std::mutex > lock(injectedMutex);
+        injected.push_back(job_);
+
+    }
+
+    queued++;
+
+    { std::scoped_lock< std::mutex > lock(sleepMutex); }       // Pairs with the predicate check in work() so the wakeup cannot be lost
+    sleepCondVar.notify_one();
+
+}
+
+JobHandle JobSystem::next(int index_) {
+
+    JobHandle job;
+
+    if (index_ >= 0) {
+
+        Worker& worker = *workers[index_];
+        std::scoped_lock< std::mutex > lock(worker.jobsMutex);
+        if (!worker.jobs.empty()) {
+
+            job = std::move(worker.jobs.back());        // LIFO on the own deque keeps recently spawned work cache-warm
+            worker.jobs.pop_back();
+
+        }
+
+    }
+
+    if (!job) {
+
+        std::scoped_lock< std::mutex > lock(injectedMutex);
+        if (!injected.empty()) {
+
+            job = std::move(injected.front());
+            injected.pop_front();
+
+        }
+
+    }
+
+    for (size_t i = 1; !job && i <= workers.size(); i++) {
+
+        size_t victimIndex = (static_cast< size_t >(index_ + 1) + i) % workers.size();
+        if (static_cast< int >(victimIndex) == index_) continue;
+
+        Worker& victim = *workers[victimIndex];
+        std::scoped_lock< std::mutex > lock(victim.jobsMutex);
+        if (!victim.jobs.empty()) {
+
+            job = std::move(victim.jobs.front());       // Steal the oldest job, usually the largest remaining chunk of work
+            victim.jobs.pop_front();
+
+            if (index_ >= 0) {
+
+                workers[index_]->stolen++;
+
+            }
+
+        }
+
+    }
+
+    if (job) {
+
+        queued--;
+
+    }
+
+    return job;
+
+}
+
+void JobSystem::execute(const JobHandle& job_, int index_) {
+
+    auto begin = std::chrono::steady_clock::now();
+
+    try {
+
+        job_->task();
+
+    }
+    catch (...) {
+
+        job_->exception = std::current_exception();
+
+    }
+
+    if (index_ >= 0) {
+
+        workers[index_]->busyNanoseconds += static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now() - begin).count());
+        workers[index_]->executed++;
+
+    }
+
+    std::vector< JobHandle > continuations;
+    {
+
+        std::scoped_lock< std::mutex > lock(job_->continuationMutex);
+        job_->done = true;
+        continuations.swap(job_->continuations);
+
+    }
+
+    for (const auto& continuation : continuations) {
+
+        if (--continuation->unfinished == 0) {
+
+            schedule(continuation);
+
+        }
+
+    }
+
+}
+
+void JobSystem::work(uint32_t index_) {
+
+    currentWorker = static_cast< int >(index_);
+
+    while (true) {
+
+        JobHandle job = next(currentWorker);
+
+        if (job) {
+
+            execute(job, currentWorker);
+            continue;
+
+        }
+
+        if (stop) {
+
+            break;
+
+        }
+
+        std::unique_lock< std::mutex > lock(sleepMutex);
+        sleepCondVar.wait(lock, [this]() { return queued > 0 || stop; });
+
+    }
+
+}
+
+void JobSystem::wait(const JobHandle& job_) {
+
+    bool onMainThread = std::this_thread::get_id() == mainThread;
+
+    while (!job_->done) {
+
+        if (onMainThread) {
+
+            runMainThreadJobs();
+
+        }
+
+        JobHandle job = next(currentWorker);        // Help instead of blocking, nested waits on workers can never starve the pool
+
+        if (job) {
+
+            execute(job, currentWorker);
+
+        }
+        else {
+
+            std::this_thread::yield();
+
+        }
+
+    }
+
+    if (job_->exception) {
+
+        std::rethrow_exception(job_->exception);
+
+    }
+
+}
+
+void JobSystem::wait(const std::vector< JobHandle >& jobs_) {
+
+    for (const auto& job : jobs_) {
+
+        try {
+
+            wait(job);
+
+        }
+        catch (...) {}
+
+    }
+
+    for (const auto& job : jobs_) {
+
+        if (job->exception) {
+
+            std::rethrow_exception(job->exception);
+
+        }
+
+    }
+
+}
+
+void JobSystem::runMainThreadJobs() {
+
+    std::unique_lock< std::mutex > lock(mainThreadMutex);
+    std::deque< JobHandle > ready;
+    ready.swap(mainThreadJobs);
+    lock.unlock();
+
+    for (const auto& job : ready) {
+
+        execute(job, -1);
+
+    }
+
+}
+
+std::vector< JobWorkerStats > JobSystem::stats() {
+
+    double lifetime = static_cast< double >(std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now() - startTime).count());
+
+    std::vector< JobWorkerStats > result;
+    for (uint32_t i = 0; i < workers.size(); i++) {
+
+        JobWorkerStats workerStats      = {};
+        workerStats.worker              = i;
+        workerStats.executed            = workers[i]->executed;
+        workerStats.stolen              = workers[i]->stolen;
+        workerStats.utilization         = lifetime > 0.0 ? workers[i]->busyNanoseconds / lifetime : 0.0;
+
+        result.push_back(workerStats);
+
+    }
+
+    return result;
+
+}
+
+void JobSystem::logStats() {
+
+    for (const auto& workerStats : stats()) {
+
+        logger::log(EVENT_LOG, "Job worker " + std::to_string(workerStats.worker) + ": "
+            + std::to_string(workerStats.executed) + " jobs, "
+            + std::to_string(workerStats.stolen) + " stolen, "
+            + std::to_string(workerStats.utilization * 100.0) + "% utilization"
+            );
+
+    }
+
+}
+
+JobSystem::~JobSystem() {
+
+    bool onMainThread = std::this_thread::get_id() == mainThread;
+
+    stop = true;
+    { std::scoped_lock< std::mutex > lock(sleepMutex); }
+    sleepCondVar.notify_all();
+
+    for (auto& worker : workers) {
+
+        worker->thread.join();
+
+    }
+
+    while (onMainThread) {      // Worker jobs may have queued main-thread jobs right up to the join, and those may queue more
+
+        runMainThreadJobs();
+
+        JobHandle job = next(currentWorker);        // The workers are gone, whatever the main-thread jobs spawned runs here
+
+        if (job) {
+
+            execute(job, currentWorker);
+            continue;
+
+        }
+
+        std::scoped_lock< std::mutex > lock(mainThreadMutex);
+        if (mainThreadJobs.empty()) break;
+
+    }
+
+}
@@ -0,0 +1,243 @@
+/**
+    Declares the JobSystem class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         JobSystem.hpp
+    @brief        Declaration of the JobSystem class, the engine-wide work-stealing scheduler
+*/
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "JOB_AFFINITY.cpp"
+#include "JobWorkerStats.cpp"
+
+/**
+    A unit of work, runs once all of its dependencies have finished
+*/
+struct Job {
+
+    std::function< void() >                     task;
+    JOB_AFFINITY                                affinity;
+    std::atomic< uint32_t >                     unfinished;         // Unfinished dependencies, plus one while the job is being submitted
+    std::atomic< bool >                         done;
+    std::exception_ptr                          exception;
+    std::mutex                                  continuationMutex;
+    std::vector< std::shared_ptr< Job > >       continuations;
+
+};
+
+typedef std::shared_ptr< Job > JobHandle;
+
+class JobSystem
+{
+public:
+
+    /**
+        Constructor, starts the workers, has to be called on the main thread
+
+        @param      workerCount_        The number of worker threads
+    */
+    explicit JobSystem(uint32_t workerCount_);
+
+    /**
+        Submits a job
+
+        @param      task_               The callable to execute
+        @param      dependencies_       Jobs that have to finish before this one may start
+        @param      affinity_           Whether the job may run on any worker or only on the main thread
+
+        @return     Returns a handle to wait on or to depend on
+    */
+    JobHandle submit(
+        std::function< void() >             task_,
+        const std::vector< JobHandle >&     dependencies_       = {},
+        JOB_AFFINITY                        affinity_           = JA_ANY
+        );
+
+    /**
+        Splits [0, count_) into contiguous bands, the calling thread and helper jobs claim bands until none are left,
+        then the calling thread waits for the bands claimed by others without running unrelated jobs, a caller that holds
+        something other jobs block on (e.g. a texture that is being decoded) can therefore never end up waiting on itself
+
+        @param      count_          The number of items
+        @param      parallel_       Whether to split the work at all
+        @param      func_           Callable taking the first and one-past-last item of a band
+    */
+    template< typename Function >
+    void parallelFor(uint32_t count_, bool parallel_, Function func_) {
+
+        uint32_t bands = parallel_ ? std::min(static_cast< uint32_t >(workers.size()) + 1, count_) : 1;
+
+        if (bands <= 1) {
+
+            func_(0, count_);
+            return;
+
+        }
+
+        uint32_t bandSize = (count_ + bands - 1) / bands;
+        bands             = (count_ + bandSize - 1) / bandSize;
+
+        std::shared_ptr< Bands > state = std::make_shared< Bands >();       // Helper jobs that start late still touch it after the call returned
+        auto claim = [state, func_, count_, bands, bandSize]() {
+
+            for (uint32_t band = state->next++; band < bands; band = state->next++) {
+
+                try {
+
+                    func_(band * bandSize, std::min(band * bandSize + bandSize, count_));
+
+                }
+                catch (...) {
+
+                    std::scoped_lock< std::mutex > lock(state->exceptionMutex);
+                    if (!state->exception) state->exception = std::current_exception();
+
+                }
+
+                state->finished++;
+
+            }
+
+        };
+
+        for (uint32_t i = 1; i < bands; i++) {
+
+            submit(claim);
+
+        }
+
+        claim();
+
+        while (state->finished < bands) {
+
+            std::this_thread::yield();
+
+        }
+
+        if (state->exception) {
+
+            std::rethrow_exception(state->exception);
+
+        }
+
+    }
+
+    /**
+        Waits for a job, running other jobs on the calling thread in the meantime, and rethrows the job's exception
+
+        @param      job_        The job to wait for
+    */
+    void wait(const JobHandle& job_);
+
+    /**
+        Waits for several jobs, rethrows the first exception once all of them have finished
+
+        @param      jobs_       The jobs to wait for
+    */
+    void wait(const std::vector< JobHandle >& jobs_);
+
+    /**
+        Runs every job with main-thread affinity that is ready, has to be called regularly by the main thread
+    */
+    void runMainThreadJobs(void);
+
+    /**
+        Returns per-worker statistics
+
+        @return     Returns one JobWorkerStats per worker
+    */
+    std::vector< JobWorkerStats > stats(void);
+
+    /**
+        Writes per-worker statistics to the event log
+    */
+    void logStats(void);
+
+    /**
+        Default destructor, runs all queued jobs and joins the workers, queued main-thread jobs are only run if it is
+        called on the main thread
+    */
+    ~JobSystem(void);
+
+private:
+
+    /**
+        A worker thread and the deque it owns, other workers steal from its front
+    */
+    struct Worker {
+
+        std::deque< JobHandle >                 jobs;
+        std::mutex                              jobsMutex;
+        std::thread                             thread;
+        std::atomic< uint64_t >                 busyNanoseconds     = { 0 };
+        std::atomic< uint64_t >                 executed            = { 0 };
+        std::atomic< uint64_t >                 stolen              = { 0 };
+
+    };
+
+    /**
+        The bands of one parallelFor call
+    */
+    struct Bands {
+
+        std::atomic< uint32_t >                 next                = { 0 };
+        std::atomic< uint32_t >                 finished            = { 0 };
+        std::mutex                              exceptionMutex;
+        std::exception_ptr                      exception;
+
+    };
+
+    std::vector< std::unique_ptr< Worker > >    workers;
+    std::deque< JobHandle >                     injected;               // Jobs submitted from threads that do not own a deque
+    std::mutex                                  injectedMutex;
+    std::deque< JobHandle >                     mainThreadJobs;
+    std::mutex                                  mainThreadMutex;
+    std::mutex                                  sleepMutex;
+    std::condition_variable                     sleepCondVar;
+    std::atomic< uint32_t >                     queued                  = { 0 };
+    std::atomic< bool >                         stop                    = { false };
+    std::thread::id                             mainThread;
+    std::chrono::steady_clock::time_point       startTime;
+
+    /**
+        The loop every worker thread runs
+
+        @param      index_      The index of the worker
+    */
+    void work(uint32_t index_);
+
+    /**
+        Queues a job whose dependencies have all finished
+    */
+    void schedule(const JobHandle& job_);
+
+    /**
+        Takes the next job for a thread: its own deque first, then injected jobs, then other workers' deques
+
+        @param      index_      The index of the calling worker, -1 for other threads
+
+        @return     Returns a job or nullptr if there is none
+    */
+    JobHandle next(int index_);
+
+    /**
+        Runs a job and schedules the continuations that became ready
+    */
+    void execute(const JobHandle& job_, int index_);
+
+};
+#endif  // JOB_SYSTEM_HPP
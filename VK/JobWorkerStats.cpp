@@ -0,0 +1,25 @@
+/**
+    Defines the JobWorkerStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         JobWorkerStats.cpp
+    @brief        Definition of the JobWorkerStats struct
+*/
+#ifndef JOB_WORKER_STATS_CPP
+#define JOB_WORKER_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the statistics of a single job system worker
+*/
+struct JobWorkerStats {
+
+    uint32_t            worker;
+    uint64_t            executed;           // Jobs run by this worker
+    uint64_t            stolen;             // Jobs this worker took from another worker's deque
+    double              utilization;        // Fraction of the worker's lifetime spent running jobs
+
+};
+#endif  // JOB_WORKER_STATS_CPP
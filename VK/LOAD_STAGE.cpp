@@ -0,0 +1,28 @@
+/**
+    Defines the LOAD_STAGE enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LOAD_STAGE.cpp
+    @brief        Definition of the LOAD_STAGE enumeration
+*/
+#ifndef LOAD_STAGE_CPP
+#define LOAD_STAGE_CPP
+
+/**
+ * Enumeration to differenciate between the stages an asynchronous model load passes through, in order
+ */
+typedef enum LOAD_STAGE {
+
+    LS_QUEUED           = 0,
+    LS_PARSE            = 1,
+    LS_PROCESS          = 2,
+    LS_DECODE           = 3,
+    LS_UPLOAD           = 4,
+    LS_DONE             = 5,
+    LS_CANCELLED        = 6,
+    LS_FAILED           = 7
+
+} LOAD_STAGE;
+#endif  // LOAD_STAGE_CPP
@@ -0,0 +1,31 @@
+/**
+    Implements the LOG_CATEGORY enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LOG_CATEGORY.cpp
+    @brief        Implementation of the LOG_CATEGORY enumeration
+*/
+#ifndef LOG_CATEGORY_CPP
+#define LOG_CATEGORY_CPP
+#include <cstdint>
+
+/**
+    Enumeration to differenciate between the subsystems structured log messages come from, each has its own runtime
+    level
+*/
+typedef enum LOG_CATEGORY : uint8_t {
+
+    LC_CORE,
+    LC_RENDER,
+    LC_MEMORY,
+    LC_IO,
+    LC_ASSETS,
+    LC_JOBS,
+    LC_COUNT
+
+} LOG_CATEGORY;
+
+static const char* const LOG_CATEGORY_NAMES[] = { "core", "render", "memory", "io", "assets", "jobs" };
+#endif  // LOG_CATEGORY_CPP
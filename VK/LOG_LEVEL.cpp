@@ -0,0 +1,29 @@
+/**
+    Implements the LOG_LEVEL enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LOG_LEVEL.cpp
+    @brief        Implementation of the LOG_LEVEL enumeration
+*/
+#ifndef LOG_LEVEL_CPP
+#define LOG_LEVEL_CPP
+#include <cstdint>
+
+/**
+    Enumeration to differenciate between the severities of structured log messages, the values match VK_LOG_LEVEL
+*/
+typedef enum LOG_LEVEL : uint8_t {
+
+    LL_TRACE        = 0,
+    LL_DEBUG        = 1,
+    LL_INFO         = 2,
+    LL_WARNING      = 3,
+    LL_ERROR        = 4,
+    LL_OFF          = 5
+
+} LOG_LEVEL;
+
+static const char* const LOG_LEVEL_NAMES[] = { "trace", "debug", "info", "warning", "error", "off" };
+#endif  // LOG_LEVEL_CPP
@@ -10,11 +10,12 @@
 */
 #ifndef LOG_TYPE_CPP
 #define LOG_TYPE_CPP
+#include <cstdint>
 
 /**
  * Enumeration to differenciate between the different types of .log-files and streams
  */
-typedef enum LOG_TYPE {
+typedef enum LOG_TYPE : uint8_t {
 
     ERROR_LOG,
     START_LOG,
@@ -0,0 +1,178 @@
+/**
+    Implements the lz4 namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LZ4.cpp
+    @brief        Implementation of the lz4 namespace, an LZ4 block format codec
+*/
+#include "LZ4.hpp"
+
+#include <cstring>
+
+namespace {
+
+    const size_t            MIN_MATCH               = 4;
+    const size_t            LAST_LITERALS           = 5;            // The last 5 bytes of a block are always literals
+    const size_t            MATCH_FIND_LIMIT        = 12;           // The last match has to start at least 12 bytes before the end
+    const size_t            MAX_OFFSET              = 65535;
+    const uint32_t          HASH_BITS               = 12;
+
+    uint32_t read32(const uint8_t* src_) {
+
+        uint32_t value;
+        std::memcpy(&value, src_, sizeof(value));
+
+        return value;
+
+    }
+
+    uint32_t hash(uint32_t sequence_) {
+
+        return (sequence_ * 2654435761u) >> (32 - HASH_BITS);
+
+    }
+
+    /**
+        Writes the 255-continued extension of a length field that did not fit into its 4-bit token nibble
+    */
+    void writeLength(size_t length_, std::vector< uint8_t >& dst_) {
+
+        for (; length_ >= 255; length_ -= 255) {
+
+            dst_.push_back(255);
+
+        }
+        dst_.push_back(static_cast< uint8_t >(length_));
+
+    }
+
+    /**
+        Reads the extension of a length field
+
+        @return     Returns false if the block ends in the middle of the field
+    */
+    bool readLength(const uint8_t*& ip_, const uint8_t* end_, size_t& length_) {
+
+        uint8_t byte;
+        do {
+
+            if (ip_ >= end_) return false;
+            byte = *ip_++;
+            length_ += byte;
+
+        } while (byte == 255);
+
+        return true;
+
+    }
+
+    void writeSequence(const uint8_t* literals_, size_t literalCount_, size_t offset_, size_t matchLength_, std::vector< uint8_t >& dst_) {
+
+        size_t matchCode = matchLength_ >= MIN_MATCH ? matchLength_ - MIN_MATCH : 0;
+        uint8_t token = static_cast< uint8_t >((literalCount_ >= 15 ? 15 : literalCount_) << 4);
+        if (matchLength_ > 0) token |= static_cast< uint8_t >(matchCode >= 15 ? 15 : matchCode);
+
+        dst_.push_back(token);
+        if (literalCount_ >= 15) writeLength(literalCount_ - 15, dst_);
+        dst_.insert(dst_.end(), literals_, literals_ + literalCount_);
+
+        if (matchLength_ == 0) return;       // The last sequence carries literals only
+
+        dst_.push_back(static_cast< uint8_t >(offset_ & 0xFF));
+        dst_.push_back(static_cast< uint8_t >(offset_ >> 8));
+        if (matchCode >= 15) writeLength(matchCode - 15, dst_);
+
+    }
+
+}
+
+namespace lz4 {
+
+    void compress(const uint8_t* src_, size_t srcSize_, std::vector< uint8_t >& dst_) {
+
+        dst_.clear();
+        dst_.reserve(srcSize_ + srcSize_ / 255 + 16);
+
+        std::vector< uint32_t > table(1u << HASH_BITS, UINT32_MAX);
+        size_t anchor   = 0;
+        size_t i        = 0;
+
+        while (i + MATCH_FIND_LIMIT < srcSize_) {
+
+            uint32_t sequence   = read32(src_ + i);
+            uint32_t& slot      = table[hash(sequence)];
+            size_t candidate    = slot;
+            slot                = static_cast< uint32_t >(i);
+
+            if (candidate == UINT32_MAX || i - candidate > MAX_OFFSET || read32(src_ + candidate) != sequence) {
+
+                i++;
+                continue;
+
+            }
+
+            size_t length = MIN_MATCH;
+            while (i + length < srcSize_ - LAST_LITERALS && src_[candidate + length] == src_[i + length]) {
+
+                length++;
+
+            }
+
+            writeSequence(src_ + anchor, i - anchor, i - candidate, length, dst_);
+            i       += length;
+            anchor  = i;
+
+        }
+
+        writeSequence(src_ + anchor, srcSize_ - anchor, 0, 0, dst_);
+
+    }
+
+    bool decompress(const uint8_t* src_, size_t srcSize_, uint8_t* dst_, size_t dstSize_) {
+
+        const uint8_t* ip       = src_;
+        const uint8_t* srcEnd   = src_ + srcSize_;
+        uint8_t* op             = dst_;
+        uint8_t* dstEnd         = dst_ + dstSize_;
+
+        while (ip < srcEnd) {
+
+            uint8_t token = *ip++;
+
+            size_t literalCount = token >> 4;
+            if (literalCount == 15 && !readLength(ip, srcEnd, literalCount)) return false;
+            if (literalCount > static_cast< size_t >(srcEnd - ip) || literalCount > static_cast< size_t >(dstEnd - op)) return false;
+
+            if (literalCount > 0) std::memcpy(op, ip, literalCount);
+            ip += literalCount;
+            op += literalCount;
+
+            if (ip == srcEnd) break;        // The last sequence has no match part
+
+            if (srcEnd - ip < 2) return false;
+            size_t offset = static_cast< size_t >(ip[0]) | (static_cast< size_t >(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast< size_t >(op - dst_)) return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !readLength(ip, srcEnd, matchLength)) return false;
+            matchLength += MIN_MATCH;
+            if (matchLength > static_cast< size_t >(dstEnd - op)) return false;
+
+            const uint8_t* match = op - offset;
+            for (size_t k = 0; k < matchLength; k++) {      // Byte by byte, matches may overlap their own output
+
+                op[k] = match[k];
+
+            }
+            op += matchLength;
+
+        }
+
+        return op == dstEnd;
+
+    }
+
+}
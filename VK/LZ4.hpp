@@ -0,0 +1,43 @@
+/**
+    Prototypes the lz4 namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LZ4.hpp
+    @brief        Prototype of the lz4 namespace, an LZ4 block format codec
+*/
+#ifndef LZ4_HPP
+#define LZ4_HPP
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+    Compresses and decompresses raw LZ4 blocks (no frame header), the format used by asset package entries
+*/
+namespace lz4 {
+
+    /**
+        Compresses a buffer into a single LZ4 block with a greedy single-probe matcher
+
+        @param      src_        The bytes to compress
+        @param      srcSize_    The number of bytes to compress
+        @param      dst_        Receives the compressed block, replacing its previous content
+    */
+    void compress(const uint8_t* src_, size_t srcSize_, std::vector< uint8_t >& dst_);
+
+    /**
+        Decompresses a single LZ4 block, every read and write is bounds checked
+
+        @param      src_        The compressed block
+        @param      srcSize_    The size of the compressed block in bytes
+        @param      dst_        The output buffer
+        @param      dstSize_    The exact decompressed size
+
+        @return     Returns false if the block is malformed or does not decompress to exactly dstSize_ bytes
+    */
+    bool decompress(const uint8_t* src_, size_t srcSize_, uint8_t* dst_, size_t dstSize_);
+
+}
+#endif  // LZ4_HPP
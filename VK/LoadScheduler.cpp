@@ -0,0 +1,166 @@
+/**
+    Implements the LoadScheduler class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LoadScheduler.cpp
+    @brief        Implementation of the LoadScheduler class, a prioritized queue of asynchronous model loads
+*/
+#include "LoadScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "FileIO.hpp"
+#include "Metrics.hpp"
+
+namespace {
+
+    Gauge*          pendingMetric           = vk::metrics::gauge("assets_models_pending", "Model loads queued or running");
+    Counter*        loadedMetric            = vk::metrics::counter("assets_models_loaded_total", "Models loaded");
+    Counter*        failedMetric            = vk::metrics::counter("assets_models_failed_total", "Model loads that failed");
+    Histogram*      loadTimeMetric          = vk::metrics::histogram("assets_model_load_ms", "Time from dispatching a model load to its handoff in milliseconds");
+
+}
+
+namespace {
+
+    /**
+        Orders the heap so the request with the lowest priority value ends up at the front
+    */
+    bool laterThan(const std::shared_ptr< ModelLoadRequest >& a_, const std::shared_ptr< ModelLoadRequest >& b_) {
+
+        return a_->priority > b_->priority;
+
+    }
+
+}
+
+LoadScheduler::LoadScheduler(JobSystem* jobSystem_, ModelHandoff* handoff_, uint32_t maxInFlight_) {
+
+    jobSystem   = jobSystem_;
+    handoff     = handoff_;
+    maxInFlight = std::max(maxInFlight_, 1u);
+
+}
+
+ModelHandle LoadScheduler::push(const ModelInfo& info_, float bias_) {
+
+    vk::io::prefetchModel(info_.path);      // The whole model is read ahead while the request waits for a load slot
+
+    auto request        = std::make_shared< ModelLoadRequest >(info_, bias_);
+
+    std::scoped_lock< Mutex > lock(queueMutex);
+    request->priority   = glm::distance(request->position, viewer) - request->bias;
+    queue.push_back(request);
+    std::push_heap(queue.begin(), queue.end(), laterThan);
+    dispatch();
+
+    return ModelHandle(request);
+
+}
+
+void LoadScheduler::reprioritize(const glm::vec3& viewer_) {
+
+    std::scoped_lock< Mutex > lock(queueMutex);
+    viewer = viewer_;       // Also used for loads pushed later on
+
+    if (queue.empty()) return;
+
+    queue.erase(std::remove_if(queue.begin(), queue.end(), [](const std::shared_ptr< ModelLoadRequest >& request_) {
+
+        return request_->progress.stage == LS_CANCELLED;
+
+    }), queue.end());
+
+    for (auto& request : queue) {
+
+        request->priority = glm::distance(request->position, viewer) - request->bias;
+
+    }
+    std::make_heap(queue.begin(), queue.end(), laterThan);
+
+}
+
+void LoadScheduler::cancelAll() {
+
+    std::scoped_lock< Mutex > lock(queueMutex);
+    for (auto& request : queue) {
+
+        ModelHandle(request).cancel();
+
+    }
+    queue.clear();
+    pendingMetric->set(static_cast< int64_t >(inFlight));
+
+}
+
+size_t LoadScheduler::outstanding() {
+
+    std::scoped_lock< Mutex > lock(queueMutex);
+
+    return queue.size() + inFlight;
+
+}
+
+void LoadScheduler::dispatch() {
+
+    while (inFlight < maxInFlight && !queue.empty()) {
+
+        std::pop_heap(queue.begin(), queue.end(), laterThan);
+        std::shared_ptr< ModelLoadRequest > request = std::move(queue.back());
+        queue.pop_back();
+
+        if (request->progress.stage == LS_CANCELLED) continue;
+
+        inFlight++;
+        jobSystem->submit([this, request]() { run(request); });
+
+    }
+
+    pendingMetric->set(static_cast< int64_t >(queue.size() + inFlight));
+
+}
+
+void LoadScheduler::run(std::shared_ptr< ModelLoadRequest > request_) {
+
+    LOAD_STAGE expected = LS_QUEUED;
+    if (request_->progress.stage.compare_exchange_strong(expected, LS_PARSE)) {     // Loses against a cancel that came in after dispatch
+
+        auto begin = std::chrono::steady_clock::now();
+
+        try {
+
+            Model* model = new Model(
+                request_->info.path,
+                request_->info.pipeline,
+                request_->info.lib,
+                request_->info.modelMatrixFunc,
+                &request_->progress,
+                request_->info.transform
+                );
+
+            request_->progress.stage = LS_DONE;
+            handoff->publish(model);
+            request_->promise.set_value(model);
+
+            loadedMetric->add();
+            loadTimeMetric->observe(static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::milliseconds >(std::chrono::steady_clock::now() - begin).count()));
+
+        }
+        catch (...) {
+
+            request_->progress.stage = LS_FAILED;
+            request_->promise.set_exception(std::current_exception());
+            failedMetric->add();
+
+        }
+
+    }
+
+    std::scoped_lock< Mutex > lock(queueMutex);
+    inFlight--;
+    dispatch();
+
+}
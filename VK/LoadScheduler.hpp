@@ -0,0 +1,91 @@
+/**
+    Declares the LoadScheduler class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LoadScheduler.hpp
+    @brief        Declaration of the LoadScheduler class, a prioritized queue of asynchronous model loads
+*/
+#ifndef LOAD_SCHEDULER_HPP
+#define LOAD_SCHEDULER_HPP
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ModelHandle.hpp"
+#include "JobSystem.hpp"
+#include "ModelHandoff.hpp"
+#include "Mutex.hpp"
+
+/**
+    Keeps a bounded number of model loads running on the job system, nearest to the viewer first
+*/
+class LoadScheduler
+{
+public:
+
+    /**
+        Constructor
+
+        @param      jobSystem_          The job system to run the loads on
+        @param      handoff_            Where finished models are published for the render loop
+        @param      maxInFlight_        The number of loads that may run at the same time
+    */
+    LoadScheduler(JobSystem* jobSystem_, ModelHandoff* handoff_, uint32_t maxInFlight_);
+
+    /**
+        Queues a model for loading
+
+        @param      info_       The model to load
+        @param      bias_       Subtracted from the distance to the viewer, larger values load earlier
+
+        @return     Returns a handle to poll, wait on or cancel
+    */
+    ModelHandle push(const ModelInfo& info_, float bias_ = 0.0f);
+
+    /**
+        Recomputes the priority of every queued load for a new viewer position, drops cancelled loads
+
+        @param      viewer_     The world-space position of the viewer
+    */
+    void reprioritize(const glm::vec3& viewer_);
+
+    /**
+        Cancels every load that has not started yet
+    */
+    void cancelAll(void);
+
+    /**
+        Returns the number of loads that are queued or running
+
+        @return     Returns the number of outstanding loads
+    */
+    size_t outstanding(void);
+
+private:
+
+    JobSystem*                                              jobSystem;
+    ModelHandoff*                                           handoff;
+    uint32_t                                                maxInFlight;
+    uint32_t                                                inFlight            = 0;
+    glm::vec3                                               viewer              = glm::vec3(0.0f);
+    std::vector< std::shared_ptr< ModelLoadRequest > >      queue;                  // Binary heap, the nearest load is at the front
+    Mutex                                                   queueMutex{ "load_scheduler" };
+
+    /**
+        Starts queued loads until maxInFlight are running, queueMutex has to be held
+    */
+    void dispatch(void);
+
+    /**
+        Loads a model on a worker and starts the next load once it is done
+
+        @param      request_        The load to run
+    */
+    void run(std::shared_ptr< ModelLoadRequest > request_);
+
+};
+#endif  // LOAD_SCHEDULER_HPP
@@ -9,41 +9,53 @@
 */
 #include "LoadingScreen.hpp"
 #include "VK.hpp"
+#include "FileIO.hpp"
 
-SDL_STATUS_CODE LoadingScreen::loop() {
+bool LoadingScreen::tick() {
 
+    if (closed) {
 
-    SDL_Event e;
+        return false;
 
-    while (!close) {
+    }
 
-        while (SDL_PollEvent(&e)) {
+    SDL_Event e;
 
-            if (e.type == SDL_QUIT) {
+    while (SDL_PollEvent(&e)) {
 
-                closeMutex.lock();
-                close = true;
-                closeMutex.unlock();
+        if (e.type == SDL_QUIT) {
 
-            }
+            closeMutex.lock();
+            close = true;
+            closeMutex.unlock();
 
         }
 
-        SDL_RenderCopy(
-            renderer,
-            background,
-            NULL,
-            NULL
-            );
+    }
+
+    std::unique_lock< std::mutex > lock(closeMutex);
+    if (close) {
+
+        lock.unlock();
+        clean();
+        closed = true;
+        logger::log(EVENT_LOG, "Stopped loading screen");
 
-        SDL_RenderPresent(renderer);
+        return false;
 
     }
+    lock.unlock();
 
-    clean();
-    logger::log(EVENT_LOG, "Stopping loading screen thread...");
+    SDL_RenderCopy(
+        renderer,
+        background,
+        NULL,
+        NULL
+        );
 
-    return SDL_SC_SUCCESS;
+    SDL_RenderPresent(renderer);
+
+    return true;
 
 }
 
@@ -82,7 +94,8 @@ LoadingScreen::LoadingScreen() {
 
     }
 
-    imageSurface = IMG_Load("res/textures/loading_screen/infinity.jpg");
+    std::shared_ptr< FileData > image = vk::io::read("res/textures/loading_screen/infinity.jpg");
+    imageSurface = image ? IMG_Load_RW(SDL_RWFromConstMem(image->data(), static_cast< int >(image->size())), 1) : nullptr;
     if (imageSurface == NULL) {
 
         std::string error = SDL_GetError();
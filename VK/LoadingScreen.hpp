@@ -28,11 +28,11 @@ public:
     std::mutex        closeMutex;
 
     /**
-        Contains the main loop for the loading screen window
+        Renders a single frame of the loading screen, cleans up once the screen has been closed
 
-        @return        Returns SDL_SC_SUCCESS on success
+        @return        Returns true as long as the loading screen is open
     */
-    SDL_STATUS_CODE loop(void);
+    bool tick(void);
 
     /**
         Default Constructor
@@ -45,6 +45,7 @@ private:
     SDL_Surface*           imageSurface        = nullptr;
     SDL_Texture*           background          = nullptr;
     SDL_Renderer*          renderer            = nullptr;
+    bool                   closed              = false;
 
     /**
         Cleans allocated resources and terminates SDL2
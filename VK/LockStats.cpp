@@ -0,0 +1,29 @@
+/**
+    Defines the LockStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LockStats.cpp
+    @brief        Definition of the LockStats struct
+*/
+#ifndef LOCK_STATS_CPP
+#define LOCK_STATS_CPP
+#include <cstdint>
+#include <string>
+
+/**
+    Holds the contention statistics of one named lock, summed over every Mutex with that name
+*/
+struct LockStats {
+
+    std::string         name;
+    uint64_t            acquisitions;
+    uint64_t            contended;                  // Acquisitions that found the lock held and had to wait
+    uint64_t            waitNanoseconds;            // Time spent waiting to acquire the lock
+    uint64_t            maxWaitNanoseconds;
+    uint64_t            holdNanoseconds;            // Time the lock was held
+    uint64_t            maxHoldNanoseconds;
+
+};
+#endif  // LOCK_STATS_CPP
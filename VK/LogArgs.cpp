@@ -0,0 +1,112 @@
+/**
+    Implements the logger::args namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LogArgs.cpp
+    @brief        Implementation of the logger::args namespace, renders packed structured log arguments
+*/
+#include "LogArgs.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+
+namespace logger {
+
+    namespace args {
+
+        /**
+            Renders the next packed argument
+
+            @return     Returns false if there is none or it is cut off
+        */
+        static bool renderOne(const char*& cursor_, const char* end_, std::string& out_) {
+
+            if (cursor_ >= end_) return false;
+
+            LOG_ARGUMENT tag    = static_cast< LOG_ARGUMENT >(*cursor_++);
+            size_t remaining    = static_cast< size_t >(end_ - cursor_);
+            char text[32];
+
+            switch (tag) {
+            case LA_INT: {
+
+                if (remaining < sizeof(int64_t)) return false;
+                int64_t value;
+                std::memcpy(&value, cursor_, sizeof(value));
+                cursor_ += sizeof(value);
+                std::snprintf(text, sizeof(text), "%" PRId64, value);
+                out_ += text;
+                return true;
+
+            }
+            case LA_UINT: {
+
+                if (remaining < sizeof(uint64_t)) return false;
+                uint64_t value;
+                std::memcpy(&value, cursor_, sizeof(value));
+                cursor_ += sizeof(value);
+                std::snprintf(text, sizeof(text), "%" PRIu64, value);
+                out_ += text;
+                return true;
+
+            }
+            case LA_DOUBLE: {
+
+                if (remaining < sizeof(double)) return false;
+                double value;
+                std::memcpy(&value, cursor_, sizeof(value));
+                cursor_ += sizeof(value);
+                std::snprintf(text, sizeof(text), "%g", value);
+                out_ += text;
+                return true;
+
+            }
+            case LA_STRING: {
+
+                if (remaining < sizeof(uint16_t)) return false;
+                uint16_t length;
+                std::memcpy(&length, cursor_, sizeof(length));
+                cursor_ += sizeof(length);
+                if (remaining - sizeof(length) < length) return false;
+                out_.append(cursor_, length);
+                cursor_ += length;
+                return true;
+
+            }
+            default:
+                return false;
+
+            }
+
+        }
+
+        void render(const char* format_, const char* payload_, size_t length_, std::string& out_) {
+
+            const char* cursor  = payload_;
+            const char* end     = payload_ + length_;
+            bool valid          = true;
+
+            for (const char* c = format_; *c != '\0'; c++) {
+
+                if (c[0] == '{' && c[1] == '}') {
+
+                    valid = valid && renderOne(cursor, end, out_);
+                    if (!valid) out_ += "{?}";
+                    c++;
+
+                }
+                else {
+
+                    out_ += *c;
+
+                }
+
+            }
+
+        }
+
+    }
+
+}
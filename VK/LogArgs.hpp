@@ -0,0 +1,150 @@
+/**
+    Prototypes the logger::args namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LogArgs.hpp
+    @brief        Prototype of the logger::args namespace, packs structured log arguments into raw bytes and renders them
+*/
+#ifndef LOG_ARGS_HPP
+#define LOG_ARGS_HPP
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "LogFormat.cpp"
+
+namespace logger {
+
+    /**
+        Packs the arguments of structured log messages as a tag byte followed by the raw value, so producers never
+        format and the same bytes can be rendered in process or written to a binary log and rendered offline
+    */
+    namespace args {
+
+        /**
+            Appends a tag and a value if both fit, otherwise leaves the cursor at the end so later arguments are skipped
+        */
+        inline void put(char*& cursor_, char* end_, LOG_ARGUMENT tag_, const void* value_, size_t size_) {
+
+            if (static_cast< size_t >(end_ - cursor_) < size_ + 1) {
+
+                cursor_ = end_;
+                return;
+
+            }
+
+            *cursor_++ = static_cast< char >(tag_);
+            std::memcpy(cursor_, value_, size_);
+            cursor_ += size_;
+
+        }
+
+        /**
+            Appends a string argument, truncated to what fits
+        */
+        inline void putString(char*& cursor_, char* end_, const char* text_, size_t length_) {
+
+            if (static_cast< size_t >(end_ - cursor_) < 3) {
+
+                cursor_ = end_;
+                return;
+
+            }
+
+            uint16_t length = static_cast< uint16_t >(std::min< size_t >({ length_, static_cast< size_t >(end_ - cursor_) - 3, 0xFFFF }));
+            *cursor_++ = static_cast< char >(LA_STRING);
+            std::memcpy(cursor_, &length, sizeof(length));
+            std::memcpy(cursor_ + sizeof(length), text_, length);
+            cursor_ += sizeof(length) + length;
+
+        }
+
+        /**
+            Appends a single argument of any integral, enumeration, floating point, string or pointer type
+        */
+        template< typename T >
+        void encodeOne(char*& cursor_, char* end_, const T& value_) {
+
+            typedef typename std::decay< T >::type Type;
+
+            if constexpr (std::is_same< Type, std::string >::value) {
+
+                putString(cursor_, end_, value_.data(), value_.size());
+
+            }
+            else if constexpr (std::is_same< Type, const char* >::value || std::is_same< Type, char* >::value) {
+
+                putString(cursor_, end_, value_ != nullptr ? value_ : "(null)", value_ != nullptr ? std::strlen(value_) : 6);
+
+            }
+            else if constexpr (std::is_enum< Type >::value) {
+
+                int64_t value = static_cast< int64_t >(value_);
+                put(cursor_, end_, LA_INT, &value, sizeof(value));
+
+            }
+            else if constexpr (std::is_floating_point< Type >::value) {
+
+                double value = static_cast< double >(value_);
+                put(cursor_, end_, LA_DOUBLE, &value, sizeof(value));
+
+            }
+            else if constexpr (std::is_integral< Type >::value && std::is_signed< Type >::value) {
+
+                int64_t value = static_cast< int64_t >(value_);
+                put(cursor_, end_, LA_INT, &value, sizeof(value));
+
+            }
+            else if constexpr (std::is_integral< Type >::value) {
+
+                uint64_t value = static_cast< uint64_t >(value_);
+                put(cursor_, end_, LA_UINT, &value, sizeof(value));
+
+            }
+            else {
+
+                static_assert(std::is_pointer< Type >::value, "Unsupported structured log argument type");
+                uint64_t value = static_cast< uint64_t >(reinterpret_cast< uintptr_t >(value_));
+                put(cursor_, end_, LA_UINT, &value, sizeof(value));
+
+            }
+
+        }
+
+        /**
+            Packs all arguments into a buffer
+
+            @param      buffer_     The buffer to write to
+            @param      capacity_   The size of the buffer in bytes
+            @param      args_       The arguments
+
+            @return     Returns the number of bytes written
+        */
+        template< typename... Args >
+        size_t encode(char* buffer_, size_t capacity_, const Args&... args_) {
+
+            char* cursor    = buffer_;
+            (encodeOne(cursor, buffer_ + capacity_, args_), ...);
+
+            return static_cast< size_t >(cursor - buffer_);
+
+        }
+
+        /**
+            Renders a format string, replacing every {} with the next packed argument, missing arguments render as {?}
+
+            @param      format_     The format string
+            @param      payload_    The packed arguments
+            @param      length_     The size of the packed arguments in bytes
+            @param      out_        The string to append to
+        */
+        void render(const char* format_, const char* payload_, size_t length_, std::string& out_);
+
+    }
+
+}
+#endif  // LOG_ARGS_HPP
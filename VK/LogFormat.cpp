@@ -0,0 +1,80 @@
+/**
+    Defines the on-disk layout of binary logs
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LogFormat.cpp
+    @brief        Definition of the binary log header, records and argument tags
+*/
+#ifndef LOG_FORMAT_CPP
+#define LOG_FORMAT_CPP
+#include <cstdint>
+
+const uint32_t LOG_BINARY_MAGIC     = 0x474C4B56;       // "VKLG"
+const uint32_t LOG_BINARY_VERSION   = 1;
+
+/**
+    Enumeration to differenciate between the records of a binary log
+*/
+typedef enum LOG_BINARY_RECORD : uint8_t {
+
+    LBR_FORMAT      = 1,        // Followed by the file name and the format string
+    LBR_MESSAGE     = 2         // Followed by the encoded arguments
+
+} LOG_BINARY_RECORD;
+
+/**
+    Enumeration to differenciate between the types of encoded log arguments, each tag is followed by the raw value
+*/
+typedef enum LOG_ARGUMENT : uint8_t {
+
+    LA_INT          = 1,        // int64_t
+    LA_UINT         = 2,        // uint64_t
+    LA_DOUBLE       = 3,        // double
+    LA_STRING       = 4         // uint16_t length and the bytes
+
+} LOG_ARGUMENT;
+
+/**
+    Starts every binary log
+*/
+struct LogBinaryHeader {
+
+    uint32_t            magic;
+    uint32_t            version;
+
+};
+
+/**
+    Defines a format string, written once before the first message that uses it
+*/
+struct LogBinaryFormat {
+
+    uint8_t             kind;
+    uint8_t             level;
+    uint8_t             category;
+    uint8_t             reserved;
+    uint32_t            id;
+    uint32_t            line;
+    uint16_t            fileLength;
+    uint16_t            formatLength;
+
+};
+
+/**
+    A single message, the arguments to its format string follow
+*/
+struct LogBinaryMessage {
+
+    uint8_t             kind;
+    uint8_t             reserved;
+    uint16_t            payloadLength;
+    uint32_t            id;
+    int64_t             time;               // Nanoseconds since the epoch
+    uint64_t            thread;             // Hash of the thread id
+
+};
+
+static_assert(sizeof(LogBinaryFormat) == 16 && sizeof(LogBinaryMessage) == 24, "Binary log records must not be padded");
+#endif  // LOG_FORMAT_CPP
@@ -0,0 +1,37 @@
+/**
+    Defines the LogRecord struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LogRecord.cpp
+    @brief        Definition of the LogRecord struct
+*/
+#ifndef LOG_RECORD_CPP
+#define LOG_RECORD_CPP
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "LOG_TYPE.cpp"
+#include "LOG_LEVEL.cpp"
+#include "LOG_CATEGORY.cpp"
+
+const size_t LOG_RECORD_TEXT_SIZE = 224;        // Longer plain messages are written synchronously, longer argument lists are truncated, keeps a record at 4 cache lines
+
+/**
+    A single log message as a producer hands it to the flush thread, the header is formatted only when it is written
+*/
+struct LogRecord {
+
+    std::chrono::system_clock::time_point       time;
+    std::thread::id                             thread;
+    uint32_t                                    format;             // Id of a registered format string, 0 if text is plain
+    uint16_t                                    length;
+    LOG_TYPE                                    type;
+    LOG_LEVEL                                   level;
+    LOG_CATEGORY                                category;
+    char                                        text[LOG_RECORD_TEXT_SIZE];     // Plain text or the packed arguments of the format string
+
+};
+#endif  // LOG_RECORD_CPP
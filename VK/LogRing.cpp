@@ -0,0 +1,106 @@
+/**
+    Implements the LogRing class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LogRing.cpp
+    @brief        Implementation of the LogRing class, a bounded lock-free multi-producer single-consumer queue of log records
+*/
+#include "LogRing.hpp"
+
+#include <cstring>
+
+LogRing::LogRing(size_t capacity_) {
+
+    size_t capacity = 1;
+    while (capacity < capacity_) capacity <<= 1;
+
+    slots   = std::make_unique< Slot[] >(capacity);
+    mask    = capacity - 1;
+
+    for (size_t i = 0; i < capacity; i++) {
+
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    }
+
+}
+
+bool LogRing::push(const LogRecord& record_) {
+
+    uint64_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    while (true) {
+
+        slot = &slots[position & mask];
+        uint64_t sequence   = slot->sequence.load(std::memory_order_acquire);
+        int64_t difference  = static_cast< int64_t >(sequence) - static_cast< int64_t >(position);
+
+        if (difference == 0) {
+
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+
+        }
+        else if (difference < 0) {
+
+            return false;       // The consumer has not freed this slot yet, the ring is full
+
+        }
+        else {
+
+            position = enqueuePosition.load(std::memory_order_relaxed);     // Another producer claimed it first
+
+        }
+
+    }
+
+    slot->record.time       = record_.time;
+    slot->record.thread     = record_.thread;
+    slot->record.format     = record_.format;
+    slot->record.length     = record_.length;
+    slot->record.type       = record_.type;
+    slot->record.level      = record_.level;
+    slot->record.category   = record_.category;
+    std::memcpy(slot->record.text, record_.text, record_.length);
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+
+}
+
+bool LogRing::pop(LogRecord& record_) {
+
+    uint64_t position   = dequeuePosition.load(std::memory_order_relaxed);
+    Slot& slot          = slots[position & mask];
+
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) return false;
+
+    record_.time        = slot.record.time;
+    record_.thread      = slot.record.thread;
+    record_.format      = slot.record.format;
+    record_.length      = slot.record.length;
+    record_.type        = slot.record.type;
+    record_.level       = slot.record.level;
+    record_.category    = slot.record.category;
+    std::memcpy(record_.text, slot.record.text, slot.record.length);
+
+    slot.sequence.store(position + mask + 1, std::memory_order_release);
+    dequeuePosition.store(position + 1, std::memory_order_release);
+
+    return true;
+
+}
+
+uint64_t LogRing::pushed() const {
+
+    return enqueuePosition.load(std::memory_order_acquire);
+
+}
+
+uint64_t LogRing::popped() const {
+
+    return dequeuePosition.load(std::memory_order_acquire);
+
+}
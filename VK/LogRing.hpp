@@ -0,0 +1,83 @@
+/**
+    Declares the LogRing class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         LogRing.hpp
+    @brief        Declaration of the LogRing class, a bounded lock-free multi-producer single-consumer queue of log records
+*/
+#ifndef LOG_RING_HPP
+#define LOG_RING_HPP
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "LogRecord.cpp"
+
+/**
+    A bounded ring of log records. Any number of threads may push, exactly one thread may pop. Every slot carries a
+    sequence number that tells producers whether it is free and the consumer whether it has been published, so
+    neither side ever takes a lock or waits for the other.
+*/
+class LogRing {
+public:
+
+    /**
+        Constructor
+
+        @param      capacity_       The number of records the ring holds, rounded up to a power of two
+    */
+    explicit LogRing(size_t capacity_);
+
+    /**
+        Appends a record, never blocks
+
+        @param      record_     The record to append, only its first length bytes of text are copied
+
+        @return     Returns false if the ring is full and the record was dropped
+    */
+    bool push(const LogRecord& record_);
+
+    /**
+        Takes the oldest record, may only be called by the consumer thread
+
+        @param      record_     Receives the record
+
+        @return     Returns false if the ring is empty
+    */
+    bool pop(LogRecord& record_);
+
+    /**
+        Returns how many records have been pushed so far
+
+        @return     Returns the number of pushed records
+    */
+    uint64_t pushed(void) const;
+
+    /**
+        Returns how many records have been popped so far
+
+        @return     Returns the number of popped records
+    */
+    uint64_t popped(void) const;
+
+private:
+
+    /**
+        A record and the sequence number that publishes it
+    */
+    struct alignas(64) Slot {
+
+        std::atomic< uint64_t >                 sequence;
+        LogRecord                               record;
+
+    };
+
+    std::unique_ptr< Slot[] >                   slots;
+    size_t                                      mask;
+    alignas(64) std::atomic< uint64_t >         enqueuePosition     = { 0 };
+    alignas(64) std::atomic< uint64_t >         dequeuePosition     = { 0 };     // Only written by the consumer
+
+};
+#endif  // LOG_RING_HPP
@@ -11,8 +11,18 @@
 #include <time.h>
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
 
 #include "Logger.hpp"
+#include "LogRing.hpp"
+#include "Mutex.hpp"
 #if defined WIN_64 || defined WIN_32
     #include <direct.h>
     #include "ConsoleColor.hpp"
@@ -22,16 +32,267 @@
 
 namespace logger {
 
-    const char*              LOG_DIR               = "logs";
+    const char*                             LOG_DIR                 = "logs";
+
+    const std::string                       ERROR_LOG_PATH          = LOG_DIR + std::string("/error.log");
+    const std::string                       START_LOG_PATH          = LOG_DIR + std::string("/start.log");
+    const std::string                       EVENT_LOG_PATH          = LOG_DIR + std::string("/event.log");
+    const std::string                       BINARY_LOG_PATH         = LOG_DIR + std::string("/event.bin");
+    const size_t                            LOG_RING_CAPACITY       = 8192;                                 // Records in flight before producers start dropping
+    const std::chrono::milliseconds         LOG_FLUSH_INTERVAL      = std::chrono::milliseconds(10);
+    std::ofstream                           error;
+    std::ofstream                           start;
+    std::ofstream                           event;
+    std::ofstream                           binary;
+
+    Mutex                                   streamBusy("logger_streams");   // Held by whoever writes the streams, producers only take it for errors
+    LogRing                                 ring(LOG_RING_CAPACITY);
+    std::atomic< uint64_t >                 droppedRecords          = { 0 };
+    std::atomic< uint64_t >                 writtenRecords          = { 0 };
+    std::atomic< bool >                     running                 = { false };
+    std::thread                             flushThread;
+    std::mutex                              wakeMutex;
+    std::condition_variable                 wakeCondVar;
+    std::condition_variable                 flushedCondVar;
+
+    /**
+        A registered format string and where it is used
+    */
+    struct Format {
+
+        LOG_LEVEL                           level;
+        LOG_CATEGORY                        category;
+        const char*                         file;
+        uint32_t                            line;
+        const char*                         format;
+        bool                                written;        // Whether its definition is in the binary log yet
+
+    };
+
+    std::atomic< uint8_t >                  categoryLevels[LC_COUNT];       // Zero-initialized, VK_LOG_LEVEL applies until a category is configured
+    std::mutex                              formatMutex;
+    std::vector< Format >                   formats;                        // Indexed by id - 1
+    std::string                             rendered;                       // Scratch space of the flush thread
+
+    /**
+        Writes the header of a line, the time and the thread it was logged from
+    */
+    static void writeHeader(std::ostream& stream_, const struct tm& time_, std::thread::id thread_) {
+
+        stream_ << time_.tm_mday << ":"
+            << time_.tm_mon + 1 << ":"
+            << time_.tm_year + 1900 << "   "
+            << time_.tm_hour << ":"
+            << time_.tm_min << ":"
+            << time_.tm_sec << " in thread "
+            << thread_ << "        ===        ";
 
-    const std::string        ERROR_LOG_PATH        = LOG_DIR + std::string("/error.log");
-    const std::string        START_LOG_PATH        = LOG_DIR + std::string("/start.log");
-    const std::string        EVENT_LOG_PATH        = LOG_DIR + std::string("/event.log");
-    std::ofstream            error;
-    std::ofstream            start;
-    std::ofstream            event;
+    }
+
+    /**
+        Writes the header of a console line, in color on Windows
+    */
+    static void writeConsoleHeader(std::ostream& stream_, const struct tm& time_, std::thread::id thread_) {
+#if (defined VK_DEVELOPMENT || defined VK_RELEASE_CONSOLE) && (defined WIN_64 || defined WIN_32)
+        stream_ << green << time_.tm_mday << white << ":"
+            << green << time_.tm_mon + 1 << white << ":"
+            << green << time_.tm_year + 1900 << white << "   "
+            << green << time_.tm_hour << white << ":"
+            << green << time_.tm_min << white << ":"
+            << green << time_.tm_sec << yellow << " in thread "
+            << thread_ << white << "        ===        " << blue;
+#else
+        writeHeader(stream_, time_, thread_);
+#endif
+    }
+
+    /**
+        Writes a message to every stream its log type goes to, the caller has to hold streamBusy
+
+        @param      time_       When the message was logged
+        @param      thread_     The thread that logged it
+        @param      type_       The log type
+        @param      msg_        The text
+        @param      length_     The length of the text
+    */
+    static void writeText(
+        std::chrono::system_clock::time_point   time_,
+        std::thread::id                         thread_,
+        LOG_TYPE                                type_,
+        const char*                             msg_,
+        size_t                                  length_
+        ) {
+
+        static time_t       cachedSecond    = 0;       // Converting to local time is the expensive part, most lines share their second
+        static struct tm    localTime       = {};
+
+        time_t second = std::chrono::system_clock::to_time_t(time_);
+        if (second != cachedSecond) {
+
+            cachedSecond = second;
+#if defined WIN_64 || defined WIN_32
+            localtime_s(&localTime, &second);
+#elif defined LINUX
+            localtime_r(&second, &localTime);
+#endif
+
+        }
+
+        switch (type_) {
+        case ERROR_LOG:
+            writeHeader(error, localTime, thread_);
+            error << "CRITICAL: ";
+            error.write(msg_, length_) << '\n';
+
+            writeConsoleHeader(std::cerr, localTime, thread_);
+#if (defined VK_DEVELOPMENT || defined VK_RELEASE_CONSOLE) && (defined WIN_64 || defined WIN_32)
+            std::cerr << red << "CRITICAL: " << blue;
+            std::cerr.write(msg_, length_) << white << '\n';
+#else
+            std::cerr << "CRITICAL: ";
+            std::cerr.write(msg_, length_) << '\n';
+#endif
+
+        case START_LOG:
+            writeHeader(start, localTime, thread_);
+            start.write(msg_, length_) << '\n';
+
+        case EVENT_LOG:
+            writeHeader(event, localTime, thread_);
+            event.write(msg_, length_) << '\n';
+
+            writeConsoleHeader(std::cout, localTime, thread_);
+#if (defined VK_DEVELOPMENT || defined VK_RELEASE_CONSOLE) && (defined WIN_64 || defined WIN_32)
+            std::cout.write(msg_, length_) << white << '\n';
+#else
+            std::cout.write(msg_, length_) << '\n';
+#endif
+            break;
+
+        default:
+            break;
+
+        }
+
+    }
+
+    /**
+        Writes a record to the streams, structured records are rendered or, with VK_LOG_BINARY, written as they are.
+        The caller has to hold streamBusy.
+
+        @param      record_     The record to write
+    */
+    static void writeRecord(const LogRecord& record_) {
+
+        if (record_.format == 0) {
+
+            writeText(record_.time, record_.thread, record_.type, record_.text, record_.length);
+            return;
+
+        }
+
+        std::unique_lock< std::mutex > lock(formatMutex);
+        Format& format = formats[record_.format - 1];
+#ifdef VK_LOG_BINARY
+        if (!format.written) {
+
+            LogBinaryFormat definition  = {};
+            definition.kind             = LBR_FORMAT;
+            definition.level            = format.level;
+            definition.category         = format.category;
+            definition.id               = record_.format;
+            definition.line             = format.line;
+            definition.fileLength       = static_cast< uint16_t >(std::strlen(format.file));
+            definition.formatLength     = static_cast< uint16_t >(std::strlen(format.format));
+
+            binary.write(reinterpret_cast< const char* >(&definition), sizeof(definition));
+            binary.write(format.file, definition.fileLength);
+            binary.write(format.format, definition.formatLength);
+            format.written = true;
+
+        }
+        lock.unlock();
+
+        LogBinaryMessage message    = {};
+        message.kind                = LBR_MESSAGE;
+        message.payloadLength       = record_.length;
+        message.id                  = record_.format;
+        message.time                = std::chrono::duration_cast< std::chrono::nanoseconds >(record_.time.time_since_epoch()).count();
+        message.thread              = std::hash< std::thread::id >()(record_.thread);
 
-    std::mutex               streamBusy;
+        binary.write(reinterpret_cast< const char* >(&message), sizeof(message));
+        binary.write(record_.text, record_.length);
+#else
+        const char* text = format.format;
+        lock.unlock();
+
+        rendered.clear();
+        rendered += "[";
+        rendered += LOG_CATEGORY_NAMES[record_.category];
+        rendered += "] ";
+        if (record_.level >= LL_WARNING) {
+
+            rendered += LOG_LEVEL_NAMES[record_.level];
+            rendered += ": ";
+
+        }
+        args::render(text, record_.text, record_.length, rendered);
+
+        writeText(record_.time, record_.thread, record_.type, rendered.data(), rendered.size());
+#endif
+    }
+
+    /**
+        Flushes every stream, the caller has to hold streamBusy
+    */
+    static void flushStreams() {
+
+        error.flush();
+        start.flush();
+        event.flush();
+        binary.flush();
+        std::cout.flush();
+        std::cerr.flush();
+
+    }
+
+    /**
+        The loop of the flush thread, writes whatever producers queued in batches with a single flush per batch
+    */
+    static void flushLoop() {
+
+        LogRecord record;
+
+        while (true) {
+
+            bool stopping = !running;
+
+            std::unique_lock< Mutex > streamLock(streamBusy);
+            uint64_t batch = 0;
+            while (ring.pop(record)) {
+
+                writeRecord(record);
+                batch++;
+
+            }
+            if (batch > 0) flushStreams();
+            streamLock.unlock();
+
+            {
+
+                std::unique_lock< std::mutex > lock(wakeMutex);
+                writtenRecords += batch;
+                flushedCondVar.notify_all();
+
+                if (stopping) break;
+
+                wakeCondVar.wait_for(lock, LOG_FLUSH_INTERVAL);
+
+            }
+
+        }
+
+    }
 
     LOGGER_STATUS_CODE init() {
 #ifndef VK_NO_LOG
@@ -49,10 +310,25 @@ namespace logger {
             }
 
         }
-#endif        
+#endif
 	    error.open(ERROR_LOG_PATH, std::ios::trunc);
         start.open(START_LOG_PATH, std::ios::app);
         event.open(EVENT_LOG_PATH, std::ios::trunc);
+#ifdef VK_LOG_BINARY
+        binary.open(BINARY_LOG_PATH, std::ios::trunc | std::ios::binary);
+        LogBinaryHeader header  = { LOG_BINARY_MAGIC, LOG_BINARY_VERSION };
+        binary.write(reinterpret_cast< const char* >(&header), sizeof(header));
+#endif
+
+        const char* levels = std::getenv("VK_LOG_LEVELS");
+        if (levels != nullptr) configure(levels);
+
+        if (!running.exchange(true)) {
+
+            flushThread = std::thread(&flushLoop);
+            std::atexit(&shutdown);         // Runs before the streams are destroyed, they were constructed first
+
+        }
         logger::log(EVENT_LOG, "Successfully initialized Logger");
 #endif
         return LOGGER_SC_SUCCESS;
@@ -61,202 +337,159 @@ namespace logger {
 
     LOGGER_STATUS_CODE log(LOG_TYPE log_, const char* msg_) {
 #ifndef VK_NO_LOG
-        std::scoped_lock< std::mutex > lock(streamBusy);
-        
-        static int countEvent = 0;
-        static int countError = 0;
+        auto            now         = std::chrono::system_clock::now();
+        std::thread::id thisThread  = std::this_thread::get_id();
+        size_t          length      = std::strlen(msg_);
 
-        time_t current_time;
-        struct tm local_time;
+        if (log_ == ERROR_LOG || !running || length > LOG_RECORD_TEXT_SIZE) {      // A record would cut off the end of a long line
 
-        time(&current_time);
-#if defined WIN_64 || defined WIN_32
-        localtime_s(&local_time, &current_time);
-#elif defined LINUX
-        localtime_r(&current_time, &local_time);
-#endif
+            flush();        // Keeps the order of the lines and gets everything before an error onto disk
+            std::scoped_lock< Mutex > lock(streamBusy);
+            writeText(now, thisThread, log_, msg_, length);
+            flushStreams();
 
-        int Year        = local_time.tm_year + 1900;
-        int Month       = local_time.tm_mon + 1;
-        int Day         = local_time.tm_mday;
+        }
+        else {
 
-        int Hour        = local_time.tm_hour;
-        int Min         = local_time.tm_min;
-        int Sec         = local_time.tm_sec;
+            LogRecord record;
+            record.time     = now;
+            record.thread   = thisThread;
+            record.format   = 0;
+            record.length   = static_cast< uint16_t >(length);
+            record.type     = log_;
+            record.level    = LL_INFO;
+            record.category = LC_CORE;
+            std::memcpy(record.text, msg_, record.length);
 
-        std::thread::id thisThread = std::this_thread::get_id();
+            submit(record);
 
-        switch (log_) {
-        case ERROR_LOG:
-            if (countError == 0) {
+        }
+#endif
+        if (log_ == ERROR_LOG) {
+#if defined VK_DEVELOPMENT && (defined WIN_64 || defined WIN_32)
+            __debugbreak();
+#else
+            throw std::runtime_error(msg_);
+#endif
+        }
 
-                countError++;
+        return LOGGER_SC_SUCCESS;
 
-                error << Day << ":"
-                << Month << ":"
-                << Year << "   "
-                << Hour << ":"
-                << Min << ":"
-                << Sec << " in thread "
-                << thisThread << "        ===        "
-                << "CRITICAL: "
-                << msg_ << std::endl;
+    }
 
-#if (defined VK_DEVELOPMENT || defined VK_RELEASE_CONSOLE) && (defined WIN_64 || defined WIN_32)
-                std::cerr << green << Day << white << ":"
-                    << green << Month << white << ":"
-                    << green << Year << white << "   "
-                    << green << Hour << white << ":"
-                    << green << Min << white << ":"
-                    << green << Sec << yellow << " in thread "
-                    << thisThread << "        ===        "
-                    << red << "CRITICAL: "
-                    << blue << msg_ << white << std::endl;
-#else
-                std::cerr << Day << ":"
-                    << Month << ":"
-                    << Year << "   "
-                    << Hour << ":"
-                    << Min << ":"
-                    << Sec << " in thread "
-                    << thisThread << "        ===        "
-                    << "CRITICAL: "
-                    << msg_ << std::endl;
-#endif
-            }
-            else {
-
-                error << Day << ":"
-                    << Month << ":"
-                    << Year << "   "
-                    << Hour << ":"
-                    << Min << ":"
-                    << Sec << " in thread "
-                    << thisThread << "        ===        "
-                    << "CRITICAL: "
-                    << msg_ << std::endl;
+    LOGGER_STATUS_CODE log(LOG_TYPE log_, std::string msg_) {
 
-#if (defined VK_DEVELOPMENT || defined VK_RELEASE_CONSOLE) && (defined WIN_64 || defined WIN_32)
-                std::cerr << green << Day << white << ":"
-                    << green << Month << white << ":"
-                    << green << Year << white << "   "
-                    << green << Hour << white << ":"
-                    << green << Min << white << ":"
-                    << green << Sec << yellow << " in thread "
-                    << thisThread << "        ===        "
-                    << red << "CRITICAL: "
-                    << blue << msg_ << white << std::endl;
-#else
-                std::cerr << Day << ":"
-                    << Month << ":"
-                    << Year << "   "
-                    << Hour << ":"
-                    << Min << ":"
-                    << Sec << " in thread "
-                    << thisThread << "        ===        "
-                    << "CRITICAL: "
-                    << msg_ << std::endl;
-#endif
-            }
+        return logger::log(log_, msg_.c_str());
 
-        case START_LOG:
+    }
 
-            start << Day << ":"
-                << Month << ":"
-                << Year << "   "
-                << Hour << ":"
-                << Min << ":"
-                << Sec << " in thread "
-                << thisThread << "        ===        "
-                << msg_ << std::endl;
+    void submit(const LogRecord& record_) {
 
-        case EVENT_LOG:
-            if (countEvent == 0) {
+        if (!running) {
 
-                countEvent++;
+            std::scoped_lock< Mutex > lock(streamBusy);
+            writeRecord(record_);
+            flushStreams();
+            return;
 
-                event << Day << ":"
-                    << Month << ":"
-                    << Year << "   "
-                    << Hour << ":"
-                    << Min << ":"
-                    << Sec << " in thread "
-                    << thisThread << "        ===        "
-                    << msg_ << std::endl;
+        }
 
-#if (defined VK_DEVELOPMENT || defined VK_RELEASE_CONSOLE) && (defined WIN_64 || defined WIN_32)
-                std::cout << green << Day << white << ":"
-                    << green << Month << white << ":"
-                    << green << Year << white << "   "
-                    << green << Hour << white << ":"
-                    << green << Min << white << ":"
-                    << green << Sec << yellow << " in thread "
-                    << thisThread << white << "        ===        "
-                    << blue << msg_ << white << std::endl;
-#else
-                std::cout << Day << ":"
-                    << Month << ":"
-                    << Year << "   "
-                    << Hour << ":"
-                    << Min << ":"
-                    << Sec << " in thread "
-                    << thisThread << "        ===        "
-                    << msg_ << std::endl;
-#endif
-            }
-            else {
+        if (!ring.push(record_)) {
 
-                event << Day << ":"
-                    << Month << ":"
-                    << Year << "   "
-                    << Hour << ":"
-                    << Min << ":"
-                    << Sec << " in thread "
-                    << thisThread << "        ===        "
-                    << msg_ << std::endl;
+            droppedRecords.fetch_add(1, std::memory_order_relaxed);        // Never block the caller, the flush thread is behind
 
-#if (defined VK_DEVELOPMENT || defined VK_RELEASE_CONSOLE) && (defined WIN_64 || defined WIN_32)
-                std::cout << green << Day << white << ":"
-                    << green << Month << white << ":"
-                    << green << Year << white << "   "
-                    << green << Hour << white << ":"
-                    << green << Min << white << ":"
-                    << green << Sec << yellow << " in thread "
-                    << thisThread << white << "        ===        "
-                    << blue << msg_ << white << std::endl;
-#else
-                std::cout << Day << ":"
-                    << Month << ":"
-                    << Year << "   "
-                    << Hour << ":"
-                    << Min << ":"
-                    << Sec << " in thread "
-                    << thisThread << "        ===        "
-                    << msg_ << std::endl;
-#endif
-            }
-            break;
+        }
+        else if (ring.pushed() - ring.popped() > LOG_RING_CAPACITY / 2) {
 
-        default:
-            break;
+            wakeCondVar.notify_one();
 
         }
-#endif
-        if (log_ == ERROR_LOG) {
-#if defined VK_DEVELOPMENT && (defined WIN_64 || defined WIN_32)
-            __debugbreak();
-#else
-            throw std::runtime_error(msg_);
-#endif
+
+    }
+
+    uint32_t registerFormat(LOG_LEVEL level_, LOG_CATEGORY category_, const char* file_, uint32_t line_, const char* format_) {
+
+        std::scoped_lock< std::mutex > lock(formatMutex);
+        formats.push_back({ level_, category_, file_, line_, format_, false });
+
+        return static_cast< uint32_t >(formats.size());
+
+    }
+
+    void setLevel(LOG_CATEGORY category_, LOG_LEVEL level_) {
+
+        categoryLevels[category_].store(level_, std::memory_order_relaxed);
+
+    }
+
+    void configure(const std::string& levels_) {
+
+        size_t begin = 0;
+        while (begin < levels_.size()) {
+
+            size_t end = levels_.find(',', begin);
+            if (end == std::string::npos) end = levels_.size();
+
+            std::string setting     = levels_.substr(begin, end - begin);
+            size_t separator        = setting.find('=');
+            begin                   = end + 1;
+            if (separator == std::string::npos) continue;
+
+            std::string category    = setting.substr(0, separator);
+            std::string level       = setting.substr(separator + 1);
+
+            for (uint8_t l = LL_TRACE; l <= LL_OFF; l++) {
+
+                if (level != LOG_LEVEL_NAMES[l]) continue;
+
+                for (uint8_t c = 0; c < LC_COUNT; c++) {
+
+                    if (category == "all" || category == LOG_CATEGORY_NAMES[c]) setLevel(static_cast< LOG_CATEGORY >(c), static_cast< LOG_LEVEL >(l));
+
+                }
+
+            }
+
         }
-        
-        return LOGGER_SC_SUCCESS;
 
     }
 
-    LOGGER_STATUS_CODE log(LOG_TYPE log_, std::string msg_) {
-    
-        return logger::log(log_, msg_.c_str());
+    void flush() {
+
+        if (!running || std::this_thread::get_id() == flushThread.get_id()) return;
+
+        uint64_t target = ring.pushed();
+        std::unique_lock< std::mutex > lock(wakeMutex);
+        wakeCondVar.notify_one();
+        flushedCondVar.wait(lock, [target]() { return writtenRecords >= target || !running; });
+
+    }
+
+    uint64_t dropped() {
+
+        return droppedRecords.load(std::memory_order_relaxed);
+
+    }
+
+    void shutdown() {
+
+        if (!running) return;
+
+        uint64_t lost = dropped();
+        if (lost > 0) {
+
+            logger::log(EVENT_LOG, "Logger dropped " + std::to_string(lost) + " messages because the flush thread fell behind");
+
+        }
+
+        {
+
+            std::scoped_lock< std::mutex > lock(wakeMutex);
+            running = false;
+
+        }
+        wakeCondVar.notify_one();
+        flushThread.join();         // Drains the ring once more before it exits
 
     }
 
@@ -9,15 +9,24 @@
 */
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <thread>
 #include <mutex>
+#include <string>
 
 #include "Version.hpp"
 #include "LOGGER_STATUS_CODE.cpp"
 #include "LOG_TYPE.cpp"
+#include "LOG_LEVEL.cpp"
+#include "LOG_CATEGORY.cpp"
+#include "LogRecord.cpp"
+#include "LogArgs.hpp"
 
 /**
-    Prototypes the logger namespace
+    Prototypes the logger namespace, messages are queued on a lock-free ring and written by a background thread, errors
+    are written synchronously
 */
 namespace logger {
 
@@ -49,5 +58,137 @@ namespace logger {
     */
     LOGGER_STATUS_CODE log(LOG_TYPE log_, std::string msg_);
 
+    extern std::atomic< uint8_t > categoryLevels[LC_COUNT];
+
+    /**
+        Checks the runtime level of a category, VK_LOG_LEVEL has already been applied at compile time
+
+        @param      category_       The category of the message
+        @param      level_          The level of the message
+
+        @return     Returns true if the message should be logged
+    */
+    inline bool enabled(LOG_CATEGORY category_, LOG_LEVEL level_) {
+
+        return level_ >= categoryLevels[category_].load(std::memory_order_relaxed);
+
+    }
+
+    /**
+        Sets the runtime level of a category, messages below it are skipped before their arguments are evaluated
+
+        @param      category_       The category
+        @param      level_          The lowest level that is still logged
+    */
+    void setLevel(LOG_CATEGORY category_, LOG_LEVEL level_);
+
+    /**
+        Sets runtime levels from a list like "io=trace,render=warning" or "all=info", init() reads it from the
+        VK_LOG_LEVELS environment variable
+
+        @param      levels_     Comma-separated category=level pairs
+    */
+    void configure(const std::string& levels_);
+
+    /**
+        Registers the format string of a structured log call site, called once per call site by the VK_LOG macros
+
+        @param      level_      The level of the call site
+        @param      category_   The category of the call site
+        @param      file_       The source file, has to outlive the logger
+        @param      line_       The source line
+        @param      format_     The format string, {} is replaced by the next argument, has to outlive the logger
+
+        @return     Returns the id of the format string
+    */
+    uint32_t registerFormat(LOG_LEVEL level_, LOG_CATEGORY category_, const char* file_, uint32_t line_, const char* format_);
+
+    /**
+        Queues a prepared record, or writes it right away if the flush thread is not running
+
+        @param      record_     The record
+    */
+    void submit(const LogRecord& record_);
+
+    /**
+        Queues a structured message, its arguments are packed as raw values and only rendered by the flush thread or
+        the decoder
+
+        @param      format_     The id of the format string
+        @param      level_      The level of the message
+        @param      category_   The category of the message
+        @param      args_       The arguments of the format string
+    */
+    template< typename... Args >
+    void logStructured(uint32_t format_, LOG_LEVEL level_, LOG_CATEGORY category_, const Args&... args_) {
+
+        LogRecord record;
+        record.time         = std::chrono::system_clock::now();
+        record.thread       = std::this_thread::get_id();
+        record.format       = format_;
+        record.length       = static_cast< uint16_t >(args::encode(record.text, LOG_RECORD_TEXT_SIZE, args_...));
+        record.type         = EVENT_LOG;
+        record.level        = level_;
+        record.category     = category_;
+
+        submit(record);
+
+    }
+
+    /**
+        Waits until every message logged so far has been written and flushed
+    */
+    void flush(void);
+
+    /**
+        Returns how many messages were dropped because the ring was full
+
+        @return     Returns the number of dropped messages
+    */
+    uint64_t dropped(void);
+
+    /**
+        Writes the remaining messages and stops the flush thread, later messages are written synchronously
+    */
+    void shutdown(void);
+
 }
+
+/**
+    Logs a structured message if its category is enabled at level_, the format string is registered once per call site
+*/
+#define VK_LOG_AT(level_, category_, format_, ...)                                                                  \
+    do {                                                                                                            \
+        if (logger::enabled(category_, level_)) {                                                                   \
+            static const uint32_t vkLogFormat = logger::registerFormat(level_, category_, __FILE__, __LINE__, format_); \
+            logger::logStructured(vkLogFormat, level_, category_, ##__VA_ARGS__);                                   \
+        }                                                                                                           \
+    } while (0)
+
+// Levels below VK_LOG_LEVEL expand to nothing, their arguments are never evaluated
+#if VK_LOG_LEVEL <= 0
+    #define VK_LOG_TRACE(category_, format_, ...)       VK_LOG_AT(LL_TRACE, category_, format_, ##__VA_ARGS__)
+#else
+    #define VK_LOG_TRACE(category_, format_, ...)       ((void)0)
+#endif
+#if VK_LOG_LEVEL <= 1
+    #define VK_LOG_DEBUG(category_, format_, ...)       VK_LOG_AT(LL_DEBUG, category_, format_, ##__VA_ARGS__)
+#else
+    #define VK_LOG_DEBUG(category_, format_, ...)       ((void)0)
+#endif
+#if VK_LOG_LEVEL <= 2
+    #define VK_LOG_INFO(category_, format_, ...)        VK_LOG_AT(LL_INFO, category_, format_, ##__VA_ARGS__)
+#else
+    #define VK_LOG_INFO(category_, format_, ...)        ((void)0)
+#endif
+#if VK_LOG_LEVEL <= 3
+    #define VK_LOG_WARNING(category_, format_, ...)     VK_LOG_AT(LL_WARNING, category_, format_, ##__VA_ARGS__)
+#else
+    #define VK_LOG_WARNING(category_, format_, ...)     ((void)0)
+#endif
+#if VK_LOG_LEVEL <= 4
+    #define VK_LOG_ERROR(category_, format_, ...)       VK_LOG_AT(LL_ERROR, category_, format_, ##__VA_ARGS__)
+#else
+    #define VK_LOG_ERROR(category_, format_, ...)       ((void)0)
+#endif
 #endif  // LOGGER_HPP
@@ -0,0 +1,29 @@
+/**
+    Defines the MEMORY_CATEGORY enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         MEMORY_CATEGORY.cpp
+    @brief        Definition of the MEMORY_CATEGORY enumeration
+*/
+#ifndef MEMORY_CATEGORY_CPP
+#define MEMORY_CATEGORY_CPP
+#include <cstdint>
+
+/**
+    Enumeration to differenciate between the kinds of resources device memory is allocated for
+*/
+typedef enum MEMORY_CATEGORY : uint8_t {
+
+    MC_GEOMETRY,
+    MC_TEXTURES,
+    MC_ATTACHMENTS,
+    MC_STAGING,
+    MC_UNIFORMS,
+    MC_COUNT
+
+} MEMORY_CATEGORY;
+
+static const char* const MEMORY_CATEGORY_NAMES[] = { "geometry", "textures", "attachments", "staging", "uniforms" };
+#endif  // MEMORY_CATEGORY_CPP
@@ -0,0 +1,23 @@
+/**
+    Implements the METRIC_TYPE enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         METRIC_TYPE.cpp
+    @brief        Implementation of the METRIC_TYPE enumeration
+*/
+#ifndef METRIC_TYPE_CPP
+#define METRIC_TYPE_CPP
+
+/**
+    Enumeration to differenciate between the kinds of metrics in the registry
+*/
+typedef enum METRIC_TYPE {
+
+    MT_COUNTER,         // Only ever grows
+    MT_GAUGE,           // Goes up and down
+    MT_HISTOGRAM        // Distribution of observed values in power-of-two buckets
+
+} METRIC_TYPE;
+#endif  // METRIC_TYPE_CPP
@@ -0,0 +1,22 @@
+/**
+    Defines the MIPMAP_FILTER enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         MIPMAP_FILTER.cpp
+    @brief        Definition of the MIPMAP_FILTER enumeration
+*/
+#ifndef MIPMAP_FILTER_CPP
+#define MIPMAP_FILTER_CPP
+
+/**
+ * Enumeration to differenciate between the downsampling filters of the CPU mipmap generator
+ */
+typedef enum MIPMAP_FILTER {
+
+    MF_KAISER       = 1,
+    MF_BOX          = 0
+
+} MIPMAP_FILTER;
+#endif  // MIPMAP_FILTER_CPP
@@ -20,4 +20,16 @@
 #ifndef WORLD_UP
     #define WORLD_UP glm::vec3(0.0f, 1.0f, 0.0f)
 #endif
+
+#ifndef VK_SSE2
+    #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+        #define VK_SSE2         // SSE2 intrinsics are available for the CPU-side texture kernels
+    #endif
+#endif
+
+#ifndef VK_SSSE3
+    #if defined __SSSE3__ || defined __AVX__
+        #define VK_SSSE3        // SSSE3 byte shuffles are available for texel format conversion
+    #endif
+#endif
 #endif  // MAKROS_HPP
@@ -0,0 +1,220 @@
+/**
+    Implements the memory namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         MemoryBudget.cpp
+    @brief        Implementation of the memory namespace, device memory accounting by category and heap budgets
+*/
+#include "MemoryBudget.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "VK.hpp"
+
+namespace vk {
+
+    namespace memory {
+
+        namespace {
+
+            VkPhysicalDevice                                physicalDevice                          = VK_NULL_HANDLE;
+            VkPhysicalDeviceMemoryProperties                memoryProperties                        = {};
+            PFN_vkGetPhysicalDeviceMemoryProperties2KHR     getMemoryProperties2                    = nullptr;
+            uint32_t                                        textureHeap                             = 0;
+            std::atomic< int64_t >                          categoryBytes[MC_COUNT];
+            std::atomic< int64_t >                          heapBytes[VK_MAX_MEMORY_HEAPS];         // What the engine allocated itself
+            std::atomic< int64_t >                          heapOverhead[VK_MAX_MEMORY_HEAPS];      // What the driver reported beyond that at the last refresh
+            std::atomic< uint64_t >                         heapBudget[VK_MAX_MEMORY_HEAPS];
+
+            Gauge* categoryGauge(MEMORY_CATEGORY category_) {
+
+                static Gauge* gauges[MC_COUNT] = {};
+                static bool registered = [] {
+
+                    for (uint32_t i = 0; i < MC_COUNT; i++) {
+
+                        gauges[i] = vk::metrics::gauge(std::string("memory_") + MEMORY_CATEGORY_NAMES[i] + "_bytes", std::string("Device memory allocated for ") + MEMORY_CATEGORY_NAMES[i]);
+
+                    }
+
+                    return true;
+
+                }();
+                (void) registered;
+
+                return gauges[category_];
+
+            }
+
+        }
+
+        void init(VkInstance instance_, VkPhysicalDevice physicalDevice_, bool budgetExtension_) {
+
+            physicalDevice = physicalDevice_;
+            vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+            if (budgetExtension_) {
+
+                getMemoryProperties2 = reinterpret_cast< PFN_vkGetPhysicalDeviceMemoryProperties2KHR >(vkGetInstanceProcAddr(instance_, "vkGetPhysicalDeviceMemoryProperties2KHR"));
+
+            }
+
+            for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+
+                if (memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+
+                    textureHeap = memoryProperties.memoryTypes[i].heapIndex;      // vk::enumerateSuitableMemoryType() picks the first device local type for textures too
+                    break;
+
+                }
+
+            }
+
+            refresh();
+            logStats();
+
+        }
+
+        MEMORY_CATEGORY bufferCategory(VkBufferUsageFlags usage_) {
+
+            if (usage_ & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT)) return MC_GEOMETRY;
+            if (usage_ & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) return MC_UNIFORMS;
+
+            return MC_STAGING;
+
+        }
+
+        MEMORY_CATEGORY imageCategory(VkImageUsageFlags usage_) {
+
+            if (usage_ & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) return MC_ATTACHMENTS;
+
+            return MC_TEXTURES;
+
+        }
+
+        void track(MEMORY_CATEGORY category_, uint32_t memoryType_, int64_t size_) {
+
+            static Gauge* deviceBytes          = vk::metrics::gauge("memory_device_bytes", "Device memory allocated for buffers and images");
+            static Gauge* deviceAllocations    = vk::metrics::gauge("memory_device_allocations", "Live device memory allocations");
+
+            if (size_ == 0) return;
+
+            deviceBytes->add(size_);
+            deviceAllocations->add(size_ > 0 ? 1 : -1);
+            categoryGauge(category_)->add(size_);
+            categoryBytes[category_].fetch_add(size_, std::memory_order_relaxed);
+
+            if (memoryType_ < memoryProperties.memoryTypeCount) {
+
+                heapBytes[memoryProperties.memoryTypes[memoryType_].heapIndex].fetch_add(size_, std::memory_order_relaxed);
+
+            }
+
+        }
+
+        void refresh() {
+
+            static Gauge* textureHeapBudget    = vk::metrics::gauge("memory_texture_heap_budget_bytes", "Budget of the heap textures are allocated from");
+
+            VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties     = {};
+            budgetProperties.sType                                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+            if (getMemoryProperties2 != nullptr) {
+
+                VkPhysicalDeviceMemoryProperties2 properties               = {};
+                properties.sType                                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+                properties.pNext                                            = &budgetProperties;
+                getMemoryProperties2(physicalDevice, &properties);
+
+            }
+
+            for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+
+                if (getMemoryProperties2 != nullptr) {
+
+                    heapOverhead[i].store(static_cast< int64_t >(budgetProperties.heapUsage[i]) - heapBytes[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    heapBudget[i].store(budgetProperties.heapBudget[i], std::memory_order_relaxed);
+
+                }
+                else {
+
+                    heapBudget[i].store(static_cast< uint64_t >(memoryProperties.memoryHeaps[i].size * vk::MEMORY_BUDGET_FRACTION), std::memory_order_relaxed);
+
+                }
+
+            }
+
+            textureHeapBudget->set(static_cast< int64_t >(heapBudget[textureHeap].load(std::memory_order_relaxed)));
+
+        }
+
+        double pressure(VkDeviceSize additional_) {
+
+            double budget = static_cast< double >(heapBudget[textureHeap].load(std::memory_order_relaxed));
+            if (budget <= 0.0) return 0.0;         // Not initialized yet
+
+            int64_t usage = heapBytes[textureHeap].load(std::memory_order_relaxed) + heapOverhead[textureHeap].load(std::memory_order_relaxed);
+
+            return (static_cast< double >(usage) + static_cast< double >(additional_)) / budget;
+
+        }
+
+        MemoryStats stats() {
+
+            MemoryStats snapshot        = {};
+            snapshot.heapCount          = memoryProperties.memoryHeapCount;
+            snapshot.textureHeap        = textureHeap;
+            snapshot.budgetExtension    = getMemoryProperties2 != nullptr;
+
+            for (uint32_t i = 0; i < MC_COUNT; i++) {
+
+                snapshot.categoryBytes[i] = static_cast< uint64_t >(std::max< int64_t >(categoryBytes[i].load(std::memory_order_relaxed), 0));
+
+            }
+
+            for (uint32_t i = 0; i < snapshot.heapCount; i++) {
+
+                int64_t usage               = heapBytes[i].load(std::memory_order_relaxed) + heapOverhead[i].load(std::memory_order_relaxed);
+                snapshot.heapUsage[i]       = static_cast< uint64_t >(std::max< int64_t >(usage, 0));
+                snapshot.heapBudget[i]      = heapBudget[i].load(std::memory_order_relaxed);
+                snapshot.heapDeviceLocal[i] = (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+
+            }
+
+            return snapshot;
+
+        }
+
+        void logStats() {
+
+            MemoryStats snapshot = stats();
+
+            std::string categories = "Device memory:";
+            for (uint32_t i = 0; i < MC_COUNT; i++) {
+
+                categories += " " + std::string(MEMORY_CATEGORY_NAMES[i]) + " " + std::to_string(snapshot.categoryBytes[i] >> 20) + " MiB";
+
+            }
+            logger::log(EVENT_LOG, categories);
+
+            for (uint32_t i = 0; i < snapshot.heapCount; i++) {
+
+                logger::log(EVENT_LOG, "Memory heap " + std::to_string(i)
+                    + (snapshot.heapDeviceLocal[i] ? " (device local" : " (host")
+                    + (i == snapshot.textureHeap ? ", textures): " : "): ")
+                    + std::to_string(snapshot.heapUsage[i] >> 20) + " MiB of "
+                    + std::to_string(snapshot.heapBudget[i] >> 20) + " MiB budget"
+                    + (snapshot.budgetExtension ? "" : " (estimated from the heap size)")
+                    );
+
+            }
+
+        }
+
+    }
+
+}
@@ -0,0 +1,93 @@
+/**
+    Prototypes the memory namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         MemoryBudget.hpp
+    @brief        Prototype of the memory namespace, device memory accounting by category and heap budgets
+*/
+#ifndef MEMORY_BUDGET_HPP
+#define MEMORY_BUDGET_HPP
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+#include "MEMORY_CATEGORY.cpp"
+#include "MemoryStats.cpp"
+
+namespace vk {
+
+    /**
+        Accounts every device memory allocation by category and memory heap, and compares the heaps against their
+        budgets. The budgets come from VK_EXT_memory_budget where the device supports it and are a fraction of the
+        heap sizes otherwise.
+    */
+    namespace memory {
+
+        /**
+            Reads the memory heaps of the device and its first budget, has to be called once the logical device exists
+
+            @param      instance_               The instance, to load the VK_KHR_get_physical_device_properties2 entry point
+            @param      physicalDevice_         The physical device
+            @param      budgetExtension_        Whether VK_EXT_memory_budget is enabled on the logical device
+        */
+        void init(VkInstance instance_, VkPhysicalDevice physicalDevice_, bool budgetExtension_);
+
+        /**
+            Returns the category of a buffer
+
+            @param      usage_      The usage flags the buffer was created with
+
+            @return     Returns the MEMORY_CATEGORY to account the buffer's memory to
+        */
+        MEMORY_CATEGORY bufferCategory(VkBufferUsageFlags usage_);
+
+        /**
+            Returns the category of an image
+
+            @param      usage_      The usage flags the image was created with
+
+            @return     Returns the MEMORY_CATEGORY to account the image's memory to
+        */
+        MEMORY_CATEGORY imageCategory(VkImageUsageFlags usage_);
+
+        /**
+            Adds an allocation or, with a negative size, removes it again
+
+            @param      category_       The category of the resource
+            @param      memoryType_     The memory type index the memory was allocated from
+            @param      size_           The size of the allocation in bytes
+        */
+        void track(MEMORY_CATEGORY category_, uint32_t memoryType_, int64_t size_);
+
+        /**
+            Queries the budgets again, they change with what other processes allocate, has to be called by the main thread
+        */
+        void refresh(void);
+
+        /**
+            Returns how full the heap textures are allocated from is, any thread may call it
+
+            @param      additional_     Bytes about to be allocated from the heap
+
+            @return     Returns the usage over the budget, 1.0 or more means the heap is at its budget
+        */
+        double pressure(VkDeviceSize additional_ = 0);
+
+        /**
+            Returns the usage by category and the usage and budget of every heap
+
+            @return     Returns a MemoryStats snapshot
+        */
+        MemoryStats stats(void);
+
+        /**
+            Writes the usage by category and of every heap to the event log
+        */
+        void logStats(void);
+
+    }
+
+}
+#endif  // MEMORY_BUDGET_HPP
@@ -0,0 +1,32 @@
+/**
+    Defines the MemoryStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         MemoryStats.cpp
+    @brief        Definition of the MemoryStats struct
+*/
+#ifndef MEMORY_STATS_CPP
+#define MEMORY_STATS_CPP
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+#include "MEMORY_CATEGORY.cpp"
+
+/**
+    Holds the device memory the engine allocated by category and the usage and budget of every memory heap
+*/
+struct MemoryStats {
+
+    uint64_t            categoryBytes[MC_COUNT];                    // Bytes allocated for each MEMORY_CATEGORY
+    uint32_t            heapCount;
+    uint64_t            heapUsage[VK_MAX_MEMORY_HEAPS];             // Bytes used, including what the driver reports beyond the engine's own allocations
+    uint64_t            heapBudget[VK_MAX_MEMORY_HEAPS];            // Bytes the process may use before allocations start to fail or evict
+    bool                heapDeviceLocal[VK_MAX_MEMORY_HEAPS];
+    uint32_t            textureHeap;                                // The heap textures are allocated from, the one residency watches
+    bool                budgetExtension;                            // Whether the budgets come from VK_EXT_memory_budget instead of the heap sizes
+
+};
+#endif  // MEMORY_STATS_CPP
@@ -20,19 +20,13 @@ Mesh::Mesh(
     )
     : pipeline(pipeline_), vertices(vertices_), indices(indices_), textures(textures_) {
 
-    QueueFamily family                                          = vk::core::findSuitableQueueFamily(vk::core::physicalDevice);
-
-    std::vector< uint32_t > queueFamilyIndices                  = { family.graphicsFamilyIndex.value(), family.transferFamilyIndex.value() };
-
     VkBufferCreateInfo vertexBufferCreateInfo                   = {};
     vertexBufferCreateInfo.sType                                = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     vertexBufferCreateInfo.size                                 = sizeof(vertices[0]) * vertices.size();
     vertexBufferCreateInfo.usage                                = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-    vertexBufferCreateInfo.sharingMode                          = VK_SHARING_MODE_CONCURRENT;
-    vertexBufferCreateInfo.queueFamilyIndexCount                = static_cast< uint32_t >(queueFamilyIndices.size());
-    vertexBufferCreateInfo.pQueueFamilyIndices                  = queueFamilyIndices.data();
+    vertexBufferCreateInfo.sharingMode                          = VK_SHARING_MODE_EXCLUSIVE;          // Owned by the transfer queue until the graphics queue acquires it
 
-    vertexBuffer                                                = new VertexBuffer(&vertexBufferCreateInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    vertexBuffer                                                = new VertexBuffer(&vertexBufferCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     VK_STATUS_CODE res                                          = vertexBuffer->fillS(vertices.data(), sizeof(vertices[0]) * vertices.size());
     ASSERT(res, "Failed to fill vertex buffer", VK_SC_VERTEX_BUFFER_MAP_ERROR);
 
@@ -40,19 +34,15 @@ Mesh::Mesh(
     indexBufferCreateInfo.sType                                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     indexBufferCreateInfo.size                                  = sizeof(indices[0]) * indices.size();
     indexBufferCreateInfo.usage                                 = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-    indexBufferCreateInfo.sharingMode                           = VK_SHARING_MODE_CONCURRENT;
-    indexBufferCreateInfo.queueFamilyIndexCount                 = static_cast< uint32_t >(queueFamilyIndices.size());
-    indexBufferCreateInfo.pQueueFamilyIndices                   = queueFamilyIndices.data();
+    indexBufferCreateInfo.sharingMode                           = VK_SHARING_MODE_EXCLUSIVE;          // Owned by the transfer queue until the graphics queue acquires it
 
-    indexBuffer                                                 = new IndexBuffer(&indexBufferCreateInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    indexBuffer                                                 = new IndexBuffer(&indexBufferCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     res                                                         = indexBuffer->fillS(indices.data(), sizeof(indices[0]) * indices.size());
     ASSERT(res, "Failed to fill index buffer", VK_SC_INDEX_BUFFER_MAP_ERROR);
 
 }
 
-std::vector< Descriptor > Mesh::getDescriptors() {
-
-    std::vector< Descriptor > descriptors;
+void Mesh::getDescriptors(FrameVector< Descriptor >& descriptors_) {
 
     uint32_t diffuseNr      = 0;
     uint32_t specularNr     = 0;
@@ -80,24 +70,22 @@ std::vector< Descriptor > Mesh::getDescriptors() {
         samplerInfo.type                    = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 
         if(textures[i].type == TT_DIFFUSE)
-            descriptors.push_back(Descriptor(samplerInfo));
+            descriptors_.push_back(Descriptor(samplerInfo));
 
     }
 
-    return descriptors;
-
 }
 
 void Mesh::draw(std::vector< VkCommandBuffer >& commandBuffers_, uint32_t imageIndex_) {
 
-    std::vector< VkDeviceSize > offsets = { 0 };
+    VkDeviceSize offset = 0;
 
     vkCmdBindVertexBuffers(
         commandBuffers_[imageIndex_],
         0,
         1,
         &(vertexBuffer->buf),
-        offsets.data()
+        &offset
         );
 
     vkCmdBindIndexBuffer(
@@ -107,6 +95,18 @@ void Mesh::draw(std::vector< VkCommandBuffer >& commandBuffers_, uint32_t imageI
         VK_INDEX_TYPE_UINT32
         );
 
+    vk::counters::add(FC_VERTEX_BUFFER_BINDS);
+    vk::counters::add(FC_INDEX_BUFFER_BINDS);
+    vk::counters::add(FC_DRAW_CALLS);
+    vk::counters::add(FC_TRIANGLES, indices.size() / 3);
+
+    uint64_t frame = vk::counters::frame();
+    for (auto& texture : textures) {
+
+        texture.img->touch(frame);         // Texture residency keeps what was drawn last and reduces the rest first
+
+    }
+
     vkCmdDrawIndexed(
         commandBuffers_[imageIndex_],
         static_cast< uint32_t >(indices.size()),
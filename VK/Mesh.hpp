@@ -16,6 +16,7 @@
 #include "VertexBuffer.hpp"
 #include "IndexBuffer.hpp"
 #include "GraphicsPipeline.hpp"
+#include "FrameArena.hpp"
 
 class Mesh
 {
@@ -44,11 +45,11 @@ public:
         );
 
     /**
-        Returns the correct descriptor to bind
+        Appends the correct descriptors to bind
 
-        @return     Returns an array of descriptor objects
+        @param      descriptors_        The descriptors of the draw, allocated from the frame arena
     */
-    std::vector< Descriptor > getDescriptors(void);
+    void getDescriptors(FrameVector< Descriptor >& descriptors_);
 
     /**
         Binds the vertex and index data for command buffer recording and executes the draw call
@@ -0,0 +1,161 @@
+/**
+    Declares the Counter, Gauge and Histogram classes
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Metric.hpp
+    @brief        Declaration of the metric classes, every update is a single relaxed atomic operation
+*/
+#ifndef METRIC_HPP
+#define METRIC_HPP
+#include <atomic>
+#include <cstdint>
+
+/**
+    A value that only ever grows, like frames rendered or bytes read
+*/
+class alignas(64) Counter {
+public:
+
+    /**
+        Adds to the counter
+
+        @param      value_      The amount to add
+    */
+    void add(uint64_t value_ = 1) {
+
+        value.fetch_add(value_, std::memory_order_relaxed);
+
+    }
+
+    /**
+        Returns the current value
+
+        @return     Returns the counter value
+    */
+    uint64_t get(void) const {
+
+        return value.load(std::memory_order_relaxed);
+
+    }
+
+private:
+
+    std::atomic< uint64_t >             value               = { 0 };
+
+};
+
+/**
+    A value that goes up and down, like bytes allocated or loads pending
+*/
+class alignas(64) Gauge {
+public:
+
+    /**
+        Sets the gauge
+
+        @param      value_      The new value
+    */
+    void set(int64_t value_) {
+
+        value.store(value_, std::memory_order_relaxed);
+
+    }
+
+    /**
+        Adds to the gauge
+
+        @param      value_      The amount to add, may be negative
+    */
+    void add(int64_t value_) {
+
+        value.fetch_add(value_, std::memory_order_relaxed);
+
+    }
+
+    /**
+        Returns the current value
+
+        @return     Returns the gauge value
+    */
+    int64_t get(void) const {
+
+        return value.load(std::memory_order_relaxed);
+
+    }
+
+private:
+
+    std::atomic< int64_t >              value               = { 0 };
+
+};
+
+/**
+    The distribution of observed values, like frame times in microseconds. Bucket i counts values below 2^i, the last
+    bucket everything above.
+*/
+class alignas(64) Histogram {
+public:
+
+    static const uint32_t               BUCKETS             = 32;
+
+    /**
+        Records an observation
+
+        @param      value_      The observed value
+    */
+    void observe(uint64_t value_) {
+
+        uint32_t bucket = 0;
+        while (bucket < BUCKETS - 1 && (value_ >> bucket) != 0) bucket++;
+
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value_, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+
+    }
+
+    /**
+        Returns the number of observations in a bucket
+
+        @param      bucket_     The bucket index
+
+        @return     Returns the number of observations below 2^bucket_ and at least 2^(bucket_ - 1)
+    */
+    uint64_t getBucket(uint32_t bucket_) const {
+
+        return buckets[bucket_].load(std::memory_order_relaxed);
+
+    }
+
+    /**
+        Returns the sum of all observations
+
+        @return     Returns the sum
+    */
+    uint64_t getSum(void) const {
+
+        return sum.load(std::memory_order_relaxed);
+
+    }
+
+    /**
+        Returns the number of observations
+
+        @return     Returns the count
+    */
+    uint64_t getCount(void) const {
+
+        return count.load(std::memory_order_relaxed);
+
+    }
+
+private:
+
+    std::atomic< uint64_t >             buckets[BUCKETS]    = {};
+    std::atomic< uint64_t >             sum                 = { 0 };
+    std::atomic< uint64_t >             count               = { 0 };
+
+};
+#endif  // METRIC_HPP
@@ -0,0 +1,261 @@
+/**
+    Implements the metrics namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Metrics.cpp
+    @brief        Implementation of the metrics namespace, the process-wide metrics registry and its local socket export
+*/
+#include "Metrics.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Logger.hpp"
+#if defined LINUX
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace vk {
+
+    namespace metrics {
+
+        /**
+            A registered metric
+        */
+        struct Entry {
+
+            std::string                                 name;
+            std::string                                 help;
+            METRIC_TYPE                                 type;
+            void*                                       metric;
+
+        };
+
+        /**
+            Every registered metric, built on first use since metrics are registered from static initializers
+        */
+        struct Registry {
+
+            std::mutex                                  mutex;                  // Only taken to register and to take a snapshot
+            std::vector< Entry >                        entries;
+            std::deque< Counter >                       counters;               // Deques keep the metrics in place as they grow
+            std::deque< Gauge >                         gauges;
+            std::deque< Histogram >                     histograms;
+
+        };
+
+        std::thread                                     exportThread;
+        std::atomic< bool >                             exporting               = { false };
+        std::string                                     socketPath;
+        int                                             socketHandle            = -1;
+
+        /**
+            Returns the metric with a name and type, registering it in its deque on first use
+        */
+        static Registry& registry() {
+
+            static Registry instance;
+
+            return instance;
+
+        }
+
+        template< typename T >
+        static T* find(const std::string& name_, const std::string& help_, METRIC_TYPE type_, std::deque< T > Registry::* storage_) {
+
+            Registry& metrics = registry();
+            std::deque< T >& storage = metrics.*storage_;
+
+            std::scoped_lock< std::mutex > lock(metrics.mutex);
+            for (const auto& entry : metrics.entries) {
+
+                if (entry.name != name_) continue;
+                if (entry.type != type_) logger::log(ERROR_LOG, "Metric '" + name_ + "' was registered with a different type");
+
+                return static_cast< T* >(entry.metric);
+
+            }
+
+            storage.emplace_back();
+            metrics.entries.push_back({ name_, help_, type_, &storage.back() });
+
+            return &storage.back();
+
+        }
+
+        Counter* counter(const std::string& name_, const std::string& help_) {
+
+            return find(name_, help_, MT_COUNTER, &Registry::counters);
+
+        }
+
+        Gauge* gauge(const std::string& name_, const std::string& help_) {
+
+            return find(name_, help_, MT_GAUGE, &Registry::gauges);
+
+        }
+
+        Histogram* histogram(const std::string& name_, const std::string& help_) {
+
+            return find(name_, help_, MT_HISTOGRAM, &Registry::histograms);
+
+        }
+
+        std::string snapshot() {
+
+            Registry& metrics = registry();
+            std::string text;
+            std::scoped_lock< std::mutex > lock(metrics.mutex);
+
+            for (const auto& entry : metrics.entries) {
+
+                text += "# HELP " + entry.name + " " + entry.help + "\n";
+
+                switch (entry.type) {
+                case MT_COUNTER:
+                    text += "# TYPE " + entry.name + " counter\n";
+                    text += entry.name + " " + std::to_string(static_cast< Counter* >(entry.metric)->get()) + "\n";
+                    break;
+
+                case MT_GAUGE:
+                    text += "# TYPE " + entry.name + " gauge\n";
+                    text += entry.name + " " + std::to_string(static_cast< Gauge* >(entry.metric)->get()) + "\n";
+                    break;
+
+                case MT_HISTOGRAM: {
+
+                    const Histogram* histogram = static_cast< Histogram* >(entry.metric);
+                    text += "# TYPE " + entry.name + " histogram\n";
+
+                    uint64_t cumulative = 0;
+                    for (uint32_t i = 0; i < Histogram::BUCKETS - 1; i++) {
+
+                        cumulative += histogram->getBucket(i);
+                        if (histogram->getBucket(i) == 0 && cumulative == 0) continue;      // Leading empty buckets carry no information
+
+                        text += entry.name + "_bucket{le=\"" + std::to_string((1ull << i) - 1) + "\"} " + std::to_string(cumulative) + "\n";
+
+                    }
+                    cumulative += histogram->getBucket(Histogram::BUCKETS - 1);
+                    text += entry.name + "_bucket{le=\"+Inf\"} " + std::to_string(cumulative) + "\n";
+                    text += entry.name + "_sum " + std::to_string(histogram->getSum()) + "\n";
+                    text += entry.name + "_count " + std::to_string(histogram->getCount()) + "\n";
+                    break;
+
+                }
+                default:
+                    break;
+
+                }
+
+            }
+
+            return text;
+
+        }
+
+#if defined LINUX
+        /**
+            The loop of the export thread, answers one connection at a time and checks for stop() a few times a second
+        */
+        static void exportLoop() {
+
+            while (exporting) {
+
+                pollfd descriptor   = {};
+                descriptor.fd       = socketHandle;
+                descriptor.events   = POLLIN;
+                if (poll(&descriptor, 1, 250) <= 0) continue;
+
+                int client = accept(socketHandle, nullptr, nullptr);
+                if (client < 0) continue;
+
+                std::string text    = snapshot();
+                size_t written      = 0;
+                while (written < text.size()) {
+
+                    ssize_t result = send(client, text.data() + written, text.size() - written, MSG_NOSIGNAL);
+                    if (result <= 0) break;
+                    written += static_cast< size_t >(result);
+
+                }
+                close(client);
+
+            }
+
+        }
+#endif
+
+        bool serve(const std::string& path_) {
+
+#if defined LINUX
+            if (exporting) return true;
+
+            sockaddr_un address     = {};
+            address.sun_family      = AF_UNIX;
+            if (path_.size() >= sizeof(address.sun_path)) {
+
+                logger::log(EVENT_LOG, "Metrics socket path '" + path_ + "' is too long, metrics are not exported");
+                return false;
+
+            }
+            std::memcpy(address.sun_path, path_.c_str(), path_.size() + 1);
+
+            std::error_code error;
+            std::filesystem::path parent = std::filesystem::path(path_).parent_path();
+            if (!parent.empty()) std::filesystem::create_directories(parent, error);
+
+            socketHandle = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (socketHandle < 0) return false;
+
+            unlink(path_.c_str());      // Left behind if the last run did not shut down cleanly
+            if (bind(socketHandle, reinterpret_cast< sockaddr* >(&address), sizeof(address)) != 0 || listen(socketHandle, 4) != 0) {
+
+                logger::log(EVENT_LOG, "Failed to listen on metrics socket '" + path_ + "', metrics are not exported");
+                close(socketHandle);
+                socketHandle = -1;
+                return false;
+
+            }
+
+            socketPath      = path_;
+            exporting       = true;
+            exportThread    = std::thread(&exportLoop);
+            logger::log(EVENT_LOG, "Exporting metrics on '" + path_ + "'");
+
+            return true;
+#else
+            logger::log(EVENT_LOG, "Metrics export needs Unix-domain sockets, metrics are not exported on this platform");
+
+            return false;
+#endif
+
+        }
+
+        void stop() {
+
+#if defined LINUX
+            if (!exporting) return;
+
+            exporting = false;
+            exportThread.join();
+            close(socketHandle);
+            socketHandle = -1;
+            unlink(socketPath.c_str());
+#endif
+
+        }
+
+    }
+
+}
@@ -0,0 +1,80 @@
+/**
+    Prototypes the metrics namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Metrics.hpp
+    @brief        Prototype of the metrics namespace, the process-wide metrics registry and its local socket export
+*/
+#ifndef METRICS_HPP
+#define METRICS_HPP
+#include <string>
+
+#include "Version.hpp"
+#include "Metric.hpp"
+#include "METRIC_TYPE.cpp"
+
+namespace vk {
+
+    /**
+        Holds named counters, gauges and histograms. Registering takes a lock, so call sites keep the returned pointer
+        (usually in a static); updating it never locks. The metrics can be read from outside the process as text.
+    */
+    namespace metrics {
+
+        /**
+            Returns the counter with a name, registering it on first use
+
+            @param      name_       The name, lowercase with underscores
+            @param      help_       A one-line description
+
+            @return     Returns a pointer that stays valid for the lifetime of the process
+        */
+        Counter* counter(const std::string& name_, const std::string& help_);
+
+        /**
+            Returns the gauge with a name, registering it on first use
+
+            @param      name_       The name, lowercase with underscores
+            @param      help_       A one-line description
+
+            @return     Returns a pointer that stays valid for the lifetime of the process
+        */
+        Gauge* gauge(const std::string& name_, const std::string& help_);
+
+        /**
+            Returns the histogram with a name, registering it on first use
+
+            @param      name_       The name, lowercase with underscores and the unit as suffix
+            @param      help_       A one-line description
+
+            @return     Returns a pointer that stays valid for the lifetime of the process
+        */
+        Histogram* histogram(const std::string& name_, const std::string& help_);
+
+        /**
+            Renders every metric in the Prometheus text format
+
+            @return     Returns the text
+        */
+        std::string snapshot(void);
+
+        /**
+            Starts a thread that answers every connection to a Unix-domain socket with a snapshot
+
+            @param      path_       (Relative) path of the socket, an existing socket file is replaced
+
+            @return     Returns true if the socket is listening
+        */
+        bool serve(const std::string& path_);
+
+        /**
+            Stops the export thread and removes the socket
+        */
+        void stop(void);
+
+    }
+
+}
+#endif  // METRICS_HPP
@@ -0,0 +1,369 @@
+/**
+    Implements the mipmaps namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         MipmapGenerator.cpp
+    @brief        Implementation of the mipmaps namespace, a parallel CPU mipmap generator
+*/
+#include "MipmapGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "VK.hpp"
+
+#ifdef VK_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace vk {
+
+    namespace mipmaps {
+
+        const uint32_t          PARALLEL_TEXELS         = 128 * 128;        // Levels smaller than this are not worth splitting across cores
+        const int               KAISER_TAPS             = 8;
+
+        /**
+            Lookup tables for sRGB-correct averaging
+        */
+        struct SRGBTables {
+
+            float               toLinear[256];
+            unsigned char       toSRGB[4096];
+
+            SRGBTables(void) {
+
+                for (int i = 0; i < 256; i++) {
+
+                    float c = i / 255.0f;
+                    toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+
+                }
+
+                for (int i = 0; i < 4096; i++) {
+
+                    float l = i / 4095.0f;
+                    float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                    toSRGB[i] = static_cast< unsigned char >(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+
+                }
+
+            }
+
+        };
+
+        static const SRGBTables& srgbTables() {
+
+            static const SRGBTables tables;
+
+            return tables;
+
+        }
+
+        static unsigned char encode(float value_, bool sRGB_) {
+
+            value_ = std::clamp(value_, 0.0f, 1.0f);
+
+            return sRGB_
+                ? srgbTables().toSRGB[static_cast< int >(value_ * 4095.0f + 0.5f)]
+                : static_cast< unsigned char >(value_ * 255.0f + 0.5f);
+
+        }
+
+        static float decode(unsigned char value_, bool sRGB_) {
+
+            return sRGB_ ? srgbTables().toLinear[value_] : value_ / 255.0f;
+
+        }
+
+        /**
+            Runs a function over [0, count_) in contiguous bands on the job system, if the work is large enough
+
+            @param      count_          The number of items
+            @param      parallel_       Whether to split the work at all
+            @param      func_           Callable taking the first and one-past-last item of a band
+        */
+        template< typename Function >
+        static void forBands(uint32_t count_, bool parallel_, Function func_) {
+
+            if (vk::core::jobSystem == nullptr) {
+
+                func_(0, count_);
+                return;
+
+            }
+
+            vk::core::jobSystem->parallelFor(count_, parallel_, func_);
+
+        }
+
+        /**
+            Averages 2x2 quads of a row pair, channel-agnostic for 1, 2 and 4 channels when SSE2 is available
+        */
+        static void boxRow(const unsigned char* row0_, const unsigned char* row1_, unsigned char* dst_, uint32_t srcWidth_, uint32_t dstWidth_, uint32_t channels_, bool sRGB_) {
+
+            uint32_t x = 0;
+
+#ifdef VK_SSE2
+            if (!sRGB_ && srcWidth_ >= 2 && (channels_ == 1 || channels_ == 2 || channels_ == 4)) {
+
+                const __m128i zero  = _mm_setzero_si128();
+                const __m128i two   = _mm_set1_epi16(2);
+                const __m128i ones  = _mm_set1_epi16(1);
+                uint32_t step       = 8 / channels_;        // Destination texels per iteration, 16 source bytes per row
+
+                for (; x + step <= dstWidth_; x += step) {
+
+                    __m128i a   = _mm_loadu_si128(reinterpret_cast< const __m128i* >(row0_ + 2 * x * channels_));
+                    __m128i b   = _mm_loadu_si128(reinterpret_cast< const __m128i* >(row1_ + 2 * x * channels_));
+                    __m128i lo  = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                    __m128i hi  = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                    __m128i sum;
+
+                    if (channels_ == 1) {
+
+                        sum = _mm_packs_epi32(_mm_madd_epi16(lo, ones), _mm_madd_epi16(hi, ones));
+
+                    }
+                    else if (channels_ == 2) {
+
+                        __m128 l    = _mm_castsi128_ps(lo);
+                        __m128 h    = _mm_castsi128_ps(hi);
+                        sum         = _mm_add_epi16(
+                            _mm_castps_si128(_mm_shuffle_ps(l, h, _MM_SHUFFLE(2, 0, 2, 0))),
+                            _mm_castps_si128(_mm_shuffle_ps(l, h, _MM_SHUFFLE(3, 1, 3, 1)))
+                            );
+
+                    }
+                    else {
+
+                        sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+
+                    }
+
+                    sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+                    _mm_storel_epi64(reinterpret_cast< __m128i* >(dst_ + x * channels_), _mm_packus_epi16(sum, sum));
+
+                }
+
+            }
+#endif
+
+            const SRGBTables& tables = srgbTables();
+
+            for (; x < dstWidth_; x++) {
+
+                uint32_t x0 = std::min(2 * x, srcWidth_ - 1) * channels_;
+                uint32_t x1 = std::min(2 * x + 1, srcWidth_ - 1) * channels_;
+
+                for (uint32_t c = 0; c < channels_; c++) {
+
+                    if (sRGB_ && c < 3) {       // Alpha is always linear
+
+                        float sum = tables.toLinear[row0_[x0 + c]] + tables.toLinear[row0_[x1 + c]] + tables.toLinear[row1_[x0 + c]] + tables.toLinear[row1_[x1 + c]];
+                        dst_[x * channels_ + c] = encode(sum * 0.25f, true);
+
+                    }
+                    else {
+
+                        dst_[x * channels_ + c] = static_cast< unsigned char >((row0_[x0 + c] + row0_[x1 + c] + row1_[x0 + c] + row1_[x1 + c] + 2) >> 2);
+
+                    }
+
+                }
+
+            }
+
+        }
+
+        static void boxLevel(const unsigned char* src_, const TextureLevel& srcLevel_, unsigned char* dst_, const TextureLevel& dstLevel_, uint32_t channels_, bool sRGB_) {
+
+            size_t srcPitch = static_cast< size_t >(srcLevel_.width) * channels_;
+            size_t dstPitch = static_cast< size_t >(dstLevel_.width) * channels_;
+
+            forBands(dstLevel_.height, dstLevel_.width * dstLevel_.height >= PARALLEL_TEXELS, [&](uint32_t begin_, uint32_t end_) {
+
+                for (uint32_t y = begin_; y < end_; y++) {
+
+                    boxRow(
+                        src_ + std::min(2 * y, srcLevel_.height - 1) * srcPitch,
+                        src_ + std::min(2 * y + 1, srcLevel_.height - 1) * srcPitch,
+                        dst_ + y * dstPitch,
+                        srcLevel_.width,
+                        dstLevel_.width,
+                        channels_,
+                        sRGB_
+                        );
+
+                }
+
+            });
+
+        }
+
+        /**
+            Computes the normalized weights of a Kaiser-windowed sinc for a 2:1 reduction
+        */
+        static void kaiserWeights(float weights_[KAISER_TAPS]) {
+
+            const float alpha   = 4.0f;
+            const float radius  = KAISER_TAPS / 2.0f;
+            const float pi      = 3.14159265358979f;
+
+            auto besselI0 = [](float x_) {
+
+                float sum = 1.0f;
+                float term = 1.0f;
+                for (int k = 1; k < 16; k++) {
+
+                    term *= (x_ / (2.0f * k)) * (x_ / (2.0f * k));
+                    sum += term;
+
+                }
+
+                return sum;
+
+            };
+
+            float total = 0.0f;
+            for (int i = 0; i < KAISER_TAPS; i++) {
+
+                float d         = i - radius + 0.5f;     // Distance of the tap from the output texel center in source texels
+                float x         = d / 2.0f;
+                float sinc      = std::sin(pi * x) / (pi * x);
+                float ratio     = d / radius;
+                float window    = besselI0(alpha * std::sqrt(std::max(0.0f, 1.0f - ratio * ratio))) / besselI0(alpha);
+
+                weights_[i]     = sinc * window;
+                total          += weights_[i];
+
+            }
+
+            for (int i = 0; i < KAISER_TAPS; i++) {
+
+                weights_[i] /= total;
+
+            }
+
+        }
+
+        static void kaiserLevel(const unsigned char* src_, const TextureLevel& srcLevel_, unsigned char* dst_, const TextureLevel& dstLevel_, uint32_t channels_, bool sRGB_) {
+
+            float weights[KAISER_TAPS];
+            kaiserWeights(weights);
+
+            const int offset    = KAISER_TAPS / 2 - 1;
+            size_t dstPitch     = static_cast< size_t >(dstLevel_.width) * channels_;
+            bool parallel       = dstLevel_.width * dstLevel_.height >= PARALLEL_TEXELS;
+
+            std::vector< float > horizontal(srcLevel_.height * dstPitch);
+
+            forBands(srcLevel_.height, parallel, [&](uint32_t begin_, uint32_t end_) {      // Horizontal pass, one filtered row per source row
+
+                for (uint32_t y = begin_; y < end_; y++) {
+
+                    const unsigned char* row    = src_ + static_cast< size_t >(y) * srcLevel_.width * channels_;
+                    float* out                  = horizontal.data() + y * dstPitch;
+
+                    for (uint32_t x = 0; x < dstLevel_.width; x++) {
+
+                        for (uint32_t c = 0; c < channels_; c++) {
+
+                            bool linear = sRGB_ && c < 3;
+                            float sum = 0.0f;
+
+                            for (int t = 0; t < KAISER_TAPS; t++) {
+
+                                int sx = std::clamp(static_cast< int >(2 * x) - offset + t, 0, static_cast< int >(srcLevel_.width) - 1);
+                                sum += weights[t] * decode(row[sx * channels_ + c], linear);
+
+                            }
+
+                            out[x * channels_ + c] = sum;
+
+                        }
+
+                    }
+
+                }
+
+            });
+
+            forBands(dstLevel_.height, parallel, [&](uint32_t begin_, uint32_t end_) {        // Vertical pass, vectorized along the row
+
+                std::vector< float > row(dstPitch);
+
+                for (uint32_t y = begin_; y < end_; y++) {
+
+                    std::fill(row.begin(), row.end(), 0.0f);
+
+                    for (int t = 0; t < KAISER_TAPS; t++) {
+
+                        int sy = std::clamp(static_cast< int >(2 * y) - offset + t, 0, static_cast< int >(srcLevel_.height) - 1);
+                        const float* in = horizontal.data() + sy * dstPitch;
+                        size_t i = 0;
+
+#ifdef VK_SSE2
+                        __m128 weight = _mm_set1_ps(weights[t]);
+                        for (; i + 4 <= dstPitch; i += 4) {
+
+                            _mm_storeu_ps(row.data() + i, _mm_add_ps(_mm_loadu_ps(row.data() + i), _mm_mul_ps(weight, _mm_loadu_ps(in + i))));
+
+                        }
+#endif
+                        for (; i < dstPitch; i++) {
+
+                            row[i] += weights[t] * in[i];
+
+                        }
+
+                    }
+
+                    unsigned char* out = dst_ + y * dstPitch;
+                    for (size_t i = 0; i < dstPitch; i++) {
+
+                        out[i] = encode(row[i], sRGB_ && (i % channels_) < 3);
+
+                    }
+
+                }
+
+            });
+
+        }
+
+        void generate(
+            unsigned char*                      chain_,
+            const std::vector< TextureLevel >&  levels_,
+            uint32_t                            channels_,
+            bool                                sRGB_,
+            MIPMAP_FILTER                       filter_
+            ) {
+
+            bool sRGB = sRGB_ && channels_ >= 3;        // One- and two-channel data is never color
+
+            for (size_t i = 1; i < levels_.size(); i++) {
+
+                const unsigned char* src    = chain_ + levels_[i - 1].offset;
+                unsigned char* dst          = chain_ + levels_[i].offset;
+
+                if (filter_ == MF_KAISER) {
+
+                    kaiserLevel(src, levels_[i - 1], dst, levels_[i], channels_, sRGB);
+
+                }
+                else {
+
+                    boxLevel(src, levels_[i - 1], dst, levels_[i], channels_, sRGB);
+
+                }
+
+            }
+
+        }
+
+    }
+
+}
@@ -0,0 +1,47 @@
+/**
+    Prototypes the mipmaps namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         MipmapGenerator.hpp
+    @brief        Prototype of the mipmaps namespace, a parallel CPU mipmap generator
+*/
+#ifndef MIPMAP_GENERATOR_HPP
+#define MIPMAP_GENERATOR_HPP
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+#include "Makros.hpp"
+#include "TextureLevel.cpp"
+#include "MIPMAP_FILTER.cpp"
+
+namespace vk {
+
+    /**
+        Generates mip chains of 8-bit-per-channel images on the CPU, independent of the formats the device can blit
+    */
+    namespace mipmaps {
+
+        /**
+            Fills levels 1 to n of a mip chain from level 0, each level is downsampled from the previous one and large levels are split into row bands across cores
+
+            @param      chain_          Pointer to the tightly packed mip chain, level 0 must already be in place
+            @param      levels_         The mip levels, offsets are relative to chain_
+            @param      channels_       The number of 8-bit channels per texel (1 to 4)
+            @param      sRGB_           Whether the color channels are sRGB-encoded and have to be averaged in linear space
+            @param      filter_         The downsampling filter
+        */
+        void generate(
+            unsigned char*                      chain_,
+            const std::vector< TextureLevel >&  levels_,
+            uint32_t                            channels_,
+            bool                                sRGB_,
+            MIPMAP_FILTER                       filter_
+            );
+
+    }
+
+}
+#endif  // MIPMAP_GENERATOR_HPP
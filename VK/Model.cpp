@@ -11,12 +11,72 @@
 #include "VK.hpp"
 #include "ASSERT.cpp"
 
+#include "FileIO.hpp"
+#include "AssimpIOSystem.hpp"
+#include "FileStreamBuffer.hpp"
+
+#include <istream>
+
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tiny_obj_loader.h>
 
-Model::Model(const char* path_, GraphicsPipeline& pipeline_, VKEngineModelLoadingLib lib_, glm::mat4 (*modelMatrixFunc_)()) : pipeline(pipeline_) {
+namespace {
+
+    /**
+        Resolves tinyobj material libraries relative to the model and reads them through the io namespace
+    */
+    class FileMaterialReader : public tinyobj::MaterialReader {
+    public:
+
+        explicit FileMaterialReader(const std::string& directory_) : directory(directory_) {}
+
+        bool operator()(
+            const std::string&                  matId_,
+            std::vector< tinyobj::material_t >* materials_,
+            std::map< std::string, int >*       matMap_,
+            std::string*                        warn_,
+            std::string*                        err_
+            ) override {
+
+            std::shared_ptr< FileData > file = vk::io::read(directory + '/' + matId_);
+            if (!file) {
+
+                if (warn_) *warn_ += "Material file [ " + directory + '/' + matId_ + " ] not found.\n";
+                return false;
+
+            }
+
+            FileStreamBuffer buffer(file);
+            std::istream stream(&buffer);
+            tinyobj::LoadMtl(matMap_, materials_, &stream, warn_, err_);
+
+            return true;
+
+        }
+
+    private:
 
+        std::string         directory;
+
+    };
+
+}
+
+Model::Model(
+    const char*                 path_,
+    GraphicsPipeline&           pipeline_,
+    VKEngineModelLoadingLib     lib_,
+    glm::mat4                   (*modelMatrixFunc_)(),
+    ModelLoadProgress*          progress_,
+    const glm::mat4&            transform_
+    ) : pipeline(pipeline_) {
+
+    path        = path_;
+    lib         = lib_;
     modelMatrix = modelMatrixFunc_;
+    transform   = transform_;
+    progress    = progress_;
+    advance(LS_PARSE);
 
     VK_STATUS_CODE result;
 
@@ -33,6 +93,71 @@ Model::Model(const char* path_, GraphicsPipeline& pipeline_, VKEngineModelLoadin
 
     ASSERT(result, "Error loading model using ASSIMP", VK_SC_RESOURCE_LOADING_ERROR);
 
+    progress = nullptr;
+
+}
+
+const std::string& Model::getPath() {
+
+    return path;
+
+}
+
+std::function< Model*() > Model::reloader() {
+
+    return [path = path, pipeline = pipeline, lib = lib, modelMatrix = modelMatrix, transform = transform]() mutable {
+
+        return new Model(path.c_str(), pipeline, lib, modelMatrix, nullptr, transform);
+
+    };
+
+}
+
+void Model::swap(Model& other_) {
+
+    std::swap(meshes,           other_.meshes);
+    std::swap(texturesLoaded,   other_.texturesLoaded);
+    std::swap(directory,        other_.directory);
+
+}
+
+uint32_t Model::retarget(const std::string& path_, TextureImage* from_, TextureImage* to_) {
+
+    uint32_t moved = 0;
+
+    std::scoped_lock< std::mutex > lock(texturesMutex);
+    for (auto& texture : texturesLoaded) {
+
+        if (texture.img != from_ || vk::io::canonicalPath(directory + '/' + texture.path) != path_) continue;
+
+        texture.img = to_;
+        moved++;
+
+    }
+
+    if (moved == 0) return 0;
+
+    for (auto mesh : meshes) {
+
+        for (auto& texture : mesh->textures) {
+
+            if (texture.img == from_ && vk::io::canonicalPath(directory + '/' + texture.path) == path_) texture.img = to_;
+
+        }
+
+    }
+
+    return moved;
+
+}
+
+void Model::advance(LOAD_STAGE stage_) {
+
+    if (progress == nullptr) return;
+
+    LOAD_STAGE current = progress->stage;
+    while (current < stage_ && !progress->stage.compare_exchange_weak(current, stage_));
+
 }
 
 void Model::bind() {
@@ -52,19 +177,41 @@ VK_STATUS_CODE Model::loadOBJTINYOBJ(const char* path_) {
     std::vector< tinyobj::material_t >      materials;
     std::string warn, err;
 
-    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path_)) {
+    std::shared_ptr< FileData > file = vk::io::read(path_);
+    if (!file) {
+
+        logger::log(ERROR_LOG, "Failed to load model at " + std::string(path_));
+
+    }
+
+    FileStreamBuffer buffer(file);
+    std::istream stream(&buffer);
+    FileMaterialReader materialReader((std::string(path_)).substr(0, (std::string(path_)).find_last_of("/")));
+
+    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, &stream, &materialReader)) {
 
         logger::log(ERROR_LOG, warn + err);
 
     }
 
-    for (const auto& shape : shapes) {
+    meshes.resize(shapes.size());
+
+    if (progress != nullptr) progress->meshes = static_cast< uint32_t >(shapes.size());
+    advance(LS_PROCESS);
+
+    std::vector< JobHandle > tasks;
+    for (size_t i = 0; i < shapes.size(); i++) {
     
-        tinyobj::mesh_t mesh = (shape.mesh);
-        meshes.push_back(processTINYOBJMesh(reinterpret_cast< void* >(&mesh), &attrib));
+        tasks.push_back(vk::core::jobSystem->submit([this, &shapes, &attrib, i]() {
+
+            meshes[i] = processTINYOBJMesh(reinterpret_cast< void* >(&shapes[i].mesh), &attrib);
+
+            }));
     
     }
 
+    vk::core::jobSystem->wait(tasks);
+
     return vk::errorCodeBuffer;
 
 }
@@ -72,6 +219,7 @@ VK_STATUS_CODE Model::loadOBJTINYOBJ(const char* path_) {
 VK_STATUS_CODE Model::loadOBJASSIMP(const char* path_) {
 
     Assimp::Importer importer;
+    importer.SetIOHandler(new AssimpIOSystem());        // Owned and deleted by the importer
     const aiScene* scene = importer.ReadFile(path_, aiProcess_Triangulate | aiProcess_FlipUVs);
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
@@ -84,27 +232,46 @@ VK_STATUS_CODE Model::loadOBJASSIMP(const char* path_) {
     }
 
     directory = (std::string(path_)).substr(0, (std::string(path_)).find_last_of("/"));
-    processASSIMPNode(scene->mRootNode, scene);
+
+    std::vector< aiMesh* > sceneMeshes;
+    processASSIMPNode(scene->mRootNode, scene, sceneMeshes);
+
+    meshes.resize(sceneMeshes.size());      // Every task writes its own slot, so the mesh order matches the node tree regardless of completion order
+
+    if (progress != nullptr) progress->meshes = static_cast< uint32_t >(sceneMeshes.size());
+    advance(LS_PROCESS);
+
+    std::vector< JobHandle > tasks;
+    for (size_t i = 0; i < sceneMeshes.size(); i++) {
+
+        tasks.push_back(vk::core::jobSystem->submit([this, scene, &sceneMeshes, i]() {
+
+            meshes[i] = processASSIMPMesh(sceneMeshes[i], scene);
+
+            }));
+
+    }
+
+    vk::core::jobSystem->wait(tasks);
 
     return vk::errorCodeBuffer;
 
 }
 
 
-void Model::processASSIMPNode(aiNode* node_, const aiScene* scene_) {
+void Model::processASSIMPNode(aiNode* node_, const aiScene* scene_, std::vector< aiMesh* >& meshes_) {
 
-    // Process each of the meshes using iteration
+    // Collect each of the meshes using iteration
     for (uint32_t i = 0; i < node_->mNumMeshes; i++) {
     
-        aiMesh* mesh = scene_->mMeshes[node_->mMeshes[i]];
-        meshes.push_back(processASSIMPMesh(mesh, scene_));
+        meshes_.push_back(scene_->mMeshes[node_->mMeshes[i]]);
     
     }
 
     // Process each of ASSIMP's node's children using recursion in the same way
     for (uint32_t i = 0; i < node_->mNumChildren; i++) {
     
-        processASSIMPNode(node_->mChildren[i], scene_);
+        processASSIMPNode(node_->mChildren[i], scene_, meshes_);
     
     }
 
@@ -187,6 +354,9 @@ Mesh* Model::processASSIMPMesh(aiMesh* mesh_, const aiScene* scene_) {
         
     }
 #endif
+    if (progress != nullptr) progress->meshesProcessed++;
+    advance(LS_DECODE);
+
     std::vector< TextureObject > textures;
 
     aiMaterial* material = scene_->mMaterials[mesh_->mMaterialIndex];
@@ -202,12 +372,16 @@ Mesh* Model::processASSIMPMesh(aiMesh* mesh_, const aiScene* scene_) {
     std::vector< TextureObject > heightMaps = loadASSIMPMaterialTextures(material, aiTextureType_HEIGHT, TT_HEIGHT);
     textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
 
-    return new Mesh(
+    advance(LS_UPLOAD);
+    Mesh* mesh = new Mesh(
         pipeline, 
         vertices, 
         indices, 
         textures
         );
+    if (progress != nullptr) progress->meshesUploaded++;
+
+    return mesh;
 
 }
 
@@ -247,12 +421,18 @@ Mesh* Model::processTINYOBJMesh(void* mesh_, void* attrib_) {
 
     }
 
-    return new Mesh(
+    if (progress != nullptr) progress->meshesProcessed++;
+    advance(LS_UPLOAD);         // tinyobj meshes carry no textures, there is nothing to decode
+
+    Mesh* result = new Mesh(
         pipeline, 
         vertices, 
         indices, 
         textures
         );
+    if (progress != nullptr) progress->meshesUploaded++;
+
+    return result;
 
 }
 
@@ -265,33 +445,18 @@ std::vector< TextureObject > Model::loadASSIMPMaterialTextures(aiMaterial* mater
         aiString texturePath;
         material_->GetTexture(type_, i, &texturePath);
 
-        bool skip = false;
+        if (progress != nullptr) progress->texturesRequested++;
 
-        for (uint32_t j = 0; j < texturesLoaded.size(); j++) {
+        TextureObject texture;
+        texture.img                         = textureFromFile(texturePath.C_Str(), directory);
+        texture.type                        = typeID_;
+        texture.path                        = texturePath.C_Str();
 
-            if (std::strcmp(texturesLoaded[j].path.data(), texturePath.C_Str()) == 0) {
+        textures.push_back(texture);
+        if (progress != nullptr) progress->texturesDecoded++;
 
-                textures.push_back(texturesLoaded[j]);
-                skip = true;
-                break;
-
-            }
-
-        }
-
-        if (!skip) {
-
-            logger::log(EVENT_LOG, "Loading texture at: " + directory + '/' + texturePath.C_Str());
-
-            TextureObject texture;
-            texture.img                         = textureFromFile(texturePath.C_Str(), directory);
-            texture.type                        = typeID_;
-            texture.path                        = texturePath.C_Str();
-
-            textures.push_back(texture);
-            texturesLoaded.push_back(texture);
-
-        }
+        std::scoped_lock< std::mutex > lock(texturesMutex);
+        texturesLoaded.push_back(texture);      // Every acquired reference is released again in the destructor
 
     }
 
@@ -303,20 +468,37 @@ TextureImage* Model::textureFromFile(const char *path_, const std::string& direc
 
     std::string path = std::string(directory + '/' + path_);
 
-    TextureImage* img = new TextureImage(
-        path.c_str(),
-        VK_FORMAT_R8G8B8A8_UNORM,
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
-        );
-
-    return img;
+    return vk::textures::acquire(path, VK_FORMAT_R8G8B8A8_UNORM);
     
 }
 
 glm::mat4 Model::getModelMatrix() {
 
-    return (*modelMatrix)();
+    return modelMatrix != nullptr ? (*modelMatrix)() : transform;
+
+}
+
+VkDeviceSize Model::getResidentSize() {
+
+    VkDeviceSize size = 0;
+
+    for (auto mesh : meshes) {
+
+        size += mesh->vertices.size() * sizeof(BaseVertex) + mesh->indices.size() * sizeof(uint32_t);
+
+    }
+
+    std::vector< TextureImage* > counted;
+    for (const auto& texture : texturesLoaded) {
+
+        if (std::find(counted.begin(), counted.end(), texture.img) != counted.end()) continue;
+
+        counted.push_back(texture.img);
+        size += texture.img->getResidentSize();
+
+    }
+
+    return size;
 
 }
 
@@ -324,7 +506,7 @@ Model::~Model() {
 
     for (auto img : texturesLoaded) {
     
-        delete img.img;
+        vk::textures::release(img.img);
     
     }
 
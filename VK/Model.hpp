@@ -15,9 +15,11 @@
 #include <glm/glm.hpp>
 
 #include <functional>
+#include <mutex>
 
 #include "GraphicsPipeline.hpp"
 #include "Mesh.hpp"
+#include "ModelLoadProgress.cpp"
 
 /**
     Defines an enumeration for different model loading libraries to choose from
@@ -43,8 +45,17 @@ public:
         @param      pipeline_           The pipeline to render the model with
         @param      lib_                The VKEngineModelLoadingLib flag to tell the Model loader which library to use
         @param      modelMatrixFunc_    A function pointer to calculcate the model matrix for the model
+        @param      progress_           Optional per-stage progress to report to while loading
+        @param      transform_          The fixed model matrix to use if modelMatrixFunc_ is nullptr
     */
-    Model(const char* path_, GraphicsPipeline& pipeline_, VKEngineModelLoadingLib lib_, glm::mat4 (*modelMatrixFunc_)());
+    Model(
+        const char*                 path_,
+        GraphicsPipeline&           pipeline_,
+        VKEngineModelLoadingLib     lib_,
+        glm::mat4                   (*modelMatrixFunc_)(),
+        ModelLoadProgress*          progress_           = nullptr,
+        const glm::mat4&            transform_          = glm::mat4(1.0f)
+        );
 
     /**
         Returns the models model-matrix
@@ -53,6 +64,47 @@ public:
      */
     glm::mat4 getModelMatrix(void);
 
+    /**
+        Estimates the device memory the model keeps alive, textures shared with other models are counted in full
+
+        @return     Returns the size of the vertex, index and texture data in bytes
+    */
+    VkDeviceSize getResidentSize(void);
+
+    /**
+        Returns the path the model was loaded from
+
+        @return     Returns the (relative) path to the model file
+    */
+    const std::string& getPath(void);
+
+    /**
+        Returns a callable that loads the model again from its file, with the same pipeline, loader and placement. The
+        callable copies what it needs, so it may run after this model has been destroyed.
+
+        @return     Returns the callable, which returns the freshly loaded model
+    */
+    std::function< Model*() > reloader(void);
+
+    /**
+        Exchanges the meshes and textures with another model, so a reloaded model takes the place of this one without
+        any pointer to it changing
+
+        @param      other_      The model to exchange the geometry with
+    */
+    void swap(Model& other_);
+
+    /**
+        Moves the textures loaded from a path over to another texture, the references move along with them
+
+        @param      path_       The canonical path of the texture file
+        @param      from_       The texture the path was resolved to
+        @param      to_         The texture to use instead
+
+        @return     Returns the number of references moved, each has to be accounted for in the texture registry
+    */
+    uint32_t retarget(const std::string& path_, TextureImage* from_, TextureImage* to_);
+
     /**
         Binds the model and the correct uniforms
     */
@@ -65,9 +117,21 @@ public:
 
 private:
 
+    std::string                                                 path;
+    VKEngineModelLoadingLib                                     lib;
     std::string                                                 directory;
     std::vector< TextureObject >                                texturesLoaded;
+    std::mutex                                                  texturesMutex;
     glm::mat4                                                   (*modelMatrix)();
+    glm::mat4                                                   transform;
+    ModelLoadProgress*                                          progress            = nullptr;      // Only valid during construction
+
+    /**
+        Moves the reported stage forward, never backward, as meshes are processed in parallel
+
+        @param      stage_      The stage a part of the model has reached
+    */
+    void advance(LOAD_STAGE stage_);
 
     /**
         Handles and coordinates all loading actions for the specified file, using ASSIMP
@@ -88,12 +152,13 @@ private:
     VK_STATUS_CODE loadOBJTINYOBJ(const char* path_);
 
     /**
-        Helper function for ASSIMP's node-loading system
+        Helper function for ASSIMP's node-loading system, collects the meshes of the node tree in depth-first order
 
         @param      node_       A pointer to ASSIMP's node
         @param      scene_      A pointer to ASSIMP's scene
+        @param      meshes_     The list to append the node's meshes to
     */
-    void processASSIMPNode(aiNode* node_, const aiScene* scene_);
+    void processASSIMPNode(aiNode* node_, const aiScene* scene_, std::vector< aiMesh* >& meshes_);
 
     /**
         Helper function for ASSIMP's mesh-loading system
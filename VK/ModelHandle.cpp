@@ -0,0 +1,112 @@
+/**
+    Implements the ModelHandle class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         ModelHandle.cpp
+    @brief        Implementation of the ModelHandle class, a handle to an asynchronous model load
+*/
+#include "ModelHandle.hpp"
+
+#include <chrono>
+
+
+ModelLoadRequest::ModelLoadRequest(const ModelInfo& info_, float bias_) : info(info_) {
+
+    position    = glm::vec3((info_.modelMatrixFunc != nullptr ? (*info_.modelMatrixFunc)() : info_.transform)[3]);
+    bias        = bias_;
+    priority    = -bias_;
+    future      = promise.get_future().share();
+
+}
+
+ModelHandle::ModelHandle() {
+
+
+
+}
+
+ModelHandle::ModelHandle(std::shared_ptr< ModelLoadRequest > request_) : request(std::move(request_)) {
+
+
+
+}
+
+bool ModelHandle::cancel() {
+
+    LOAD_STAGE expected = LS_QUEUED;
+    if (!request || !request->progress.stage.compare_exchange_strong(expected, LS_CANCELLED)) {
+
+        return false;
+
+    }
+
+    request->promise.set_value(nullptr);        // The scheduler drops cancelled requests the next time it sees them
+
+    return true;
+
+}
+
+LOAD_STAGE ModelHandle::stage() const {
+
+    return request ? request->progress.stage.load() : LS_CANCELLED;
+
+}
+
+float ModelHandle::progress(LOAD_STAGE stage_) const {
+
+    if (!request) return 0.0f;
+
+    const ModelLoadProgress& progress = request->progress;
+    LOAD_STAGE current = progress.stage;
+
+    if (current == LS_CANCELLED || current == LS_FAILED || current < stage_) return 0.0f;
+    if (current == LS_DONE) return 1.0f;
+
+    auto fraction = [](uint32_t done_, uint32_t total_) {
+
+        return total_ == 0 ? 1.0f : static_cast< float >(done_) / static_cast< float >(total_);
+
+    };
+
+    switch (stage_) {
+
+    case LS_PARSE:
+        return current > LS_PARSE ? 1.0f : 0.0f;
+    case LS_PROCESS:
+        return current == LS_PROCESS && progress.meshes == 0 ? 0.0f : fraction(progress.meshesProcessed, progress.meshes);
+    case LS_DECODE:
+        return fraction(progress.texturesDecoded, progress.texturesRequested);
+    case LS_UPLOAD:
+        return fraction(progress.meshesUploaded, progress.meshes);
+    default:
+        return 0.0f;
+
+    }
+
+}
+
+bool ModelHandle::ready() const {
+
+    return request && request->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+
+}
+
+Model* ModelHandle::wait() const {
+
+    return request ? request->future.get() : nullptr;
+
+}
+
+std::shared_future< Model* > ModelHandle::future() const {
+
+    return request ? request->future : std::shared_future< Model* >();
+
+}
+
+bool ModelHandle::valid() const {
+
+    return static_cast< bool >(request);
+
+}
@@ -0,0 +1,117 @@
+/**
+    Declares the ModelHandle class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         ModelHandle.hpp
+    @brief        Declaration of the ModelHandle class, a handle to an asynchronous model load
+*/
+#ifndef MODEL_HANDLE_HPP
+#define MODEL_HANDLE_HPP
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <future>
+#include <memory>
+
+#include "Model.hpp"
+#include "ModelInfo.cpp"
+#include "ModelLoadProgress.cpp"
+
+/**
+    A queued or running model load, shared between the scheduler, the loading job and every handle
+*/
+struct ModelLoadRequest {
+
+    ModelInfo                                   info;
+    glm::vec3                                   position;               // World-space origin of the model, distance to the camera decides the order
+    float                                       bias;                   // Subtracted from the distance, larger values load earlier
+    float                                       priority;               // Lower values load first, refreshed by LoadScheduler::reprioritize
+    ModelLoadProgress                           progress;
+    std::promise< Model* >                      promise;
+    std::shared_future< Model* >                future;
+
+    /**
+        Constructor
+
+        @param      info_       The model to load
+        @param      bias_       The priority bias
+    */
+    ModelLoadRequest(const ModelInfo& info_, float bias_);
+
+};
+
+class ModelHandle
+{
+public:
+
+    /**
+        Default constructor, creates a handle that refers to no load
+    */
+    ModelHandle(void);
+
+    /**
+        Constructor
+
+        @param      request_        The load to refer to
+    */
+    explicit ModelHandle(std::shared_ptr< ModelLoadRequest > request_);
+
+    /**
+        Cancels the load if no work has started on it yet
+
+        @return     Returns true if the load was cancelled, false if it is already running or finished
+    */
+    bool cancel(void);
+
+    /**
+        Returns the furthest stage the load has reached
+
+        @return     Returns the current LOAD_STAGE
+    */
+    LOAD_STAGE stage(void) const;
+
+    /**
+        Returns the progress within a stage
+
+        @param      stage_      The stage to query, one of LS_PARSE, LS_PROCESS, LS_DECODE and LS_UPLOAD
+
+        @return     Returns a value between 0.0 and 1.0
+    */
+    float progress(LOAD_STAGE stage_) const;
+
+    /**
+        Polls for completion without blocking
+
+        @return     Returns true once the model is ready, the load was cancelled or it failed
+    */
+    bool ready(void) const;
+
+    /**
+        Blocks until the load has completed, the render loop owns the returned model
+
+        @return     Returns the model, nullptr if the load was cancelled, rethrows if it failed
+    */
+    Model* wait(void) const;
+
+    /**
+        Returns the future the load completes
+
+        @return     Returns a std::shared_future< Model* >
+    */
+    std::shared_future< Model* > future(void) const;
+
+    /**
+        Returns whether the handle refers to a load
+
+        @return     Returns true if it does
+    */
+    bool valid(void) const;
+
+private:
+
+    std::shared_ptr< ModelLoadRequest >         request;
+
+};
+#endif  // MODEL_HANDLE_HPP
@@ -0,0 +1,61 @@
+/**
+    Implements the ModelHandoff class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         ModelHandoff.cpp
+    @brief        Implementation of the ModelHandoff class, a lock-free handoff of loaded models to the render loop
+*/
+#include "ModelHandoff.hpp"
+
+#include <algorithm>
+
+#include "Model.hpp"
+
+
+void ModelHandoff::publish(Model* model_) {
+
+    Node* node  = new Node();
+    node->model = model_;
+    node->next  = head.load(std::memory_order_relaxed);
+
+    while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+
+}
+
+size_t ModelHandoff::adopt(std::vector< Model* >& models_) {
+
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);       // Taking the whole list at once rules out ABA on the consumer side
+
+    size_t first = models_.size();
+    size_t count = 0;
+
+    while (node != nullptr) {
+
+        Node* next = node->next;
+        models_.push_back(node->model);
+        delete node;
+        node = next;
+        count++;
+
+    }
+
+    std::reverse(models_.begin() + first, models_.end());       // The stack hands out the newest model first
+
+    return count;
+
+}
+
+ModelHandoff::~ModelHandoff() {
+
+    std::vector< Model* > orphans;
+    adopt(orphans);
+
+    for (auto model : orphans) {
+
+        delete model;
+
+    }
+
+}
@@ -0,0 +1,58 @@
+/**
+    Declares the ModelHandoff class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         ModelHandoff.hpp
+    @brief        Declaration of the ModelHandoff class, a lock-free handoff of loaded models to the render loop
+*/
+#ifndef MODEL_HANDOFF_HPP
+#define MODEL_HANDOFF_HPP
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+class Model;
+
+/**
+    Multi-producer, single-consumer stack: loader jobs publish finished models, the render loop adopts all of them at once
+*/
+class ModelHandoff
+{
+public:
+
+    /**
+        Hands a fully uploaded model over to the render loop, callable from any thread
+
+        @param      model_      The model to publish
+    */
+    void publish(Model* model_);
+
+    /**
+        Moves every model published since the last call to the end of a vector, in publication order
+
+        @param      models_     The vector to append to
+
+        @return     Returns the number of models adopted
+    */
+    size_t adopt(std::vector< Model* >& models_);
+
+    /**
+        Default destructor, frees models that were published but never adopted
+    */
+    ~ModelHandoff(void);
+
+private:
+
+    struct Node {
+
+        Model*          model;
+        Node*           next;
+
+    };
+
+    std::atomic< Node* >        head        = { nullptr };
+
+};
+#endif  // MODEL_HANDOFF_HPP
@@ -20,6 +20,7 @@ struct ModelInfo {
     GraphicsPipeline&               pipeline;
     VKEngineModelLoadingLib         lib;
     glm::mat4                       (*modelMatrixFunc)();
+    glm::mat4                       transform               = glm::mat4(1.0f);      // Used instead of modelMatrixFunc if that is nullptr
 
 };
 #endif  // MODEL_INFO_CPP
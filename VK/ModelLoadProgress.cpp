@@ -0,0 +1,30 @@
+/**
+    Defines the ModelLoadProgress struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         ModelLoadProgress.cpp
+    @brief        Definition of the ModelLoadProgress struct
+*/
+#ifndef MODEL_LOAD_PROGRESS_CPP
+#define MODEL_LOAD_PROGRESS_CPP
+#include <atomic>
+#include <cstdint>
+
+#include "LOAD_STAGE.cpp"
+
+/**
+    Holds the progress of a single model load, written by the loading jobs and read by any thread
+*/
+struct ModelLoadProgress {
+
+    std::atomic< LOAD_STAGE >       stage                   = { LS_QUEUED };        // Furthest stage any mesh of the model has reached
+    std::atomic< uint32_t >         meshes                  = { 0 };                // Known once parsing has finished
+    std::atomic< uint32_t >         meshesProcessed         = { 0 };
+    std::atomic< uint32_t >         texturesRequested       = { 0 };
+    std::atomic< uint32_t >         texturesDecoded         = { 0 };
+    std::atomic< uint32_t >         meshesUploaded          = { 0 };
+
+};
+#endif  // MODEL_LOAD_PROGRESS_CPP
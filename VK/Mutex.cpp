@@ -0,0 +1,206 @@
+/**
+    Implements the Mutex class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Mutex.cpp
+    @brief        Implementation of the Mutex class, a named std::mutex that records its contention with VK_LOCK_PROFILING
+*/
+#include "Mutex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <string>
+
+#include "Logger.hpp"
+#include "Metrics.hpp"
+
+/**
+    The contention of every Mutex sharing a name
+*/
+struct LockProfile {
+
+    std::string                                     name;
+    std::atomic< uint64_t >                         acquisitions            = { 0 };
+    std::atomic< uint64_t >                         contended               = { 0 };
+    std::atomic< uint64_t >                         wait                    = { 0 };
+    std::atomic< uint64_t >                         maxWait                 = { 0 };
+    std::atomic< uint64_t >                         hold                    = { 0 };
+    std::atomic< uint64_t >                         maxHold                 = { 0 };
+    Histogram*                                      waitMetric              = nullptr;
+    Histogram*                                      holdMetric              = nullptr;
+
+};
+
+namespace {
+
+    /**
+        Every lock profile, built on first use since most mutexes are globals constructed by static initializers
+    */
+    struct Registry {
+
+        std::mutex                                  mutex;                  // A plain std::mutex, only taken to register and to take a snapshot
+        std::deque< LockProfile >                   profiles;               // A deque keeps the profiles in place as it grows
+
+    };
+
+    Registry& registry() {
+
+        static Registry instance;
+
+        return instance;
+
+    }
+
+#ifdef VK_LOCK_PROFILING
+    void raise(std::atomic< uint64_t >& max_, uint64_t value_) {
+
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (value_ > max && !max_.compare_exchange_weak(max, value_, std::memory_order_relaxed));
+
+    }
+#endif
+
+}
+
+#ifdef VK_LOCK_PROFILING
+Mutex::Mutex(const char* name_) {
+
+    Registry& locks = registry();
+    std::scoped_lock< std::mutex > lock(locks.mutex);
+
+    for (auto& existing : locks.profiles) {
+
+        if (existing.name != name_) continue;
+
+        profile = &existing;
+
+        return;
+
+    }
+
+    locks.profiles.emplace_back();
+    profile             = &locks.profiles.back();
+    profile->name       = name_;
+    profile->waitMetric = vk::metrics::histogram("sync_lock_" + profile->name + "_wait_ns", "Time spent waiting to acquire the " + profile->name + " lock in nanoseconds");
+    profile->holdMetric = vk::metrics::histogram("sync_lock_" + profile->name + "_hold_ns", "Time the " + profile->name + " lock was held in nanoseconds");
+
+}
+
+void Mutex::lock() {
+
+    uint64_t waited = 0;
+
+    if (!mutex.try_lock()) {
+
+        auto requested = std::chrono::steady_clock::now();
+        mutex.lock();
+        acquired = std::chrono::steady_clock::now();
+
+        waited = static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(acquired - requested).count());
+        profile->contended.fetch_add(1, std::memory_order_relaxed);
+        profile->wait.fetch_add(waited, std::memory_order_relaxed);
+        raise(profile->maxWait, waited);
+
+    }
+    else {
+
+        acquired = std::chrono::steady_clock::now();
+
+    }
+
+    profile->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    profile->waitMetric->observe(waited);
+
+}
+
+bool Mutex::try_lock() {
+
+    if (!mutex.try_lock()) return false;        // Gave up instead of waiting, so not counted as contention
+
+    acquired = std::chrono::steady_clock::now();
+    profile->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    profile->waitMetric->observe(0);
+
+    return true;
+
+}
+
+void Mutex::unlock() {
+
+    uint64_t held = static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now() - acquired).count());
+    mutex.unlock();
+
+    profile->hold.fetch_add(held, std::memory_order_relaxed);
+    raise(profile->maxHold, held);
+    profile->holdMetric->observe(held);
+
+}
+#endif
+
+namespace vk {
+
+    namespace locks {
+
+        std::vector< LockStats > stats() {
+
+            Registry& locks = registry();
+            std::vector< LockStats > snapshot;
+
+            {
+
+                std::scoped_lock< std::mutex > lock(locks.mutex);
+                snapshot.reserve(locks.profiles.size());
+
+                for (const auto& profile : locks.profiles) {
+
+                    LockStats entry             = {};
+                    entry.name                  = profile.name;
+                    entry.acquisitions          = profile.acquisitions.load(std::memory_order_relaxed);
+                    entry.contended             = profile.contended.load(std::memory_order_relaxed);
+                    entry.waitNanoseconds       = profile.wait.load(std::memory_order_relaxed);
+                    entry.maxWaitNanoseconds    = profile.maxWait.load(std::memory_order_relaxed);
+                    entry.holdNanoseconds       = profile.hold.load(std::memory_order_relaxed);
+                    entry.maxHoldNanoseconds    = profile.maxHold.load(std::memory_order_relaxed);
+                    snapshot.push_back(entry);
+
+                }
+
+            }
+
+            std::sort(snapshot.begin(), snapshot.end(), [](const LockStats& a_, const LockStats& b_) {
+
+                return a_.waitNanoseconds > b_.waitNanoseconds;
+
+                });
+
+            return snapshot;
+
+        }
+
+        void logStats(uint32_t count_) {
+
+            std::vector< LockStats > snapshot = stats();
+            if (snapshot.size() > count_) snapshot.resize(count_);
+
+            logger::log(EVENT_LOG, "Most contended locks:");
+            for (const auto& entry : snapshot) {
+
+                logger::log(EVENT_LOG, "    " + entry.name + ": "
+                    + std::to_string(entry.acquisitions) + " acquisitions, "
+                    + std::to_string(entry.contended) + " contended, waited "
+                    + std::to_string(entry.waitNanoseconds / 1000) + " us (longest "
+                    + std::to_string(entry.maxWaitNanoseconds / 1000) + " us), held "
+                    + std::to_string(entry.holdNanoseconds / 1000) + " us (longest "
+                    + std::to_string(entry.maxHoldNanoseconds / 1000) + " us)"
+                    );
+
+            }
+
+        }
+
+    }
+
+}
@@ -0,0 +1,114 @@
+/**
+    Declares the Mutex class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Mutex.hpp
+    @brief        Declaration of the Mutex class, a named std::mutex that records its contention with VK_LOCK_PROFILING
+*/
+#ifndef MUTEX_HPP
+#define MUTEX_HPP
+#include "Version.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "LockStats.cpp"
+
+struct LockProfile;
+
+/**
+    A std::mutex with a name, usable with std::scoped_lock and std::unique_lock. Without VK_LOCK_PROFILING it only
+    forwards to the std::mutex. With it every acquisition is counted, and the time spent waiting for and holding the
+    lock is recorded per name.
+*/
+class Mutex {
+public:
+
+    /**
+        Constructor
+
+        @param      name_       The name the lock is reported under, a snake case identifier
+    */
+    explicit Mutex(const char* name_);
+
+    Mutex(const Mutex&) = delete;
+    Mutex& operator=(const Mutex&) = delete;
+
+    /**
+        Locks the mutex, blocking until it is available
+    */
+    void lock(void);
+
+    /**
+        Tries to lock the mutex without blocking
+
+        @return     Returns true if the mutex was locked
+    */
+    bool try_lock(void);
+
+    /**
+        Unlocks the mutex, has to be called by the thread that locked it
+    */
+    void unlock(void);
+
+private:
+
+    std::mutex                                      mutex;
+#ifdef VK_LOCK_PROFILING
+    LockProfile*                                    profile;
+    std::chrono::steady_clock::time_point           acquired;                   // Only written by the holder
+#endif
+
+};
+
+#ifndef VK_LOCK_PROFILING
+inline Mutex::Mutex(const char*) {}
+
+inline void Mutex::lock() {
+
+    mutex.lock();
+
+}
+
+inline bool Mutex::try_lock() {
+
+    return mutex.try_lock();
+
+}
+
+inline void Mutex::unlock() {
+
+    mutex.unlock();
+
+}
+#endif
+
+namespace vk {
+
+    /**
+        Reports the contention of every Mutex, empty without VK_LOCK_PROFILING
+    */
+    namespace locks {
+
+        /**
+            Returns the statistics of every named lock, most contended first
+
+            @return     Returns the LockStats of every lock, sorted by the time spent waiting for it
+        */
+        std::vector< LockStats > stats(void);
+
+        /**
+            Writes the most contended locks to the event log
+
+            @param      count_      The number of locks to write
+        */
+        void logStats(uint32_t count_ = 8);
+
+    }
+
+}
+#endif  // MUTEX_HPP
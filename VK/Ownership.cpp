@@ -0,0 +1,242 @@
+/**
+    Implements the ownership namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Ownership.cpp
+    @brief        Implementation of the ownership namespace, hands uploaded resources from the transfer to the graphics queue
+*/
+#include "Ownership.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "VK.hpp"
+
+namespace vk {
+
+    namespace ownership {
+
+        namespace {
+
+            /**
+                Acquire barriers that still have to be recorded on the graphics queue
+            */
+            struct Acquires {
+
+                std::vector< VkBufferMemoryBarrier >            buffers;
+                std::vector< VkImageMemoryBarrier >             images;
+                VkPipelineStageFlags                            stages          = 0;        // Every stage that reads one of the resources
+
+                void clear() {
+
+                    buffers.clear();
+                    images.clear();
+                    stages = 0;
+
+                }
+
+            };
+
+            uint32_t                                            graphicsFamily              = VK_QUEUE_FAMILY_IGNORED;
+            uint32_t                                            transferFamily              = VK_QUEUE_FAMILY_IGNORED;
+            thread_local Acquires                               recorded;                               // Released by this thread's submissions that may still be executing
+            std::mutex                                          publishedMutex;
+            Acquires                                            published;
+            Acquires                                            acquiring;                              // Only touched by the render loop
+            std::atomic< uint64_t >                             bufferCount                 = 0;
+            std::atomic< uint64_t >                             imageCount                  = 0;
+            std::atomic< uint64_t >                             acquireCount                = 0;
+            std::atomic< uint64_t >                             maxBatch                    = 0;
+
+            bool transfersOwnership() {
+
+                return graphicsFamily != transferFamily;        // A shared family owns the resource on both queues
+
+            }
+
+            VkAccessFlags readAccess(VkBufferUsageFlags usage_) {
+
+                VkAccessFlags access = 0;
+                if (usage_ & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)     access |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+                if (usage_ & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)      access |= VK_ACCESS_INDEX_READ_BIT;
+                if (usage_ & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)    access |= VK_ACCESS_UNIFORM_READ_BIT;
+
+                return access != 0 ? access : static_cast< VkAccessFlags >(VK_ACCESS_MEMORY_READ_BIT);
+
+            }
+
+            VkPipelineStageFlags readStages(VkBufferUsageFlags usage_) {
+
+                VkPipelineStageFlags stages = 0;
+                if (usage_ & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT))    stages |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+                if (usage_ & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)                                        stages |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+                return stages != 0 ? stages : static_cast< VkPipelineStageFlags >(VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT);
+
+            }
+
+        }
+
+        void init(uint32_t graphicsFamily_, uint32_t transferFamily_) {
+
+            graphicsFamily = graphicsFamily_;
+            transferFamily = transferFamily_;
+
+        }
+
+        void releaseBuffer(VkCommandBuffer commandBuffer_, VkBuffer buffer_, VkBufferUsageFlags usage_) {
+
+            VkBufferMemoryBarrier barrier           = {};
+            barrier.sType                           = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.buffer                          = buffer_;
+            barrier.offset                          = 0;
+            barrier.size                            = VK_WHOLE_SIZE;
+
+            if (!transfersOwnership()) {
+
+                barrier.dstAccessMask               = readAccess(usage_);
+                barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+
+                vkCmdPipelineBarrier(commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, readStages(usage_), 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+                return;
+
+            }
+
+            barrier.dstAccessMask                   = 0;        // Ignored by the release, the acquire makes the writes visible
+            barrier.srcQueueFamilyIndex             = transferFamily;
+            barrier.dstQueueFamilyIndex             = graphicsFamily;
+
+            vkCmdPipelineBarrier(commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+            barrier.srcAccessMask                   = 0;
+            barrier.dstAccessMask                   = readAccess(usage_);
+            recorded.buffers.push_back(barrier);
+            recorded.stages |= readStages(usage_);
+            bufferCount++;
+
+        }
+
+        void releaseImage(VkCommandBuffer commandBuffer_, VkImage image_, const VkImageSubresourceRange& range_) {
+
+            VkImageMemoryBarrier barrier            = {};
+            barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.image                           = image_;
+            barrier.subresourceRange                = range_;
+
+            if (!transfersOwnership()) {
+
+                barrier.dstAccessMask               = VK_ACCESS_SHADER_READ_BIT;
+                barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+
+                vkCmdPipelineBarrier(commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+                return;
+
+            }
+
+            barrier.dstAccessMask                   = 0;        // The transfer queue cannot name the fragment shader stage, the acquire does
+            barrier.srcQueueFamilyIndex             = transferFamily;
+            barrier.dstQueueFamilyIndex             = graphicsFamily;
+
+            vkCmdPipelineBarrier(commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            barrier.srcAccessMask                   = 0;
+            barrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
+            recorded.images.push_back(barrier);         // The layout transition is part of both halves and must match
+            recorded.stages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            imageCount++;
+
+        }
+
+        void publish() {
+
+            if (recorded.buffers.empty() && recorded.images.empty()) return;
+
+            std::scoped_lock< std::mutex > lock(publishedMutex);
+            published.buffers.insert(published.buffers.end(), recorded.buffers.begin(), recorded.buffers.end());
+            published.images.insert(published.images.end(), recorded.images.begin(), recorded.images.end());
+            published.stages |= recorded.stages;
+            recorded.clear();
+
+        }
+
+        void acquire(VkCommandBuffer commandBuffer_) {
+
+            static Counter*     transfersMetric     = vk::metrics::counter("sync_ownership_transfers_total", "Resources the graphics queue acquired from the transfer queue");
+            static Histogram*   batchMetric         = vk::metrics::histogram("sync_ownership_acquires_per_frame", "Acquire barriers recorded into a frame that acquired any");
+
+            acquiring.clear();
+            {
+
+                std::scoped_lock< std::mutex > lock(publishedMutex);
+                std::swap(acquiring, published);
+
+            }
+
+            uint64_t batch = acquiring.buffers.size() + acquiring.images.size();
+            if (batch == 0) return;
+
+            vkCmdPipelineBarrier(
+                commandBuffer_,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                acquiring.stages,
+                0,
+                0,
+                nullptr,
+                static_cast< uint32_t >(acquiring.buffers.size()),
+                acquiring.buffers.data(),
+                static_cast< uint32_t >(acquiring.images.size()),
+                acquiring.images.data()
+                );
+
+            transfersMetric->add(batch);
+            batchMetric->observe(batch);
+            acquireCount++;
+            if (batch > maxBatch.load()) maxBatch = batch;
+
+        }
+
+        OwnershipStats stats() {
+
+            OwnershipStats snapshot                 = {};
+            snapshot.buffers                        = bufferCount.load();
+            snapshot.images                         = imageCount.load();
+            snapshot.acquires                       = acquireCount.load();
+            snapshot.maxBatch                       = maxBatch.load();
+
+            std::scoped_lock< std::mutex > lock(publishedMutex);
+            snapshot.pending                        = published.buffers.size() + published.images.size();
+
+            return snapshot;
+
+        }
+
+        void logStats() {
+
+            OwnershipStats snapshot = stats();
+
+            logger::log(EVENT_LOG, "Queue ownership: "
+                + std::to_string(snapshot.buffers) + " buffers and "
+                + std::to_string(snapshot.images) + " image ranges released by the transfer queue, acquired in "
+                + std::to_string(snapshot.acquires) + " frames, at most "
+                + std::to_string(snapshot.maxBatch) + " per frame, "
+                + std::to_string(snapshot.pending) + " pending"
+                );
+
+        }
+
+    }
+
+}
@@ -0,0 +1,84 @@
+/**
+    Prototypes the ownership namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Ownership.hpp
+    @brief        Prototype of the ownership namespace, hands uploaded resources from the transfer to the graphics queue
+*/
+#ifndef OWNERSHIP_HPP
+#define OWNERSHIP_HPP
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+#include "OwnershipStats.cpp"
+
+namespace vk {
+
+    /**
+        Uploads are recorded on the dedicated transfer queue into resources created with VK_SHARING_MODE_EXCLUSIVE.
+        Once written, a resource is released to the graphics queue family by a barrier at the end of the upload, and
+        the matching acquire barrier is recorded into the next frame's command buffer ahead of its render pass. The
+        acquires only become visible to the render loop once the upload has finished executing.
+    */
+    namespace ownership {
+
+        /**
+            Sets the queue families resources are handed between, has to be called once the logical device exists
+
+            @param      graphicsFamily_     The queue family index of the graphics queue
+            @param      transferFamily_     The queue family index of the transfer queue
+        */
+        void init(uint32_t graphicsFamily_, uint32_t transferFamily_);
+
+        /**
+            Records the release of a buffer written by a transfer command buffer
+
+            @param      commandBuffer_      The transfer command buffer that wrote the buffer
+            @param      buffer_             The buffer
+            @param      usage_              The usage flags the buffer was created with, selects how it is read
+        */
+        void releaseBuffer(VkCommandBuffer commandBuffer_, VkBuffer buffer_, VkBufferUsageFlags usage_);
+
+        /**
+            Records the release of image levels written by a transfer command buffer, transitioning them from
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+
+            @param      commandBuffer_      The transfer command buffer that wrote the image
+            @param      image_              The image
+            @param      range_              The subresource range that was written
+        */
+        void releaseImage(VkCommandBuffer commandBuffer_, VkImage image_, const VkImageSubresourceRange& range_);
+
+        /**
+            Makes the calling thread's releases available to the render loop, has to be called once the transfer
+            command buffers that recorded them have finished executing
+        */
+        void publish(void);
+
+        /**
+            Records the acquire barriers of all published releases into a graphics command buffer
+
+            @param      commandBuffer_      The graphics command buffer, outside of a render pass and submitted before
+                                            anything uses the resources
+        */
+        void acquire(VkCommandBuffer commandBuffer_);
+
+        /**
+            Returns the ownership transfer statistics
+
+            @return     Returns an OwnershipStats snapshot
+        */
+        OwnershipStats stats(void);
+
+        /**
+            Writes the ownership transfer statistics to the event log
+        */
+        void logStats(void);
+
+    }
+
+}
+#endif  // OWNERSHIP_HPP
@@ -0,0 +1,26 @@
+/**
+    Defines the OwnershipStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         OwnershipStats.cpp
+    @brief        Definition of the OwnershipStats struct
+*/
+#ifndef OWNERSHIP_STATS_CPP
+#define OWNERSHIP_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the statistics of the queue family ownership transfers
+*/
+struct OwnershipStats {
+
+    uint64_t            buffers;                    // Buffers released by the transfer queue
+    uint64_t            images;                     // Image subresource ranges released by the transfer queue
+    uint64_t            acquires;                   // Frames that acquired at least one resource
+    uint64_t            maxBatch;                   // Most acquire barriers recorded into a single frame
+    uint64_t            pending;                    // Released, waiting for the next frame to acquire them
+
+};
+#endif  // OWNERSHIP_STATS_CPP
@@ -0,0 +1,22 @@
+/**
+    Defines an enumeration for package entry compression
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         PACKAGE_COMPRESSION.cpp
+    @brief        Definition of the PACKAGE_COMPRESSION enumeration
+*/
+#ifndef PACKAGE_COMPRESSION_CPP
+#define PACKAGE_COMPRESSION_CPP
+
+/**
+    Enumeration to differenciate between the ways a package entry can be stored
+*/
+typedef enum PACKAGE_COMPRESSION {
+
+    PC_NONE = 0,        // Stored as is, readable straight from the mapping
+    PC_LZ4              // A single raw LZ4 block
+
+} PACKAGE_COMPRESSION;
+#endif  // PACKAGE_COMPRESSION_CPP
@@ -0,0 +1,169 @@
+/**
+    Implements the Package class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Package.cpp
+    @brief        Implementation of the Package class, a memory-mapped single-file asset archive
+*/
+#include "Package.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "LZ4.hpp"
+
+Package::Package(
+    const std::string&          path_,
+    const std::string&          root_
+    ) {
+
+    file = FileData::map(path_);
+    root = root_;
+    std::replace(root.begin(), root.end(), '\\', '/');
+
+    if (!file || file->size() < sizeof(PackageHeader)) return;
+
+    const unsigned char* base   = file->data();
+    uint64_t size               = file->size();
+    auto candidate              = reinterpret_cast< const PackageHeader* >(base);
+
+    if (candidate->magic != PACKAGE_MAGIC || candidate->version != PACKAGE_VERSION) return;
+
+    uint64_t tableEnd = sizeof(PackageHeader) + static_cast< uint64_t >(candidate->entryCount) * sizeof(PackageEntry);
+    if (tableEnd > size || candidate->namesOffset < tableEnd || candidate->namesSize > size - candidate->namesOffset) return;
+
+    auto table = reinterpret_cast< const PackageEntry* >(base + sizeof(PackageHeader));
+    for (uint32_t i = 0; i < candidate->entryCount; i++) {      // Validate once so lookups never have to
+
+        const PackageEntry& entry = table[i];
+        bool inside = entry.offset <= size && entry.size <= size - entry.offset
+            && static_cast< uint64_t >(entry.nameOffset) + entry.nameLength <= candidate->namesSize
+            && entry.compression <= PC_LZ4
+            && (entry.compression != PC_NONE || entry.rawSize == entry.size);
+
+        if (!inside) return;
+
+    }
+
+    header  = candidate;
+    entries = table;
+    names   = reinterpret_cast< const char* >(base + candidate->namesOffset);
+
+}
+
+bool Package::isValid() {
+
+    return header != nullptr;
+
+}
+
+bool Package::contains(const std::string& path_) {
+
+    return find(path_) != nullptr;
+
+}
+
+std::shared_ptr< FileData > Package::read(const std::string& path_) {
+
+    const PackageEntry* entry = find(path_);
+    if (entry == nullptr) return nullptr;
+
+    if (entry->compression == PC_NONE) {
+
+        return FileData::view(file, static_cast< size_t >(entry->offset), static_cast< size_t >(entry->size));
+
+    }
+
+    std::vector< unsigned char > bytes(static_cast< size_t >(entry->rawSize));
+    if (!lz4::decompress(file->data() + entry->offset, static_cast< size_t >(entry->size), bytes.data(), bytes.size())) {
+
+        return nullptr;
+
+    }
+
+    return FileData::adopt(std::move(bytes));
+
+}
+
+uint32_t Package::getEntryCount() {
+
+    return header != nullptr ? header->entryCount : 0;
+
+}
+
+std::string Package::normalize(const std::string& path_) {
+
+    std::vector< std::string > components;
+    size_t begin = 0;
+
+    while (begin <= path_.size()) {
+
+        size_t end = path_.find_first_of("/\\", begin);
+        if (end == std::string::npos) end = path_.size();
+
+        std::string component = path_.substr(begin, end - begin);
+        if (component == "..") {
+
+            if (!components.empty() && components.back() != "..") components.pop_back();
+            else components.push_back(component);
+
+        }
+        else if (!component.empty() && component != ".") {
+
+            components.push_back(component);
+
+        }
+
+        begin = end + 1;
+
+    }
+
+    std::string normalized;
+    for (const auto& component : components) {
+
+        if (!normalized.empty()) normalized += '/';
+        normalized += component;
+
+    }
+
+    return normalized;
+
+}
+
+const PackageEntry* Package::find(const std::string& path_) {
+
+    if (header == nullptr) return nullptr;
+
+    std::string path = path_;
+    std::replace(path.begin(), path.end(), '\\', '/');
+    if (!root.empty() && path.size() > root.size() && path.compare(0, root.size(), root) == 0 && path[root.size()] == '/') {
+
+        path = path.substr(root.size() + 1);        // Canonical absolute paths below the root
+
+    }
+    else if (!path.empty() && (path[0] == '/' || (path.size() > 1 && path[1] == ':'))) {
+
+        return nullptr;     // Absolute paths outside of the root are never packaged
+
+    }
+    path = normalize(path);
+
+    const PackageEntry* end = entries + header->entryCount;
+    const PackageEntry* entry = std::lower_bound(entries, end, path, [this](const PackageEntry& entry_, const std::string& name_) {
+
+        return name_.compare(0, std::string::npos, names + entry_.nameOffset, entry_.nameLength) > 0;
+
+        });
+
+    if (entry == end || path.compare(0, std::string::npos, names + entry->nameOffset, entry->nameLength) != 0) {
+
+        return nullptr;
+
+    }
+
+    return entry;
+
+}
@@ -0,0 +1,96 @@
+/**
+    Declares the Package class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Package.hpp
+    @brief        Declaration of the Package class, a memory-mapped single-file asset archive
+*/
+#ifndef PACKAGE_HPP
+#define PACKAGE_HPP
+#include <memory>
+#include <string>
+
+#include "FileData.hpp"
+#include "PackageFormat.cpp"
+
+/**
+    Maps an asset package written by VKPack and serves its entries by path. Entry names are paths relative to the
+    directory the packer was run in, which has to be the working directory of the engine.
+*/
+class Package {
+public:
+
+    /**
+        Constructor, maps a package and validates its index
+
+        @param      path_       (Relative) filepath to the package
+        @param      root_       Canonical path of the directory entry names are relative to, used to resolve
+                                absolute lookups
+    */
+    Package(
+        const std::string&          path_,
+        const std::string&          root_
+        );
+
+    /**
+        Checks whether the package has been mapped and its index is consistent
+
+        @return     Returns true if entries can be read
+    */
+    bool isValid(void);
+
+    /**
+        Checks whether the package contains a file
+
+        @param      path_       (Relative or absolute) filepath to the file
+
+        @return     Returns true if the file is in the package
+    */
+    bool contains(const std::string& path_);
+
+    /**
+        Reads a file from the package, uncompressed entries are views of the mapping, compressed entries are decompressed
+        into memory
+
+        @param      path_       (Relative or absolute) filepath to the file
+
+        @return     Returns the file or nullptr if the package does not contain it or it fails to decompress
+    */
+    std::shared_ptr< FileData > read(const std::string& path_);
+
+    /**
+        Returns the number of entries
+
+        @return     Returns the number of entries
+    */
+    uint32_t getEntryCount(void);
+
+    /**
+        Turns a relative path into the form entries are named by: forward slashes, no "." components and ".." folded
+        into the component before it
+
+        @param      path_       A relative filepath
+
+        @return     Returns the normalized path
+    */
+    static std::string normalize(const std::string& path_);
+
+private:
+
+    std::shared_ptr< FileData >     file;
+    std::string                     root;
+    const PackageHeader*            header          = nullptr;
+    const PackageEntry*             entries         = nullptr;
+    const char*                     names           = nullptr;
+
+    /**
+        Looks up the entry of a path by binary search
+
+        @return     Returns the entry or nullptr if there is none
+    */
+    const PackageEntry* find(const std::string& path_);
+
+};
+#endif  // PACKAGE_HPP
@@ -0,0 +1,49 @@
+/**
+    Defines the asset package file format
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         PackageFormat.cpp
+    @brief        Definition of the PackageHeader and PackageEntry structs, shared by the engine and the packer
+*/
+#ifndef PACKAGE_FORMAT_CPP
+#define PACKAGE_FORMAT_CPP
+#include <cstdint>
+
+#include "PACKAGE_COMPRESSION.cpp"
+
+const uint32_t          PACKAGE_MAGIC           = 0x4B504B56;       // "VKPK"
+const uint32_t          PACKAGE_VERSION         = 1;
+const uint64_t          PACKAGE_ALIGNMENT       = 4096;             // Every entry starts on a page, uncompressed entries are used straight from the mapping
+
+/**
+    Fixed-size header at the start of every package, followed by the entry table, the name table and the aligned
+    entry data
+*/
+struct PackageHeader {
+
+    uint32_t            magic;
+    uint32_t            version;
+    uint32_t            entryCount;
+    uint32_t            reserved;
+    uint64_t            namesOffset;
+    uint64_t            namesSize;
+
+};
+
+/**
+    An entry of the table, the table is sorted by name so lookups are a binary search on the mapping
+*/
+struct PackageEntry {
+
+    uint64_t            offset;             // Offset of the stored bytes from the start of the package
+    uint64_t            size;               // Size of the stored bytes
+    uint64_t            rawSize;            // Size after decompression
+    uint32_t            nameOffset;         // Offset of the name in the name table
+    uint32_t            nameLength;
+    uint32_t            compression;        // A PACKAGE_COMPRESSION
+    uint32_t            reserved;
+
+};
+#endif  // PACKAGE_FORMAT_CPP
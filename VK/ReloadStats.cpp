@@ -0,0 +1,27 @@
+/**
+    Defines the ReloadStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         ReloadStats.cpp
+    @brief        Definition of the ReloadStats struct
+*/
+#ifndef RELOAD_STATS_CPP
+#define RELOAD_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the statistics of the hot reloader, latencies are measured from the first change notification of a file to
+    the frame its replacement is used in
+*/
+struct ReloadStats {
+
+    uint64_t            reloads;                // Resources swapped in
+    uint64_t            failures;               // Changed files that failed to load, the old resource stays in use
+    double              lastMilliseconds;
+    double              averageMilliseconds;
+    double              maxMilliseconds;
+
+};
+#endif  // RELOAD_STATS_CPP
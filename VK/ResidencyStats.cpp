@@ -0,0 +1,30 @@
+/**
+    Defines the ResidencyStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         ResidencyStats.cpp
+    @brief        Definition of the ResidencyStats struct
+*/
+#ifndef RESIDENCY_STATS_CPP
+#define RESIDENCY_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the statistics of texture residency management
+*/
+struct ResidencyStats {
+
+    uint64_t            levelsDropped;          // Times a texture was replaced by one without its largest resident mip level
+    uint64_t            levelsRestored;         // Times a texture got a dropped mip level back
+    uint64_t            bytesReleased;          // Device memory freed by dropping levels
+    uint64_t            failed;                 // Replacements that could not be built
+    uint64_t            levelsStreamed;         // Mip levels uploaded after their texture was first shown
+    uint32_t            texturesStreaming;      // Live textures still waiting for streamed levels
+    uint32_t            texturesReduced;        // Live textures currently missing mip levels
+    uint32_t            levelsMissing;          // Mip levels missing over all live textures
+    double              pressure;               // Usage over budget of the texture heap at the last update
+
+};
+#endif  // RESIDENCY_STATS_CPP
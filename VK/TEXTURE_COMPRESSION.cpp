@@ -0,0 +1,23 @@
+/**
+    Defines the TEXTURE_COMPRESSION enumeration
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TEXTURE_COMPRESSION.cpp
+    @brief        Definition of the TEXTURE_COMPRESSION enumeration
+*/
+#ifndef TEXTURE_COMPRESSION_CPP
+#define TEXTURE_COMPRESSION_CPP
+
+/**
+ * Enumeration to differenciate between the block-compression modes textures can be stored in
+ */
+typedef enum TEXTURE_COMPRESSION {
+
+    TC_BC7          = 2,
+    TC_BC1_BC3      = 1,
+    TC_NONE         = 0
+
+} TEXTURE_COMPRESSION;
+#endif  // TEXTURE_COMPRESSION_CPP
@@ -0,0 +1,291 @@
+/**
+    Implements the TextureCache class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureCache.cpp
+    @brief        Implementation of the TextureCache class
+*/
+#include "TextureCache.hpp"
+
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+#include "VK.hpp"
+#include "ASSERT.cpp"
+
+#if defined WIN_64 || defined WIN_32
+    #include <direct.h>
+    #include <sys/types.h>
+    #include <sys/stat.h>
+#elif defined LINUX
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+    const char*             CACHE_DIR               = "cache";
+    const char*             TEXTURE_CACHE_DIR       = "cache/textures";
+    const uint32_t          CACHE_MAGIC             = 0x43544B56;       // "VKTC"
+    const uint32_t          CACHE_VERSION           = 2;
+    const VkDeviceSize      CACHE_ALIGNMENT         = 16;               // Largest texel block size, keeps every level copyable straight from the mapping
+
+    /**
+        Fixed-size header at the start of every cache entry, followed by the level table and the aligned texel data
+    */
+    struct TextureCacheHeader {
+
+        uint32_t            magic;
+        uint32_t            version;
+        uint32_t            format;
+        uint32_t            width;
+        uint32_t            height;
+        uint32_t            levelCount;
+        uint32_t            compression;
+        uint32_t            reserved;
+        uint64_t            sourceSize;
+        int64_t             sourceTime;
+
+    };
+
+    VkDeviceSize dataOffset(uint32_t levelCount_) {
+
+        VkDeviceSize tableEnd = sizeof(TextureCacheHeader) + levelCount_ * sizeof(TextureLevel);
+
+        return (tableEnd + CACHE_ALIGNMENT - 1) & ~(CACHE_ALIGNMENT - 1);
+
+    }
+
+    /**
+        Queries the size and modification time of a source file
+
+        @param      path_   The path to the source file
+        @param      size_   Receives the file size in bytes
+        @param      time_   Receives the modification time in the platform's finest resolution (100ns ticks on Windows, nanoseconds on Linux)
+
+        @return     Returns false if the file does not exist
+    */
+    bool sourceStamp(const char* path_, uint64_t& size_, int64_t& time_) {
+
+#if defined WIN_64 || defined WIN_32
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (!GetFileAttributesExA(path_, GetFileExInfoStandard, &attributes)) return false;
+
+        size_ = (static_cast< uint64_t >(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+        time_ = static_cast< int64_t >((static_cast< uint64_t >(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime);
+#elif defined LINUX
+        struct stat st;
+        if (stat(path_, &st) != 0) return false;
+
+        size_ = static_cast< uint64_t >(st.st_size);
+        time_ = static_cast< int64_t >(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+
+        return true;
+
+    }
+
+}
+
+TextureCache::TextureCache(
+    const char*                 sourcePath_,
+    uint32_t                    compression_
+    ) {
+
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    if (!sourceStamp(sourcePath_, sourceSize, sourceTime)) return;
+
+    std::string path = entryPath(sourcePath_);
+
+#if defined WIN_64 || defined WIN_32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    mappingSize = static_cast< size_t >(fileSize.QuadPart);
+
+    HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!fileMapping) return;
+
+    mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(fileMapping);
+#elif defined LINUX
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) return;
+
+    struct stat st;
+    fstat(file, &st);
+    mappingSize = static_cast< size_t >(st.st_size);
+
+    if (mappingSize > 0) {
+
+        void* address = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, file, 0);
+        mapping = address == MAP_FAILED ? nullptr : address;
+
+    }
+    close(file);
+#endif
+
+    if (!mapping || mappingSize < sizeof(TextureCacheHeader)) return;
+
+    const unsigned char* bytes = static_cast< const unsigned char* >(mapping);
+    TextureCacheHeader header;
+    std::memcpy(&header, bytes, sizeof(TextureCacheHeader));
+
+    if (header.magic != CACHE_MAGIC
+        || header.version != CACHE_VERSION
+        || header.compression != compression_
+        || header.sourceSize != sourceSize
+        || header.sourceTime != sourceTime
+        || header.levelCount == 0
+        || mappingSize < dataOffset(header.levelCount)
+        ) {
+
+        VK_LOG_DEBUG(LC_ASSETS, "Texture cache entry for {} is stale", sourcePath_);
+        return;
+
+    }
+
+    levels.resize(header.levelCount);
+    std::memcpy(levels.data(), bytes + sizeof(TextureCacheHeader), header.levelCount * sizeof(TextureLevel));
+
+    data        = bytes + dataOffset(header.levelCount);
+    dataSize    = mappingSize - dataOffset(header.levelCount);
+
+    for (const auto& level : levels) {
+
+        if (level.offset + level.size > dataSize) {
+
+            VK_LOG_WARNING(LC_ASSETS, "Texture cache entry for {} is truncated", sourcePath_);
+            levels.clear();
+            data = nullptr;
+            return;
+
+        }
+
+    }
+
+    format  = static_cast< VkFormat >(header.format);
+    width   = header.width;
+    height  = header.height;
+
+}
+
+bool TextureCache::isValid() {
+
+    return data != nullptr;
+
+}
+
+VK_STATUS_CODE TextureCache::store(
+    const char*                         sourcePath_,
+    uint32_t                            compression_,
+    VkFormat                            format_,
+    const std::vector< TextureLevel >&  levels_,
+    const unsigned char*                data_,
+    VkDeviceSize                        dataSize_
+    ) {
+
+    TextureCacheHeader header       = {};
+    header.magic                    = CACHE_MAGIC;
+    header.version                  = CACHE_VERSION;
+    header.format                   = static_cast< uint32_t >(format_);
+    header.width                    = levels_[0].width;
+    header.height                   = levels_[0].height;
+    header.levelCount               = static_cast< uint32_t >(levels_.size());
+    header.compression              = compression_;
+
+    if (!sourceStamp(sourcePath_, header.sourceSize, header.sourceTime)) {
+
+        return VK_SC_TEXTURE_CACHE_ERROR;
+
+    }
+
+#if defined WIN_64 || defined WIN_32
+    _mkdir(CACHE_DIR);
+    _mkdir(TEXTURE_CACHE_DIR);
+#elif defined LINUX
+    mkdir(CACHE_DIR, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+    mkdir(TEXTURE_CACHE_DIR, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+#endif
+
+    std::string path        = entryPath(sourcePath_);
+    std::string tempPath    = path + ".tmp";       // Written aside and renamed so a concurrent or interrupted run never maps a half-written entry
+
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+
+        VK_LOG_WARNING(LC_ASSETS, "Failed to open texture cache entry {}", tempPath);
+        return VK_SC_TEXTURE_CACHE_ERROR;
+
+    }
+
+    static const char padding[CACHE_ALIGNMENT] = {};
+    VkDeviceSize tableEnd = sizeof(TextureCacheHeader) + levels_.size() * sizeof(TextureLevel);
+
+    file.write(reinterpret_cast< const char* >(&header), sizeof(TextureCacheHeader));
+    file.write(reinterpret_cast< const char* >(levels_.data()), levels_.size() * sizeof(TextureLevel));
+    file.write(padding, static_cast< std::streamsize >(dataOffset(header.levelCount) - tableEnd));
+    file.write(reinterpret_cast< const char* >(data_), static_cast< std::streamsize >(dataSize_));
+    file.close();
+
+    if (file.fail()) {
+
+        VK_LOG_WARNING(LC_ASSETS, "Failed to write texture cache entry {}", tempPath);
+        std::remove(tempPath.c_str());
+        return VK_SC_TEXTURE_CACHE_ERROR;
+
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+
+        std::remove(tempPath.c_str());
+        return VK_SC_TEXTURE_CACHE_ERROR;
+
+    }
+
+    VK_LOG_DEBUG(LC_ASSETS, "Wrote texture cache entry {} for {}", path, sourcePath_);
+
+    return VK_SC_SUCCESS;
+
+}
+
+std::string TextureCache::entryPath(const char* sourcePath_) {
+
+    uint64_t hash = 0xCBF29CE484222325ull;         // 64-bit FNV-1a
+    for (const char* c = sourcePath_; *c; c++) {
+
+        hash ^= static_cast< unsigned char >(*c);
+        hash *= 0x100000001B3ull;
+
+    }
+
+    std::ostringstream stream;
+    stream << TEXTURE_CACHE_DIR << "/" << std::hex << std::setw(16) << std::setfill('0') << hash << ".vktc";
+
+    return stream.str();
+
+}
+
+TextureCache::~TextureCache() {
+
+    if (!mapping) return;
+
+#if defined WIN_64 || defined WIN_32
+    UnmapViewOfFile(mapping);
+#elif defined LINUX
+    munmap(mapping, mappingSize);
+#endif
+
+}
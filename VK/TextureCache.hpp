@@ -0,0 +1,100 @@
+/**
+    Defines the TextureCache class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureCache.hpp
+    @brief        Definition of the TextureCache class, a memory-mapped on-disk cache of GPU-ready textures
+*/
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <string>
+
+#include "Logger.hpp"
+#include "VK_STATUS_CODE.hpp"
+#include "TextureLevel.cpp"
+
+/**
+    Maps a pre-processed texture (final format, full mip chain) from the texture cache directory into memory.
+    A cache entry is keyed by the source path and is considered stale once the source file's size or
+    modification time or the requested compression changes.
+*/
+class TextureCache {
+public:
+
+    VkFormat                        format          = VK_FORMAT_UNDEFINED;
+    uint32_t                        width           = 0;
+    uint32_t                        height          = 0;
+    std::vector< TextureLevel >     levels;
+    const unsigned char*            data            = nullptr;
+    VkDeviceSize                    dataSize        = 0;
+
+    /**
+        Default constructor
+    */
+    TextureCache(void) = default;
+
+    /**
+        Constructor, maps the cache entry of a source image if there is a valid one
+
+        @param      sourcePath_     (Relative) filepath to the source image resource
+        @param      compression_    The compression mode the entry must have been built with
+    */
+    TextureCache(
+        const char*                 sourcePath_,
+        uint32_t                    compression_
+        );
+
+    /**
+        Checks whether a valid, up-to-date cache entry has been mapped
+
+        @return     Returns true if the texture can be uploaded straight from the cache
+    */
+    bool isValid(void);
+
+    /**
+        Writes a new cache entry for a source image
+
+        @param      sourcePath_     (Relative) filepath to the source image resource
+        @param      compression_    The compression mode the entry was built with
+        @param      format_         The format of the texel data
+        @param      levels_         The mip levels, offsets are relative to data_
+        @param      data_           The tightly packed mip chain
+        @param      dataSize_       The size of the mip chain in bytes
+
+        @return     Returns VK_SC_SUCCESS on success
+    */
+    static VK_STATUS_CODE store(
+        const char*                         sourcePath_,
+        uint32_t                            compression_,
+        VkFormat                            format_,
+        const std::vector< TextureLevel >&  levels_,
+        const unsigned char*                data_,
+        VkDeviceSize                        dataSize_
+        );
+
+    /**
+        Default destructor, unmaps the cache entry
+    */
+    ~TextureCache(void);
+
+private:
+
+    void*                           mapping         = nullptr;
+    size_t                          mappingSize     = 0;
+
+    /**
+        Builds the path of the cache entry belonging to a source image
+
+        @param      sourcePath_     (Relative) filepath to the source image resource
+
+        @return     Returns the path of the cache entry
+    */
+    static std::string entryPath(const char* sourcePath_);
+
+};
+#endif  // TEXTURE_CACHE_HPP
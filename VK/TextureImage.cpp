@@ -11,110 +11,232 @@
 
 #include <stb_image.h>
 
+#include <cstring>
+#include <utility>
+
 #include "VK.hpp"
 #include "ASSERT.cpp"
+#include "TextureCache.hpp"
+#include "BlockCompression.hpp"
+#include "TEXTURE_COMPRESSION.cpp"
+#include "MipmapGenerator.hpp"
+#include "FileIO.hpp"
+
+#ifdef VK_SSSE3
+    #include <tmmintrin.h>
+#endif
+
+
+namespace {
+
+#ifdef VK_MIPMAP_FILTER_KAISER
+    const MIPMAP_FILTER         MIPMAP_FILTER_DEFAULT       = MF_KAISER;
+#else
+    const MIPMAP_FILTER         MIPMAP_FILTER_DEFAULT       = MF_BOX;
+#endif
+
+    /**
+        Picks the block-compression mode requested in Version.hpp, falling back to none if the device cannot sample BCn textures
+
+        @return     Returns the compression mode textures are built with on this device
+    */
+    TEXTURE_COMPRESSION configuredCompression() {
+
+#if defined VK_TEXTURE_COMPRESSION_BC7 || defined VK_TEXTURE_COMPRESSION_BC1_BC3
+        VkPhysicalDeviceFeatures physicalDeviceFeatures;
+        vkGetPhysicalDeviceFeatures(vk::core::physicalDevice, &physicalDeviceFeatures);
+
+        if (!physicalDeviceFeatures.textureCompressionBC) {
+
+            return TC_NONE;
+
+        }
+#endif
+#if defined VK_TEXTURE_COMPRESSION_BC7
+        return TC_BC7;
+#elif defined VK_TEXTURE_COMPRESSION_BC1_BC3
+        return TC_BC1_BC3;
+#else
+        return TC_NONE;
+#endif
+
+    }
+
+    /**
+        Lays out an uncompressed mip chain tightly packed with every level aligned to the largest texel block size
+
+        @return     Returns the size of the mip chain in bytes
+    */
+    VkDeviceSize layoutChain(uint32_t texelSize_, uint32_t width_, uint32_t height_, uint32_t mipLevels_, std::vector< TextureLevel >& levels_) {
+
+        levels_.resize(mipLevels_);
+        VkDeviceSize chainSize = 0;
+
+        for (uint32_t i = 0; i < mipLevels_; i++) {
+
+            levels_[i].width    = std::max(width_ >> i, 1u);
+            levels_[i].height   = std::max(height_ >> i, 1u);
+            levels_[i].offset   = chainSize;
+            levels_[i].size     = static_cast< VkDeviceSize >(levels_[i].width) * levels_[i].height * texelSize_;
+
+            chainSize += (levels_[i].size + 15) & ~static_cast< VkDeviceSize >(15);
+
+        }
+
+        return chainSize;
+
+    }
+
+    /**
+        Expands tightly packed RGB8 texels to RGBA8 with opaque alpha
+    */
+    void expandRGBToRGBA(const unsigned char* src_, unsigned char* dst_, size_t texelCount_) {
+
+        size_t i = 0;
+
+#ifdef VK_SSSE3
+        const __m128i shuffle   = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alpha     = _mm_set1_epi32(static_cast< int >(0xFF000000));
+
+        for (; i + 6 <= texelCount_; i += 4) {      // 16-byte loads consume 12 bytes, stop early enough to never read past the source
+
+            __m128i rgb = _mm_loadu_si128(reinterpret_cast< const __m128i* >(src_ + i * 3));
+            _mm_storeu_si128(reinterpret_cast< __m128i* >(dst_ + i * 4), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+
+        }
+#endif
+
+        for (; i < texelCount_; i++) {
+
+            dst_[i * 4]         = src_[i * 3];
+            dst_[i * 4 + 1]     = src_[i * 3 + 1];
+            dst_[i * 4 + 2]     = src_[i * 3 + 2];
+            dst_[i * 4 + 3]     = 255;
+
+        }
+
+    }
+
+    /**
+        Replicates the first channel of one- and two-channel maps so shaders can keep sampling .rgb and .a
+    */
+    VkComponentMapping componentMapping(VkFormat format_) {
+
+        if (format_ == VK_FORMAT_R8_UNORM) {
 
+            return { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ONE };
+
+        }
+        else if (format_ == VK_FORMAT_R8G8_UNORM) {
+
+            return { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G };
+
+        }
+
+        return { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+
+    }
+
+    bool isSRGB(VkFormat format_) {
+
+        return format_ == VK_FORMAT_R8G8B8A8_SRGB
+            || format_ == VK_FORMAT_BC1_RGB_SRGB_BLOCK
+            || format_ == VK_FORMAT_BC3_SRGB_BLOCK
+            || format_ == VK_FORMAT_BC7_SRGB_BLOCK;
+
+    }
+
+}
 
 TextureImage::TextureImage(
     const char*                 path_, 
     VkFormat                    format_, 
     VkImageTiling               tiling_, 
     VkImageUsageFlags           usage_,
-    VkMemoryPropertyFlags       properties_
+    VkMemoryPropertyFlags       properties_,
+    uint32_t                    droppedLevels_,
+    bool                        streamed_
     ) {
 
-    stbi_uc* pix = stbi_load(
-        path_,
-        &w,
-        &h,
-        &ch,
-        STBI_rgb_alpha
-        );
+    path                            = path_;
+    requestedFormat                 = format_;
+    tiling                          = tiling_;
+    usage                           = usage_ | VK_IMAGE_USAGE_TRANSFER_DST_BIT;        // Every level arrives through a buffer copy
+    properties                      = properties_;
 
-    imageSize = w * h * 4;
+    TEXTURE_COMPRESSION compression = configuredCompression();
+    bool sRGB                       = isSRGB(format_);          // sRGB-encoded color maps are filtered in linear space
 
-    mipLevels = static_cast< uint32_t >(std::floor(std::log2(std::max(w, h)))) + 1;     // Calculate number of mipmaps by using logarithms
+#ifdef VK_TEXTURE_CACHE
+    std::unique_ptr< TextureCache > cache = std::make_unique< TextureCache >(path_, compression);     // Outlives the constructor if the texture is streamed
 
-    if (!pix) {
+    bool colorFormat = cache->format != VK_FORMAT_R8_UNORM && cache->format != VK_FORMAT_R8G8_UNORM;
 
-        logger::log(ERROR_LOG, "Failed to load textures");
+    if (cache->isValid() && (!colorFormat || isSRGB(cache->format) == sRGB)) {     // Warm load, the mip chain is already in its final format and only needs to be copied
 
-    }
+        w           = static_cast< int >(cache->width);
+        h           = static_cast< int >(cache->height);
+        ch          = cache->format == VK_FORMAT_R8_UNORM ? 1 : (cache->format == VK_FORMAT_R8G8_UNORM ? 2 : 4);
+        mipLevels   = static_cast< uint32_t >(cache->levels.size());
 
-    VkFormat imageFormat;
-    if (ch == 1) {
+        droppedLevels   = fitToBudget(cache->levels, cache->dataSize, droppedLevels_);
+        mipLevels      -= droppedLevels;
+        streamedLevel   = streamed_ ? streamingTail(cache->levels, droppedLevels) : 0;
+        upload(cache->format, cache->levels, cache->data, cache->dataSize, droppedLevels, streamedLevel);
+        VK_LOG_DEBUG(LC_ASSETS, "Loaded texture {} from texture cache", path_);
 
-        imageFormat = VK_FORMAT_R8_UNORM;
-    
-    }
-    else if (ch == 2) {
+        if (streamedLevel > 0) {
+
+            streamSource            = std::make_shared< TextureSource >();
+            streamSource->levels    = cache->levels;
+            streamSource->data      = cache->data;
+            streamSource->format    = cache->format;
+            streamSource->cache     = std::move(cache);
 
-        imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
+        }
 
     }
-    else if (ch == 3) {
+    else
+#endif
+    {
 
-        // TODO: Reshape data in memory to fit in 4-channel format as 3-channel formats are not supported (mostly) for beauty
+        VkFormat imageFormat;
+        std::vector< TextureLevel > levels;
+        std::vector< unsigned char > chain;
 
-        imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
-        
-    }
-    else if (ch == 4) {
+        decode(path_, compression, sRGB, imageFormat, levels, chain);
+#ifdef VK_TEXTURE_CACHE
+        TextureCache::store(path_, compression, imageFormat, levels, chain.data(), chain.size());
+#endif
+        droppedLevels   = fitToBudget(levels, chain.size(), droppedLevels_);
+        mipLevels      -= droppedLevels;
+        streamedLevel   = streamed_ ? streamingTail(levels, droppedLevels) : 0;
+        upload(imageFormat, levels, chain.data(), chain.size(), droppedLevels, streamedLevel);
 
-        imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
-    
-    }
-    else {
-        
-        logger::log(ERROR_LOG, "Unsupported image format at " + std::string(path_));
-    
-    }
+        if (streamedLevel > 0) {
 
-    stagingBuffer = new BaseBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            streamSource            = std::make_shared< TextureSource >();
+            streamSource->levels    = std::move(levels);
+            streamSource->chain     = std::move(chain);
+            streamSource->data      = streamSource->chain.data();
+            streamSource->format    = imageFormat;
 
-    stagingBuffer->fill(pix);
+        }
 
-    stbi_image_free(pix);
+    }
 
-    vk::createImage(
-        w, 
-        h, 
-        mipLevels, 
-        imageFormat, 
-        VK_IMAGE_TILING_OPTIMAL, 
-        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, 
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        VK_SAMPLE_COUNT_1_BIT,
-        img,
-        mem
-        );
+    if (streamSource) {
 
-    vk::imageLayoutTransition(
-        img,
-        imageFormat, 
-        VK_IMAGE_LAYOUT_UNDEFINED,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        mipLevels
-        );
+        streamSource->image         = img;
+        streamSource->droppedLevels = droppedLevels;
 
-    vk::copyBufferToImage(
-        stagingBuffer->buf,
-        img,
-        static_cast< uint32_t >(w),
-        static_cast< uint32_t >(h)
-        );
-    
-    delete stagingBuffer;
+    }
 
-    vk::generateImageMipmaps(
-        img, 
-        imageFormat,
-        w, 
-        h, 
-        mipLevels
-        );
+    if (droppedLevels > droppedLevels_) {
 
-    imgView = vk::createImageView(img, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+        VK_LOG_INFO(LC_MEMORY, "Loaded texture {} without its {} largest mip levels, the texture heap is near its budget", path_, droppedLevels);
+
+    }
 
     VkSamplerCreateInfo samplerCreateInfo           = {};
     samplerCreateInfo.sType                         = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
@@ -141,8 +263,241 @@ TextureImage::TextureImage(
         &imgSampler
         );
     ASSERT(result, "Failed to create sampler", VK_SC_SAMPLER_CREATION_ERROR);
+    vk::counters::add(FC_OBJECTS_CREATED);
+
+    VK_LOG_DEBUG(LC_RENDER, "Successfully created sampler");
+
+}
+
+VK_STATUS_CODE TextureImage::decode(
+    const char*                     path_,
+    uint32_t                        compression_,
+    bool                            sRGB_,
+    VkFormat&                       format_,
+    std::vector< TextureLevel >&    levels_,
+    std::vector< unsigned char >&   data_
+    ) {
+
+    std::shared_ptr< FileData > file = vk::io::read(path_);
+
+    if (!file) {
+
+        logger::log(ERROR_LOG, "Failed to load textures");
+
+    }
+
+    stbi_uc* pix = stbi_load_from_memory(
+        file->data(),
+        static_cast< int >(file->size()),
+        &w,
+        &h,
+        &ch,
+        0           // Keep the channel count of the source, one- and two-channel maps are not padded to RGBA
+        );
+
+    if (!pix) {
+
+        logger::log(ERROR_LOG, "Failed to load textures");
+
+    }
+
+    if (ch < 1 || ch > 4) {
+
+        stbi_image_free(pix);
+        logger::log(ERROR_LOG, "Unsupported image format at " + std::string(path_));
+
+    }
+
+    mipLevels = static_cast< uint32_t >(std::floor(std::log2(std::max(w, h)))) + 1;     // Calculate number of mipmaps by using logarithms
+
+    uint32_t texelSize = ch == 3 ? 4 : static_cast< uint32_t >(ch);     // 3-channel formats are not supported (mostly), RGB is expanded to RGBA
+    imageSize = static_cast< VkDeviceSize >(w) * h * texelSize;
+
+    bool opaque = true;
+    for (VkDeviceSize i = 3; ch == 4 && i < imageSize && opaque; i += 4) {
+
+        opaque = pix[i] == 255;
+
+    }
+
+    if (ch == 1) {
+
+        format_ = VK_FORMAT_R8_UNORM;
+
+    }
+    else if (ch == 2) {
+
+        format_ = VK_FORMAT_R8G8_UNORM;
+
+    }
+    else if (compression_ == TC_BC7) {
+
+        format_ = sRGB_ ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+
+    }
+    else if (compression_ == TC_BC1_BC3 && opaque) {
+
+        format_ = sRGB_ ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+
+    }
+    else if (compression_ == TC_BC1_BC3) {
+
+        format_ = sRGB_ ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+
+    }
+    else {
+
+        format_ = sRGB_ ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
 
-    logger::log(EVENT_LOG, "Successfully created sampler");
+    }
+
+    std::vector< TextureLevel > texelLevels;
+    std::vector< unsigned char > texels(static_cast< size_t >(layoutChain(texelSize, w, h, mipLevels, texelLevels)));
+
+    if (ch == 3) {
+
+        expandRGBToRGBA(pix, texels.data(), static_cast< size_t >(w) * h);
+
+    }
+    else {
+
+        std::memcpy(texels.data(), pix, static_cast< size_t >(imageSize));
+
+    }
+    stbi_image_free(pix);
+
+    vk::mipmaps::generate(texels.data(), texelLevels, texelSize, sRGB_, MIPMAP_FILTER_DEFAULT);
+
+    if (!vk::bc::isCompressed(format_)) {
+
+        levels_ = std::move(texelLevels);
+        data_   = std::move(texels);
+
+        return vk::errorCodeBuffer;
+
+    }
+
+    levels_ = texelLevels;
+    VkDeviceSize chainSize = 0;
+    for (auto& level : levels_) {
+
+        level.offset    = chainSize;
+        level.size      = vk::bc::compressedSize(format_, level.width, level.height);
+        chainSize      += (level.size + 15) & ~static_cast< VkDeviceSize >(15);
+
+    }
+
+    data_.assign(static_cast< size_t >(chainSize), 0);
+
+    for (uint32_t i = 0; i < mipLevels; i++) {
+
+        vk::bc::compress(format_, texels.data() + texelLevels[i].offset, levels_[i].width, levels_[i].height, data_.data() + levels_[i].offset);
+
+    }
+
+    return vk::errorCodeBuffer;
+
+}
+
+uint32_t TextureImage::streamingTail(
+    const std::vector< TextureLevel >&  levels_,
+    uint32_t                            droppedLevels_
+    ) {
+
+#ifdef VK_TEXTURE_STREAMING
+    uint32_t tail = 0;
+
+    while (tail + 1 < mipLevels && std::max(levels_[droppedLevels_ + tail].width, levels_[droppedLevels_ + tail].height) > vk::TEXTURE_STREAMING_TAIL_EDGE) {
+
+        tail++;
+
+    }
+
+    return tail;
+#else
+    return 0;
+#endif
+
+}
+
+uint32_t TextureImage::fitToBudget(
+    const std::vector< TextureLevel >&  levels_,
+    VkDeviceSize                        dataSize_,
+    uint32_t                            droppedLevels_
+    ) {
+
+    uint32_t maxDropped = getMaxDroppedLevels();
+    uint32_t dropped    = std::min(droppedLevels_, maxDropped);
+
+    while (dropped < maxDropped && vk::memory::pressure(dataSize_ - levels_[dropped].offset) > vk::RESIDENCY_HIGH_WATERMARK) {
+
+        dropped++;          // Each level left out quarters the size, a blurrier texture beats failing the allocation
+
+    }
+
+    return dropped;
+
+}
+
+VK_STATUS_CODE TextureImage::upload(
+    VkFormat                            format_,
+    const std::vector< TextureLevel >&  levels_,
+    const unsigned char*                data_,
+    VkDeviceSize                        dataSize_,
+    uint32_t                            droppedLevels_,
+    uint32_t                            streamedLevel_
+    ) {
+
+    VkDeviceSize base = levels_[droppedLevels_ + streamedLevel_].offset;        // The chain is packed largest level first, the uploaded levels are its tail
+    residentSize = dataSize_ - levels_[droppedLevels_].offset;
+
+    stagingBuffer = new BaseBuffer(dataSize_ - base, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    stagingBuffer->fill(data_ + base);
+
+    vk::createImage(
+        levels_[droppedLevels_].width, 
+        levels_[droppedLevels_].height, 
+        mipLevels, 
+        format_, 
+        tiling, 
+        usage, 
+        properties,
+        VK_SAMPLE_COUNT_1_BIT,
+        img,
+        mem
+        );
+
+    std::vector< VkBufferImageCopy > copyRegions(mipLevels - streamedLevel_);
+    for (uint32_t i = 0; i < copyRegions.size(); i++) {
+
+        const TextureLevel& level                       = levels_[droppedLevels_ + streamedLevel_ + i];
+
+        copyRegions[i]                                  = {};
+        copyRegions[i].bufferOffset                     = level.offset - base;
+        copyRegions[i].bufferRowLength                  = 0;
+        copyRegions[i].bufferImageHeight                = 0;
+        copyRegions[i].imageSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegions[i].imageSubresource.mipLevel        = streamedLevel_ + i;
+        copyRegions[i].imageSubresource.baseArrayLayer  = 0;
+        copyRegions[i].imageSubresource.layerCount      = 1;
+        copyRegions[i].imageOffset                      = { 0, 0, 0 };
+        copyRegions[i].imageExtent                      = { level.width, level.height, 1 };
+
+    }
+
+    vk::copyBufferToImage(          // Levels left to streamLevel() stay in the transfer layout, owned by the transfer queue
+        stagingBuffer->buf,
+        img,
+        copyRegions,
+        VK_IMAGE_LAYOUT_UNDEFINED
+        );
+    
+    delete stagingBuffer;
+
+    imgView = vk::createImageView(img, format_, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, componentMapping(format_), streamedLevel_);
+
+    return vk::errorCodeBuffer;
 
 }
 
@@ -160,10 +515,142 @@ VK_STATUS_CODE TextureImage::bind() {
 
 }
 
+VkDeviceSize TextureImage::getResidentSize() {
+
+    return residentSize;
+
+}
+
+uint32_t TextureImage::getDroppedLevels() {
+
+    return droppedLevels;
+
+}
+
+uint32_t TextureImage::getMaxDroppedLevels() {
+
+    uint32_t maxDropped = 0;
+    uint32_t levels     = mipLevels + droppedLevels;
+
+    while (maxDropped + 1 < levels && std::min(w >> (maxDropped + 1), h >> (maxDropped + 1)) >= static_cast< int >(vk::RESIDENCY_MIN_EDGE)) {
+
+        maxDropped++;
+
+    }
+
+    return maxDropped;
+
+}
+
+uint32_t TextureImage::getStreamedLevel() {
+
+    return streamedLevel;
+
+}
+
+std::shared_ptr< TextureSource > TextureImage::getStreamSource() {
+
+    return streamSource;
+
+}
+
+VK_STATUS_CODE TextureImage::streamLevel(TextureSource& source_, uint32_t level_) {
+
+    const TextureLevel& level = source_.levels[source_.droppedLevels + level_];
+
+    BaseBuffer* staging = new BaseBuffer(level.size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    staging->fill(source_.data + level.offset);
+
+    VkBufferImageCopy copyRegion                    = {};
+    copyRegion.bufferOffset                         = 0;
+    copyRegion.bufferRowLength                      = 0;
+    copyRegion.bufferImageHeight                    = 0;
+    copyRegion.imageSubresource.aspectMask          = VK_IMAGE_ASPECT_COLOR_BIT;
+    copyRegion.imageSubresource.mipLevel            = level_;
+    copyRegion.imageSubresource.baseArrayLayer      = 0;
+    copyRegion.imageSubresource.layerCount          = 1;
+    copyRegion.imageOffset                          = { 0, 0, 0 };
+    copyRegion.imageExtent                          = { level.width, level.height, 1 };
+
+    vk::copyBufferToImage(          // The level is outside of every view until showLevel(), frames in flight never see it change
+        staging->buf,
+        source_.image,
+        { copyRegion }
+        );
+
+    delete staging;
+
+    return vk::errorCodeBuffer;
+
+}
+
+VkImageView TextureImage::showLevel(const TextureSource* source_) {
+
+    if (streamSource.get() != source_ || streamedLevel == 0) return VK_NULL_HANDLE;
+
+    VkImageView previous = imgView;
+    streamedLevel--;
+    imgView = vk::createImageView(img, source_->format, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, componentMapping(source_->format), streamedLevel);
+
+    if (streamedLevel == 0) {
+
+        streamSource.reset();           // Releases the decoded chain or the cache mapping
+
+    }
+
+    return previous;
+
+}
+
+const std::string& TextureImage::getPath() {
+
+    return path;
+
+}
+
+VkFormat TextureImage::getRequestedFormat() {
+
+    return requestedFormat;
+
+}
+
+void TextureImage::touch(uint64_t frame_) {
+
+    lastUsed.store(frame_, std::memory_order_relaxed);
+
+}
+
+uint64_t TextureImage::getLastUsed() {
+
+    return lastUsed.load(std::memory_order_relaxed);
+
+}
+
+void TextureImage::swap(TextureImage& other_) {
+
+    std::swap(buf,              other_.buf);
+    std::swap(mem,              other_.mem);
+    std::swap(img,              other_.img);
+    std::swap(imgView,          other_.imgView);
+    std::swap(imgSampler,       other_.imgSampler);
+    std::swap(mipLevels,        other_.mipLevels);
+    std::swap(w,                other_.w);
+    std::swap(h,                other_.h);
+    std::swap(ch,               other_.ch);
+    std::swap(imageSize,        other_.imageSize);
+    std::swap(residentSize,     other_.residentSize);
+    std::swap(droppedLevels,    other_.droppedLevels);
+    std::swap(streamedLevel,    other_.streamedLevel);
+    std::swap(streamSource,     other_.streamSource);
+
+}
+
 TextureImage::~TextureImage() {
 
+    vk::untrackImage(img);
     vkDestroySampler(vk::core::logicalDevice, imgSampler, vk::core::allocator);
     vkDestroyImageView(vk::core::logicalDevice, imgView, vk::core::allocator);
     vkDestroyImage(vk::core::logicalDevice, img, vk::core::allocator);
+    vk::counters::add(FC_OBJECTS_DESTROYED, 2);       // The sampler and the view, untrackImage() counts the image
 
 }
@@ -11,8 +11,15 @@
 #define TEXTURE_IMAGE_HPP
 #include <vulkan/vulkan.h>
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "Logger.hpp"
 #include "BaseBuffer.hpp"
+#include "TextureLevel.cpp"
+#include "TextureSource.cpp"
 
 class TextureImage : 
     public BaseBuffer
@@ -34,15 +41,21 @@ public:
         @param      path_           (Relative) filepath to image resource
         @param      format_         The image format flags
         @param      tiling_         Image tiling flags
-        @param      usage_          Image usage flags
+        @param      usage_          Image usage flags, VK_IMAGE_USAGE_TRANSFER_DST_BIT is always added for the upload
         @param      properties_     Memory properties, defaults to VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        @param      droppedLevels_  The number of largest mip levels to leave out, more are left out if the texture
+                                    heap is near its budget
+        @param      streamed_       Whether to upload only the levels up to TEXTURE_STREAMING_TAIL_EDGE and leave the
+                                    larger ones to streamLevel(), requires VK_TEXTURE_STREAMING
     */
     TextureImage(
         const char*                 path_,
         VkFormat                    format_,
         VkImageTiling               tiling_,
         VkImageUsageFlags           usage_,
-        VkMemoryPropertyFlags       properties_      = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        VkMemoryPropertyFlags       properties_      = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        uint32_t                    droppedLevels_   = 0,
+        bool                        streamed_        = false
         );
 
     /**
@@ -52,6 +65,99 @@ public:
     */
     VK_STATUS_CODE bind(void);
 
+    /**
+        Returns the size of the uploaded mip chain
+
+        @return     Returns the size of the image data in bytes
+    */
+    VkDeviceSize getResidentSize(void);
+
+    /**
+        Returns how many of the largest mip levels are not resident
+
+        @return     Returns 0 if the full mip chain is resident
+    */
+    uint32_t getDroppedLevels(void);
+
+    /**
+        Returns how many of the largest mip levels may be left out before the texture gets smaller than RESIDENCY_MIN_EDGE
+
+        @return     Returns the maximum for droppedLevels_
+    */
+    uint32_t getMaxDroppedLevels(void);
+
+    /**
+        Returns how many of the largest allocated mip levels are not visible yet
+
+        @return     Returns 0 once the texture is fully streamed in
+    */
+    uint32_t getStreamedLevel(void);
+
+    /**
+        Returns the mip chain the missing levels are streamed from
+
+        @return     Returns nullptr once the texture is fully streamed in
+    */
+    std::shared_ptr< TextureSource > getStreamSource(void);
+
+    /**
+        Uploads a single mip level of a streamed texture and makes it sampleable, the level stays hidden until
+        showLevel() is called, may be called by any thread
+
+        @param      source_         The mip chain returned by getStreamSource()
+        @param      level_          The level of the image to upload, has to be getStreamedLevel() - 1
+
+        @return     Returns VK_SC_SUCCESS on success
+    */
+    static VK_STATUS_CODE streamLevel(TextureSource& source_, uint32_t level_);
+
+    /**
+        Shows the level uploaded by streamLevel() by replacing the image view, has to be called by the main thread
+        before the frame is recorded
+
+        @param      source_         The mip chain the level was uploaded from
+
+        @return     Returns the previous view, which has to outlive the frames in flight, or VK_NULL_HANDLE if the
+                    texture has been replaced in the meantime
+    */
+    VkImageView showLevel(const TextureSource* source_);
+
+    /**
+        Returns the path the texture was loaded from
+
+        @return     Returns the (relative) filepath passed to the constructor
+    */
+    const std::string& getPath(void);
+
+    /**
+        Returns the format the texture was requested with
+
+        @return     Returns the format passed to the constructor
+    */
+    VkFormat getRequestedFormat(void);
+
+    /**
+        Marks the texture as used by a frame, any thread may call it
+
+        @param      frame_          The number of the frame
+    */
+    void touch(uint64_t frame_);
+
+    /**
+        Returns the last frame that used the texture
+
+        @return     Returns the frame number passed to touch() last, 0 if the texture was never drawn
+    */
+    uint64_t getLastUsed(void);
+
+    /**
+        Exchanges the image, its view, sampler and memory with another texture, so a reloaded texture takes the place
+        of this one without any pointer to it changing
+
+        @param      other_          The texture to exchange the resources with
+    */
+    void swap(TextureImage& other_);
+
     /**
         Default destructor
     */
@@ -59,10 +165,91 @@ public:
 
 private:
 
-    int                 w, h, ch;
-    VkDeviceSize        imageSize               = 0;
-    BaseBuffer*         stagingBuffer;
-    VkImage             img;
+    int                         w, h, ch;
+    VkDeviceSize                imageSize               = 0;
+    VkDeviceSize                residentSize            = 0;
+    uint32_t                    droppedLevels           = 0;
+    uint32_t                    streamedLevel           = 0;
+    std::shared_ptr< TextureSource > streamSource;
+    std::string                 path;
+    VkFormat                    requestedFormat         = VK_FORMAT_UNDEFINED;
+    VkImageTiling               tiling                  = VK_IMAGE_TILING_OPTIMAL;
+    VkImageUsageFlags           usage                   = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    VkMemoryPropertyFlags       properties              = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    std::atomic< uint64_t >     lastUsed                = { 0 };
+    BaseBuffer*                 stagingBuffer;
+    VkImage                     img;
+
+    /**
+        Decodes the source image and builds its full mip chain in the final texture format
+
+        @param      path_           (Relative) filepath to image resource
+        @param      compression_    The block-compression mode to encode the mip chain with
+        @param      sRGB_           Whether the image holds sRGB-encoded color
+        @param      format_         Is set to the format of the mip chain
+        @param      levels_         Is filled with the mip levels, offsets are relative to data_
+        @param      data_           Is filled with the tightly packed mip chain
+
+        @return     Returns VK_SC_SUCCESS on success
+    */
+    VK_STATUS_CODE decode(
+        const char*                     path_,
+        uint32_t                        compression_,
+        bool                            sRGB_,
+        VkFormat&                       format_,
+        std::vector< TextureLevel >&    levels_,
+        std::vector< unsigned char >&   data_
+        );
+
+    /**
+        Creates the image and uploads a mip chain with a single copy
+
+        @param      format_         The format of the mip chain
+        @param      levels_         The mip levels, offsets are relative to data_
+        @param      data_           Pointer to the tightly packed mip chain
+        @param      dataSize_       The size of the mip chain in bytes
+        @param      droppedLevels_  The number of largest levels to leave out
+        @param      streamedLevel_  The first level of the image to upload, the larger ones are allocated but left to
+                                    streamLevel()
+
+        @return     Returns VK_SC_SUCCESS on success
+    */
+    VK_STATUS_CODE upload(
+        VkFormat                            format_,
+        const std::vector< TextureLevel >&  levels_,
+        const unsigned char*                data_,
+        VkDeviceSize                        dataSize_,
+        uint32_t                            droppedLevels_,
+        uint32_t                            streamedLevel_
+        );
+
+    /**
+        Picks the first level of the image that is uploaded right away when streaming
+
+        @param      levels_         The mip levels
+        @param      droppedLevels_  The number of largest levels left out
+
+        @return     Returns the first allocated level no larger than TEXTURE_STREAMING_TAIL_EDGE
+    */
+    uint32_t streamingTail(
+        const std::vector< TextureLevel >&  levels_,
+        uint32_t                            droppedLevels_
+        );
+
+    /**
+        Picks how many of the largest levels to leave out so the rest fits into the texture heap's budget
+
+        @param      levels_         The mip levels
+        @param      dataSize_       The size of the mip chain in bytes
+        @param      droppedLevels_  The number of levels the caller asked to leave out
+
+        @return     Returns at least droppedLevels_, at most getMaxDroppedLevels()
+    */
+    uint32_t fitToBudget(
+        const std::vector< TextureLevel >&  levels_,
+        VkDeviceSize                        dataSize_,
+        uint32_t                            droppedLevels_
+        );
 
 };
 #endif  // TEXTURE_IMAGE_HPP
@@ -0,0 +1,25 @@
+/**
+    Defines the TextureLevel struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureLevel.cpp
+    @brief        Definition of the TextureLevel struct
+*/
+#ifndef TEXTURE_LEVEL_CPP
+#define TEXTURE_LEVEL_CPP
+#include <vulkan/vulkan.h>
+
+/**
+    Describes where a single mip level lives inside a tightly packed mip chain
+*/
+struct TextureLevel {
+
+    uint32_t            width;
+    uint32_t            height;
+    VkDeviceSize        offset;
+    VkDeviceSize        size;
+
+};
+#endif  // TEXTURE_LEVEL_CPP
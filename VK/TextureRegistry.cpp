@@ -0,0 +1,359 @@
+/**
+    Implements the textures namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureRegistry.cpp
+    @brief        Implementation of the textures namespace, the process-wide texture registry
+*/
+#include "TextureRegistry.hpp"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <cstring>
+
+#include "VK.hpp"
+#include "FileIO.hpp"
+
+namespace vk {
+
+    namespace textures {
+
+        /**
+            A registered texture, shared by every path that resolved to the same content
+        */
+        struct Entry {
+
+            std::promise< TextureImage* >               promise;
+            std::shared_future< TextureImage* >         ready;
+            TextureImage*                               image           = nullptr;      // Set once the decode has finished
+            uint32_t                                    references      = 0;
+            uint64_t                                    hash            = 0;
+            std::vector< std::string >                  paths;
+
+        };
+
+        Mutex                                                               registryMutex("texture_registry");
+        std::unordered_map< std::string, std::shared_ptr< Entry > >         byPath;
+        std::unordered_map< uint64_t, std::shared_ptr< Entry > >            byContent;
+        std::unordered_map< TextureImage*, std::shared_ptr< Entry > >       byImage;
+        TextureRegistryStats                                                registryStats       = {};
+        Gauge*                                                              liveTextures        = vk::metrics::gauge("assets_textures_live", "Textures currently referenced");
+
+        /**
+            Hashes the content of a file 8 bytes at a time
+        */
+        static uint64_t contentHash(const std::string& path_) {
+
+            std::shared_ptr< FileData > file = vk::io::read(path_);       // Maps the file the decode reads afterwards, it is only faulted in once
+            uint64_t hash = 0xCBF29CE484222325ull;
+            if (!file) return hash;
+
+            const unsigned char* data   = file->data();
+            size_t size                 = file->size();
+            size_t i                    = 0;
+
+            for (; i + 8 <= size; i += 8) {
+
+                uint64_t word;
+                std::memcpy(&word, data + i, 8);
+                hash = (hash ^ word) * 0x100000001B3ull;
+                hash ^= hash >> 29;
+
+            }
+
+            if (i < size) {
+
+                uint64_t word = 0;
+                std::memcpy(&word, data + i, size - i);
+                hash = (hash ^ word) * 0x100000001B3ull;
+                hash ^= hash >> 29;
+
+            }
+
+            return hash ^ size;
+
+        }
+
+        TextureImage* acquire(const std::string& path_, VkFormat format_) {
+
+            std::string path = vk::io::canonicalPath(path_);
+
+            std::unique_lock< Mutex > lock(registryMutex);
+            auto pathIt = byPath.find(path);
+            if (pathIt != byPath.end()) {
+
+                std::shared_ptr< Entry > entry = pathIt->second;
+                entry->references++;
+                registryStats.pathHits++;
+                lock.unlock();
+
+                return entry->ready.get();       // Rethrows for every waiter if the decode failed
+
+            }
+            lock.unlock();
+
+            uint64_t hash = contentHash(path);     // Only paths seen for the first time pay for reading the file
+
+            lock.lock();
+            pathIt = byPath.find(path);
+            auto contentIt = byContent.find(hash);
+            if (pathIt != byPath.end() || contentIt != byContent.end()) {
+
+                std::shared_ptr< Entry > entry = pathIt != byPath.end() ? pathIt->second : contentIt->second;
+                entry->references++;
+
+                if (pathIt == byPath.end()) {
+
+                    byPath[path] = entry;
+                    entry->paths.push_back(path);
+                    registryStats.contentHits++;
+
+                }
+                else {
+
+                    registryStats.pathHits++;
+
+                }
+                lock.unlock();
+
+                return entry->ready.get();       // Rethrows for every waiter if the decode failed
+
+            }
+
+            std::shared_ptr< Entry > entry  = std::make_shared< Entry >();
+            entry->ready                    = entry->promise.get_future().share();
+            entry->references               = 1;
+            entry->hash                     = hash;
+            entry->paths.push_back(path);
+
+            byPath[path]                    = entry;
+            byContent[hash]                 = entry;
+            registryStats.misses++;
+            lock.unlock();
+
+            TextureImage* texture = nullptr;
+            try {
+
+                texture = new TextureImage(
+                    path_.c_str(),
+                    format_,
+                    VK_IMAGE_TILING_OPTIMAL,
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    0,
+                    true            // Shows up with its small levels, TextureResidency streams in the rest
+                    );
+
+            }
+            catch (...) {
+
+                lock.lock();
+                for (const auto& p : entry->paths) {
+
+                    byPath.erase(p);
+
+                }
+                byContent.erase(hash);
+                lock.unlock();
+
+                entry->promise.set_exception(std::current_exception());
+                throw;
+
+            }
+
+            lock.lock();
+            byImage[texture] = entry;
+            entry->image = texture;
+            registryStats.liveTextures++;
+            liveTextures->add(1);
+            lock.unlock();
+
+            entry->promise.set_value(texture);
+
+            return texture;
+
+        }
+
+        bool retain(TextureImage* texture_) {
+
+            std::scoped_lock< Mutex > lock(registryMutex);
+            auto imageIt = byImage.find(texture_);
+            if (imageIt == byImage.end()) return false;
+
+            imageIt->second->references++;
+
+            return true;
+
+        }
+
+        void release(TextureImage* texture_) {
+
+            std::unique_lock< Mutex > lock(registryMutex);
+            auto imageIt = byImage.find(texture_);
+            if (imageIt == byImage.end()) return;
+
+            std::shared_ptr< Entry > entry = imageIt->second;
+            if (--entry->references > 0) return;
+
+            for (const auto& path : entry->paths) {
+
+                byPath.erase(path);
+
+            }
+            auto contentIt = byContent.find(entry->hash);
+            if (contentIt != byContent.end() && contentIt->second == entry) {
+
+                byContent.erase(contentIt);         // A reloaded texture may share its new hash with another entry
+
+            }
+            byImage.erase(imageIt);
+            registryStats.liveTextures--;
+            liveTextures->add(-1);
+            lock.unlock();
+
+            delete texture_;
+
+        }
+
+        TextureImage* find(const std::string& path_) {
+
+            std::string path = vk::io::canonicalPath(path_);
+
+            std::scoped_lock< Mutex > lock(registryMutex);
+            auto pathIt = byPath.find(path);
+
+            return pathIt != byPath.end() ? pathIt->second->image : nullptr;
+
+        }
+
+        uint64_t hash(const std::string& path_) {
+
+            return contentHash(vk::io::canonicalPath(path_));
+
+        }
+
+        bool shared(const std::string& path_) {
+
+            std::string path = vk::io::canonicalPath(path_);
+
+            std::scoped_lock< Mutex > lock(registryMutex);
+            auto pathIt = byPath.find(path);
+
+            return pathIt != byPath.end() && pathIt->second->paths.size() > 1;
+
+        }
+
+        void rehash(TextureImage* texture_, uint64_t hash_) {
+
+            std::scoped_lock< Mutex > lock(registryMutex);
+            auto imageIt = byImage.find(texture_);
+            if (imageIt == byImage.end()) return;
+
+            std::shared_ptr< Entry > entry = imageIt->second;
+            auto contentIt = byContent.find(entry->hash);
+            if (contentIt != byContent.end() && contentIt->second == entry) {
+
+                byContent.erase(contentIt);
+
+            }
+
+            entry->hash = hash_;
+            byContent.emplace(hash_, entry);        // Keeps an existing entry with the same content, it was there first
+
+        }
+
+        bool split(const std::string& path_, TextureImage* texture_, uint32_t references_, uint64_t hash_) {
+
+            std::string path = vk::io::canonicalPath(path_);
+
+            std::scoped_lock< Mutex > lock(registryMutex);
+            auto pathIt = byPath.find(path);
+            if (pathIt == byPath.end()) return false;
+
+            std::shared_ptr< Entry > old = pathIt->second;
+            old->paths.erase(std::remove(old->paths.begin(), old->paths.end(), path), old->paths.end());
+            byPath.erase(pathIt);
+
+            if (references_ > 0) {
+
+                std::shared_ptr< Entry > entry  = std::make_shared< Entry >();
+                entry->ready                    = entry->promise.get_future().share();
+                entry->image                    = texture_;
+                entry->references               = references_;
+                entry->hash                     = hash_;
+                entry->paths.push_back(path);
+                entry->promise.set_value(texture_);
+
+                byPath[path]                    = entry;
+                byImage[texture_]               = entry;
+                byContent.emplace(hash_, entry);        // Keeps an existing entry with the same content, it was there first
+                registryStats.liveTextures++;
+                liveTextures->add(1);
+
+            }
+
+            old->references -= std::min(old->references, references_);
+            if (old->references > 0) return false;
+
+            for (const auto& oldPath : old->paths) {
+
+                byPath.erase(oldPath);
+
+            }
+            auto contentIt = byContent.find(old->hash);
+            if (contentIt != byContent.end() && contentIt->second == old) {
+
+                byContent.erase(contentIt);
+
+            }
+            byImage.erase(old->image);
+            registryStats.liveTextures--;
+            liveTextures->add(-1);
+
+            return true;
+
+        }
+
+        void live(std::vector< TextureImage* >& textures_) {
+
+            textures_.clear();
+
+            std::scoped_lock< Mutex > lock(registryMutex);
+            for (const auto& image : byImage) {
+
+                textures_.push_back(image.first);
+
+            }
+
+        }
+
+        TextureRegistryStats stats() {
+
+            std::scoped_lock< Mutex > lock(registryMutex);
+
+            return registryStats;
+
+        }
+
+        void logStats() {
+
+            TextureRegistryStats snapshot = stats();
+
+            logger::log(EVENT_LOG, "Texture registry: "
+                + std::to_string(snapshot.misses) + " decoded, "
+                + std::to_string(snapshot.pathHits) + " path hits, "
+                + std::to_string(snapshot.contentHits) + " content hits, "
+                + std::to_string(snapshot.liveTextures) + " live"
+                );
+
+        }
+
+    }
+
+}
@@ -0,0 +1,125 @@
+/**
+    Prototypes the textures namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureRegistry.hpp
+    @brief        Prototype of the textures namespace, the process-wide texture registry
+*/
+#ifndef TEXTURE_REGISTRY_HPP
+#define TEXTURE_REGISTRY_HPP
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+
+#include "TextureImage.hpp"
+#include "TextureRegistryStats.cpp"
+
+namespace vk {
+
+    /**
+        Shares TextureImages between all models and loader threads, keyed by canonical path and by content hash
+    */
+    namespace textures {
+
+        /**
+            Returns a reference-counted texture, decoding and uploading it only if neither its canonical path nor its
+            content is known yet. Concurrent requests for a texture that is still being decoded wait for that decode.
+
+            @param      path_       (Relative) filepath to the image resource
+            @param      format_     The requested image format, see TextureImage
+
+            @return     Returns a pointer to the shared texture, which has to be handed back with release
+        */
+        TextureImage* acquire(const std::string& path_, VkFormat format_);
+
+        /**
+            Adds a reference to a texture that is still registered, so it outlives work started on it
+
+            @param      texture_    A texture previously returned by acquire or live
+
+            @return     Returns false if the texture has been destroyed already, it must not be released then
+        */
+        bool retain(TextureImage* texture_);
+
+        /**
+            Drops a reference to a texture and destroys it once no model references it anymore
+
+            @param      texture_    A texture previously returned by acquire
+        */
+        void release(TextureImage* texture_);
+
+        /**
+            Looks up a texture that has finished loading, without taking a reference
+
+            @param      path_       (Relative) filepath to the image resource
+
+            @return     Returns the texture or nullptr if the path is not loaded (yet)
+        */
+        TextureImage* find(const std::string& path_);
+
+        /**
+            Hashes the content of a texture file the way the registry does
+
+            @param      path_       (Relative) filepath to the image resource
+
+            @return     Returns the content hash
+        */
+        uint64_t hash(const std::string& path_);
+
+        /**
+            Checks whether other paths resolved to the same texture as a path because their content was identical
+
+            @param      path_       (Relative) filepath to the image resource
+
+            @return     Returns true if the path's texture is shared with another path
+        */
+        bool shared(const std::string& path_);
+
+        /**
+            Replaces the content hash of a texture whose only path changed on disk, so new paths with the old content
+            no longer resolve to it
+
+            @param      texture_    A texture previously returned by acquire
+            @param      hash_       The hash of the new content, see hash
+        */
+        void rehash(TextureImage* texture_, uint64_t hash_);
+
+        /**
+            Gives a path that changed on disk its own entry, the other paths sharing its texture keep the old one
+
+            @param      path_           (Relative) filepath to the image resource
+            @param      texture_        The texture decoded from the new content
+            @param      references_     The references moved from the old texture to texture_, with 0 the path is only
+                                        forgotten and texture_ is not registered
+            @param      hash_           The hash of the new content, see hash
+
+            @return     Returns true if the old texture lost its last reference, the caller has to destroy it
+        */
+        bool split(const std::string& path_, TextureImage* texture_, uint32_t references_, uint64_t hash_);
+
+        /**
+            Lists every texture that has finished loading
+
+            @param      textures_   Is cleared and filled with the textures
+        */
+        void live(std::vector< TextureImage* >& textures_);
+
+        /**
+            Returns the lookup statistics of the registry
+
+            @return     Returns a TextureRegistryStats snapshot
+        */
+        TextureRegistryStats stats(void);
+
+        /**
+            Writes the lookup statistics of the registry to the event log
+        */
+        void logStats(void);
+
+    }
+
+}
+#endif  // TEXTURE_REGISTRY_HPP
@@ -0,0 +1,25 @@
+/**
+    Defines the TextureRegistryStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureRegistryStats.cpp
+    @brief        Definition of the TextureRegistryStats struct
+*/
+#ifndef TEXTURE_REGISTRY_STATS_CPP
+#define TEXTURE_REGISTRY_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the lookup statistics of the texture registry
+*/
+struct TextureRegistryStats {
+
+    uint64_t            pathHits;           // Requests for a path that was already loaded or in flight
+    uint64_t            contentHits;        // Requests for a new path whose file content matched a loaded texture
+    uint64_t            misses;             // Requests that had to decode and upload
+    uint64_t            liveTextures;       // Textures currently referenced
+
+};
+#endif  // TEXTURE_REGISTRY_STATS_CPP
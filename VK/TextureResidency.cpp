@@ -0,0 +1,343 @@
+/**
+    Implements the TextureResidency class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureResidency.cpp
+    @brief        Implementation of the TextureResidency class, keeps the textures within the device memory budget
+*/
+#include "TextureResidency.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#include "VK.hpp"
+
+namespace {
+
+    const uint64_t          UPDATE_INTERVAL         = 30;       // Frames between two budget checks, the driver's budget changes slowly
+    const size_t            MAX_PENDING             = 2;        // Replacements built at a time, each holds a decoded mip chain
+
+}
+
+TextureResidency::TextureResidency(JobSystem* jobSystem_) : jobSystem(jobSystem_) {
+
+}
+
+void TextureResidency::update() {
+
+    static Counter* levelsDropped   = vk::metrics::counter("memory_residency_levels_dropped_total", "Times a texture lost its largest mip level to the memory budget");
+    static Counter* levelsRestored  = vk::metrics::counter("memory_residency_levels_restored_total", "Times a texture got a dropped mip level back");
+    static Gauge*   texturesReduced = vk::metrics::gauge("memory_residency_textures_reduced", "Live textures missing mip levels");
+    static Counter* levelsStreamed  = vk::metrics::counter("assets_texture_levels_streamed_total", "Mip levels uploaded after their texture was first shown");
+
+    frame++;
+
+    pending.erase(std::remove_if(pending.begin(), pending.end(), [](const JobHandle& job_) { return job_->done.load(); }), pending.end());
+
+    applying.clear();
+    {
+
+        std::scoped_lock< std::mutex > lock(readyMutex);
+        applying.swap(ready);
+
+    }
+
+    for (auto& replacement : applying) {
+
+        busy.erase(replacement.target);
+
+        if (replacement.source) {
+
+            streaming--;
+            VkImageView previous = replacement.uploaded ? replacement.target->showLevel(replacement.source.get()) : VK_NULL_HANDLE;
+
+            if (previous != VK_NULL_HANDLE) {
+
+                vk::deletion::retire([previous]() {
+
+                    vkDestroyImageView(vk::core::logicalDevice, previous, vk::core::allocator);
+                    vk::counters::add(FC_OBJECTS_DESTROYED);
+
+                    });
+
+                std::scoped_lock< std::mutex > lock(readyMutex);
+                residencyStats.levelsStreamed++;
+                levelsStreamed->add();
+
+            }
+
+        }
+        else if (replacement.fresh != nullptr) {
+
+            rebuilding--;
+
+            VkDeviceSize before = replacement.target->getResidentSize();
+            replacement.target->swap(*replacement.fresh);
+            VkDeviceSize after  = replacement.target->getResidentSize();
+            TextureImage* fresh = replacement.fresh;
+            vk::deletion::retire([fresh]() { delete fresh; });           // Now holds the old image
+
+            std::scoped_lock< std::mutex > lock(readyMutex);
+            if (after < before) {
+
+                residencyStats.levelsDropped++;
+                residencyStats.bytesReleased += before - after;
+                levelsDropped->add();
+
+            }
+            else {
+
+                residencyStats.levelsRestored++;
+                levelsRestored->add();
+
+            }
+
+        }
+        else {
+
+            rebuilding--;
+
+        }
+
+        vk::textures::release(replacement.target);          // Destroys the texture if every model let go of it meanwhile
+
+    }
+
+    streamDrawn();
+
+    if (frame % UPDATE_INTERVAL != 0) return;
+
+    vk::memory::refresh();
+    double pressure = vk::memory::pressure();
+
+    vk::textures::live(textures);
+    uint32_t reduced = 0;
+    uint32_t missing = 0;
+    for (TextureImage* texture : textures) {
+
+        reduced += texture->getDroppedLevels() > 0 ? 1 : 0;
+        missing += texture->getDroppedLevels();
+
+    }
+    texturesReduced->set(reduced);
+
+    {
+
+        std::scoped_lock< std::mutex > lock(readyMutex);
+        residencyStats.texturesReduced  = reduced;
+        residencyStats.levelsMissing    = missing;
+        residencyStats.pressure         = pressure;
+
+    }
+
+    if (rebuilding >= MAX_PENDING) return;
+
+    TextureImage* candidate = nullptr;
+
+    if (pressure > vk::RESIDENCY_HIGH_WATERMARK) {
+
+        for (TextureImage* texture : textures) {       // The least recently drawn texture that can still lose a level
+
+            if (busy.count(texture) || texture->getDroppedLevels() >= texture->getMaxDroppedLevels()) continue;
+            if (candidate == nullptr || texture->getLastUsed() < candidate->getLastUsed()) candidate = texture;
+
+        }
+
+        if (candidate != nullptr) {
+
+            VK_LOG_DEBUG(LC_MEMORY, "Texture heap at {} of its budget, dropping a mip level of {}", pressure, candidate->getPath());
+            submit(candidate, candidate->getDroppedLevels() + 1);
+
+        }
+
+    }
+    else if (pressure < vk::RESIDENCY_LOW_WATERMARK && reduced > 0) {
+
+        uint64_t recent = vk::counters::frame() > UPDATE_INTERVAL ? vk::counters::frame() - UPDATE_INTERVAL : 0;
+
+        for (TextureImage* texture : textures) {       // The most recently drawn reduced texture, it is the one that is needed
+
+            if (busy.count(texture) || texture->getDroppedLevels() == 0 || texture->getLastUsed() < recent) continue;
+            if (candidate == nullptr || texture->getLastUsed() > candidate->getLastUsed()) candidate = texture;
+
+        }
+
+        if (candidate != nullptr && vk::memory::pressure(candidate->getResidentSize() * 3) < vk::RESIDENCY_HIGH_WATERMARK) {       // One more level quadruples the size
+
+            submit(candidate, candidate->getDroppedLevels() - 1);
+
+        }
+
+    }
+
+}
+
+void TextureResidency::streamDrawn() {
+
+    static Gauge* texturesStreaming = vk::metrics::gauge("assets_textures_streaming", "Live textures still waiting for streamed mip levels");
+
+    vk::textures::live(textures);
+
+    textures.erase(std::remove_if(textures.begin(), textures.end(), [](TextureImage* texture_) { return texture_->getStreamedLevel() == 0; }), textures.end());
+    texturesStreaming->set(static_cast< int64_t >(textures.size()));
+
+    {
+
+        std::scoped_lock< std::mutex > lock(readyMutex);
+        residencyStats.texturesStreaming = static_cast< uint32_t >(textures.size());
+
+    }
+
+    if (streaming >= vk::TEXTURE_STREAMING_UPLOADS) return;
+
+    uint64_t now = vk::counters::frame();
+    textures.erase(std::remove_if(textures.begin(), textures.end(), [this, now](TextureImage* texture_) {
+
+        return busy.count(texture_) || texture_->getLastUsed() + UPDATE_INTERVAL < now;        // Only what is on screen is worth the upload
+
+        }), textures.end());
+
+    std::sort(textures.begin(), textures.end(), [](TextureImage* a_, TextureImage* b_) {
+
+        if (a_->getLastUsed() != b_->getLastUsed()) return a_->getLastUsed() > b_->getLastUsed();
+
+        return a_->getStreamedLevel() > b_->getStreamedLevel();     // The blurriest first
+
+        });
+
+    for (size_t i = 0; i < textures.size() && streaming < vk::TEXTURE_STREAMING_UPLOADS; i++) {
+
+        stream(textures[i]);
+
+    }
+
+}
+
+void TextureResidency::stream(TextureImage* target_) {
+
+    if (!vk::textures::retain(target_)) return;
+
+    busy.insert(target_);
+    streaming++;
+
+    std::shared_ptr< TextureSource > source     = target_->getStreamSource();
+    uint32_t level                              = target_->getStreamedLevel() - 1;
+    std::string path                            = target_->getPath();
+
+    pending.push_back(jobSystem->submit([this, target_, source, level, path]() {
+
+        Replacement replacement     = {};
+        replacement.target          = target_;
+        replacement.source          = source;
+
+        try {
+
+            TextureImage::streamLevel(*source, level);
+            replacement.uploaded = true;
+
+        }
+        catch (const std::exception& exception) {
+
+            VK_LOG_WARNING(LC_MEMORY, "Failed to stream mip level {} of texture '{}': {}", level, path, exception.what());
+
+        }
+
+        std::scoped_lock< std::mutex > lock(readyMutex);
+        if (!replacement.uploaded) residencyStats.failed++;
+        ready.push_back(replacement);
+
+        }));
+
+}
+
+void TextureResidency::submit(TextureImage* target_, uint32_t droppedLevels_) {
+
+    if (!vk::textures::retain(target_)) return;
+
+    busy.insert(target_);
+    rebuilding++;
+
+    std::string path    = target_->getPath();
+    VkFormat format     = target_->getRequestedFormat();
+
+    pending.push_back(jobSystem->submit([this, target_, droppedLevels_, path, format]() {
+
+        Replacement replacement     = {};
+        replacement.target          = target_;
+
+        try {
+
+            replacement.fresh = new TextureImage(
+                path.c_str(),
+                format,
+                VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                droppedLevels_
+                );
+
+        }
+        catch (const std::exception& exception) {
+
+            VK_LOG_WARNING(LC_MEMORY, "Failed to rebuild texture '{}' for residency: {}", path, exception.what());
+
+        }
+
+        std::scoped_lock< std::mutex > lock(readyMutex);
+        if (replacement.fresh == nullptr) residencyStats.failed++;
+        ready.push_back(replacement);
+
+        }));
+
+}
+
+bool TextureResidency::holds(TextureImage* texture_) {
+
+    return busy.count(texture_) > 0;
+
+}
+
+ResidencyStats TextureResidency::stats() {
+
+    std::scoped_lock< std::mutex > lock(readyMutex);
+
+    return residencyStats;
+
+}
+
+void TextureResidency::logStats() {
+
+    ResidencyStats snapshot = stats();
+
+    logger::log(EVENT_LOG, "Texture residency: "
+        + std::to_string(snapshot.levelsDropped) + " levels dropped, "
+        + std::to_string(snapshot.levelsRestored) + " restored, "
+        + std::to_string(snapshot.bytesReleased >> 20) + " MiB released, "
+        + std::to_string(snapshot.failed) + " failed, "
+        + std::to_string(snapshot.levelsStreamed) + " levels streamed, "
+        + std::to_string(snapshot.texturesStreaming) + " textures streaming, "
+        + std::to_string(snapshot.texturesReduced) + " textures missing "
+        + std::to_string(snapshot.levelsMissing) + " levels, "
+        + std::to_string(snapshot.pressure * 100.0) + "% of the texture heap budget"
+        );
+
+}
+
+TextureResidency::~TextureResidency() {
+
+    try {
+
+        jobSystem->wait(pending);
+
+    }
+    catch (...) {}
+
+    for (auto& replacement : ready) {
+
+        delete replacement.fresh;
+        vk::textures::release(replacement.target);
+
+    }
+}
@@ -0,0 +1,119 @@
+/**
+    Declares the TextureResidency class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureResidency.hpp
+    @brief        Declaration of the TextureResidency class, keeps the textures within the device memory budget
+*/
+#ifndef TEXTURE_RESIDENCY_HPP
+#define TEXTURE_RESIDENCY_HPP
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "JobSystem.hpp"
+#include "TextureImage.hpp"
+#include "ResidencyStats.cpp"
+
+/**
+    Watches the heap textures are allocated from. Near its budget the least recently drawn textures are rebuilt without
+    their largest mip level, once there is room again the dropped levels of recently drawn textures are streamed back
+    one at a time. Replacements are built on the job system and swapped in at the start of a frame, like hot reloads.
+    Textures loaded with only their small levels get their larger ones uploaded the same way while they are drawn.
+*/
+class TextureResidency {
+public:
+
+    /**
+        Constructor
+
+        @param      jobSystem_      The job system to build replacements on
+    */
+    explicit TextureResidency(JobSystem* jobSystem_);
+
+    /**
+        Swaps in finished replacements and starts new ones if the texture heap is out of balance, has to be called by
+        the main thread once per frame before the frame is recorded
+    */
+    void update(void);
+
+    /**
+        Returns whether a replacement or a streamed level is being built for a texture, its image must not be swapped
+        out or destroyed meanwhile
+
+        @param      texture_        The texture
+
+        @return     Returns true if a job may still write to the texture's image
+    */
+    bool holds(TextureImage* texture_);
+
+    /**
+        Returns the residency statistics
+
+        @return     Returns a ResidencyStats snapshot
+    */
+    ResidencyStats stats(void);
+
+    /**
+        Writes the residency statistics to the event log
+    */
+    void logStats(void);
+
+    /**
+        Default destructor, destroys pending replacements, the device has to be idle
+    */
+    ~TextureResidency(void);
+
+private:
+
+    /**
+        A texture rebuilt with a different number of resident mip levels or a streamed level, waiting for the next
+        frame boundary
+    */
+    struct Replacement {
+
+        TextureImage*                                   target;
+        TextureImage*                                   fresh;          // nullptr if it could not be built
+        std::shared_ptr< TextureSource >                source;         // Set instead of fresh for a streamed level
+        bool                                            uploaded;       // Whether the streamed level could be uploaded
+
+    };
+
+    JobSystem*                                          jobSystem;
+    std::vector< JobHandle >                            pending;
+    std::vector< Replacement >                          ready;
+    std::vector< Replacement >                          applying;       // Scratch space of update()
+    std::mutex                                          readyMutex;
+    std::unordered_set< TextureImage* >                 busy;           // Textures a replacement is being built for
+    uint32_t                                            rebuilding      = 0;
+    uint32_t                                            streaming       = 0;
+    std::vector< TextureImage* >                        textures;       // Scratch space of update()
+    uint64_t                                            frame           = 0;
+    ResidencyStats                                      residencyStats  = {};
+
+    /**
+        Builds a replacement for a texture on the job system
+
+        @param      target_             The texture to replace
+        @param      droppedLevels_      The number of largest mip levels the replacement leaves out
+    */
+    void submit(TextureImage* target_, uint32_t droppedLevels_);
+
+    /**
+        Uploads the next larger mip level of a streamed texture on the job system
+
+        @param      target_             The texture to refine
+    */
+    void stream(TextureImage* target_);
+
+    /**
+        Starts streaming the textures drawn most recently that are still missing levels
+    */
+    void streamDrawn(void);
+};
+#endif  // TEXTURE_RESIDENCY_HPP
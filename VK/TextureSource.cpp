@@ -0,0 +1,34 @@
+/**
+    Defines the TextureSource struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TextureSource.cpp
+    @brief        Definition of the TextureSource struct
+*/
+#ifndef TEXTURE_SOURCE_CPP
+#define TEXTURE_SOURCE_CPP
+#include <vulkan/vulkan.h>
+
+#include <memory>
+#include <vector>
+
+#include "TextureCache.hpp"
+#include "TextureLevel.cpp"
+
+/**
+    Keeps the mip chain of a streamed texture alive until all of its levels have been uploaded
+*/
+struct TextureSource {
+
+    std::unique_ptr< TextureCache >     cache;                  // Set if the chain is mapped from the texture cache
+    std::vector< unsigned char >        chain;                  // Holds the chain if it was decoded
+    std::vector< TextureLevel >         levels;
+    const unsigned char*                data;                   // Points into cache or chain
+    VkFormat                            format;
+    VkImage                             image;
+    uint32_t                            droppedLevels;          // Level i of the image is levels[droppedLevels + i]
+
+};
+#endif  // TEXTURE_SOURCE_CPP
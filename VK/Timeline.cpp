@@ -0,0 +1,405 @@
+/**
+    Implements the timeline namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Timeline.cpp
+    @brief        Implementation of the timeline namespace, a monotonically increasing completion counter per queue
+*/
+#include "Timeline.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "VK.hpp"
+#include "ASSERT.cpp"
+
+namespace vk {
+
+    namespace timeline {
+
+        namespace {
+
+            /**
+                A submission to an emulated timeline and the fence it signals
+            */
+            struct Submission {
+
+                uint64_t                            value;
+                VkFence                             fence;
+                uint32_t                            waiters;            // Threads waiting on the fence, it is only recycled without any
+
+            };
+
+            /**
+                The timeline of one queue
+            */
+            struct QueueTimeline {
+
+                const char*                         name;
+                VkSemaphore                         semaphore           = VK_NULL_HANDLE;       // Only with VK_KHR_timeline_semaphore
+                uint64_t                            submitted           = 0;
+                uint64_t                            completed           = 0;                    // Lags behind the device, never ahead of it
+                std::deque< Submission >            inFlight;                                   // Emulation: submissions not known to have finished
+                std::vector< VkFence >              spare;                                      // Emulation: fences that were reset for reuse
+                std::mutex                          mutex;
+
+                explicit QueueTimeline(const char* name_) : name(name_) {}
+
+            };
+
+            const uint32_t                          MAX_SIGNAL_SEMAPHORES   = 4;
+
+            VkDevice                                device                  = VK_NULL_HANDLE;
+            bool                                    native                  = false;
+            QueueTimeline                           timelines[2]            = { QueueTimeline("graphics"), QueueTimeline("transfer") };
+            PFN_vkGetSemaphoreCounterValueKHR       getCounterValue         = nullptr;
+            PFN_vkWaitSemaphoresKHR                 waitSemaphores          = nullptr;
+            std::mutex                              statsMutex;
+            TimelineStats                           timelineStats           = {};
+
+            QueueTimeline& timelineOf(Queue queue_) {
+
+                return timelines[queue_ == TRANSFER_QUEUE ? 1 : 0];
+
+            }
+
+            /**
+                Recycles the fences of emulated submissions that have finished, the timeline's mutex has to be held
+            */
+            void retireSignaled(QueueTimeline& timeline_) {
+
+                while (!timeline_.inFlight.empty()) {
+
+                    Submission& front = timeline_.inFlight.front();
+                    if (front.value > timeline_.completed) {
+
+                        if (vkGetFenceStatus(device, front.fence) != VK_SUCCESS) break;
+                        timeline_.completed = front.value;          // Submissions to a queue finish in order
+
+                    }
+                    if (front.waiters > 0) break;
+
+                    vkResetFences(device, 1, &front.fence);
+                    timeline_.spare.push_back(front.fence);
+                    timeline_.inFlight.pop_front();
+
+                }
+
+            }
+
+        }
+
+        VK_STATUS_CODE init(VkDevice device_, bool timelineSemaphores_) {
+
+            device = device_;
+
+            if (timelineSemaphores_) {
+
+                getCounterValue = reinterpret_cast< PFN_vkGetSemaphoreCounterValueKHR >(vkGetDeviceProcAddr(device, "vkGetSemaphoreCounterValueKHR"));
+                waitSemaphores  = reinterpret_cast< PFN_vkWaitSemaphoresKHR >(vkGetDeviceProcAddr(device, "vkWaitSemaphoresKHR"));
+                native          = getCounterValue != nullptr && waitSemaphores != nullptr;
+
+            }
+
+            if (native) {
+
+                VkSemaphoreTypeCreateInfoKHR typeCreateInfo    = {};
+                typeCreateInfo.sType                            = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+                typeCreateInfo.semaphoreType                    = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+                typeCreateInfo.initialValue                     = 0;
+
+                VkSemaphoreCreateInfo semaphoreCreateInfo       = {};
+                semaphoreCreateInfo.sType                       = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+                semaphoreCreateInfo.pNext                       = &typeCreateInfo;
+
+                for (auto& timeline : timelines) {
+
+                    VkResult result = vkCreateSemaphore(
+                        device,
+                        &semaphoreCreateInfo,
+                        vk::core::allocator,
+                        &timeline.semaphore
+                        );
+                    ASSERT(result, "Failed to create timeline semaphore", VK_SC_SEMAPHORE_CREATION_ERROR);
+
+                }
+
+            }
+
+            timelineStats.native = native;
+            VK_LOG_INFO(LC_RENDER, "Queue timelines use {}", native ? "VK_KHR_timeline_semaphore" : "a fence per submission");
+
+            return vk::errorCodeBuffer;
+
+        }
+
+        VkResult submit(Queue queue_, VkSubmitInfo submitInfo_, uint64_t* value_) {
+
+            QueueTimeline& timeline = timelineOf(queue_);
+            VkQueue queue           = queue_ == TRANSFER_QUEUE ? vk::transferQueue : vk::graphicsQueue;
+
+            std::scoped_lock< std::mutex > lock(timeline.mutex);
+            uint64_t value = timeline.submitted + 1;
+            VkResult result;
+
+            if (native) {
+
+                if (submitInfo_.signalSemaphoreCount >= MAX_SIGNAL_SEMAPHORES) {
+
+                    VK_LOG_ERROR(LC_RENDER, "A submission to the {} timeline signals {} semaphores, at most {} are supported", timeline.name, submitInfo_.signalSemaphoreCount, MAX_SIGNAL_SEMAPHORES - 1);
+
+                    return VK_ERROR_TOO_MANY_OBJECTS;
+
+                }
+
+                VkSemaphore signalSemaphores[MAX_SIGNAL_SEMAPHORES]    = {};
+                uint64_t signalValues[MAX_SIGNAL_SEMAPHORES]           = {};           // Ignored for the binary semaphores
+                std::copy(submitInfo_.pSignalSemaphores, submitInfo_.pSignalSemaphores + submitInfo_.signalSemaphoreCount, signalSemaphores);
+                signalSemaphores[submitInfo_.signalSemaphoreCount]     = timeline.semaphore;
+                signalValues[submitInfo_.signalSemaphoreCount]         = value;
+
+                VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo    = {};
+                timelineSubmitInfo.sType                                = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+                timelineSubmitInfo.pNext                                = submitInfo_.pNext;
+                timelineSubmitInfo.signalSemaphoreValueCount            = submitInfo_.signalSemaphoreCount + 1;
+                timelineSubmitInfo.pSignalSemaphoreValues               = signalValues;
+
+                submitInfo_.pNext                                       = &timelineSubmitInfo;
+                submitInfo_.signalSemaphoreCount                       += 1;
+                submitInfo_.pSignalSemaphores                           = signalSemaphores;
+
+                result = vkQueueSubmit(queue, 1, &submitInfo_, VK_NULL_HANDLE);
+
+            }
+            else {
+
+                VkFence fence = VK_NULL_HANDLE;
+                if (timeline.spare.empty()) {
+
+                    VkFenceCreateInfo fenceCreateInfo           = {};
+                    fenceCreateInfo.sType                       = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+                    result = vkCreateFence(device, &fenceCreateInfo, vk::core::allocator, &fence);
+                    if (result != VK_SUCCESS) return result;
+
+                }
+                else {
+
+                    fence = timeline.spare.back();
+                    timeline.spare.pop_back();
+
+                }
+
+                result = vkQueueSubmit(queue, 1, &submitInfo_, fence);
+                if (result != VK_SUCCESS) {
+
+                    timeline.spare.push_back(fence);
+
+                    return result;
+
+                }
+
+                timeline.inFlight.push_back({ value, fence, 0 });
+                retireSignaled(timeline);           // Keeps the fences in use bounded when nobody waits
+
+            }
+
+            if (result != VK_SUCCESS) return result;
+
+            timeline.submitted  = value;
+            *value_             = value;
+
+            std::scoped_lock< std::mutex > statsLock(statsMutex);
+            timelineStats.submissions++;
+
+            return result;
+
+        }
+
+        VkResult wait(Queue queue_, uint64_t value_, uint64_t timeout_) {
+
+            if (value_ == 0) return VK_SUCCESS;
+
+            QueueTimeline& timeline = timelineOf(queue_);
+
+            std::unique_lock< std::mutex > lock(timeline.mutex);
+            if (value_ <= timeline.completed) return VK_SUCCESS;
+            if (value_ > timeline.submitted) return VK_NOT_READY;      // Would never be signaled
+
+            if (native) {
+
+                lock.unlock();
+
+                VkSemaphoreWaitInfoKHR waitInfo     = {};
+                waitInfo.sType                      = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+                waitInfo.semaphoreCount             = 1;
+                waitInfo.pSemaphores                = &timeline.semaphore;
+                waitInfo.pValues                    = &value_;
+
+                VkResult result = waitSemaphores(device, &waitInfo, timeout_);
+                std::unique_lock< std::mutex > statsLock(statsMutex);
+                timelineStats.waits++;
+                statsLock.unlock();
+                if (result != VK_SUCCESS) return result;
+
+                lock.lock();
+                timeline.completed = std::max(timeline.completed, value_);
+
+                return result;
+
+            }
+
+            retireSignaled(timeline);
+            if (value_ <= timeline.completed) return VK_SUCCESS;
+
+            auto submissionIt = std::find_if(timeline.inFlight.begin(), timeline.inFlight.end(), [value_](const Submission& submission_) {
+
+                return submission_.value >= value_;
+
+            });
+            Submission& submission = *submissionIt;         // Stays in place while it has waiters, pushing to a deque keeps references valid
+            submission.waiters++;
+            VkFence fence = submission.fence;
+            lock.unlock();
+
+            VkResult result = vkWaitForFences(device, 1, &fence, VK_TRUE, timeout_);
+            std::unique_lock< std::mutex > statsLock(statsMutex);
+            timelineStats.waits++;
+            statsLock.unlock();
+
+            lock.lock();
+            submission.waiters--;
+            if (result == VK_SUCCESS) timeline.completed = std::max(timeline.completed, submission.value);
+            retireSignaled(timeline);
+
+            return result;
+
+        }
+
+        void wait(Queue queue_, uint64_t value_) {
+
+            VkResult result = wait(queue_, value_, vk::TIMELINE_WAIT_TIMEOUT);
+            if (result == VK_SUCCESS) return;
+
+            QueueTimeline& timeline = timelineOf(queue_);
+            if (result == VK_NOT_READY) {
+
+                VK_LOG_ERROR(LC_RENDER, "Waiting for value {} of the {} timeline, which was never submitted", value_, timeline.name);
+
+                return;
+
+            }
+
+            if (result == VK_TIMEOUT) {
+
+                std::unique_lock< std::mutex > statsLock(statsMutex);
+                timelineStats.timeouts++;
+                statsLock.unlock();
+
+            }
+
+            while (result == VK_TIMEOUT) {
+
+                VK_LOG_WARNING(LC_RENDER, "Value {} of the {} timeline is taking longer than {} ms, it has reached {}", value_, timeline.name, vk::TIMELINE_WAIT_TIMEOUT / 1000000, completed(queue_));
+                result = wait(queue_, value_, vk::TIMELINE_WAIT_TIMEOUT);
+
+            }
+
+            if (result != VK_SUCCESS) ASSERT(result, "Failed to wait for a timeline value, the device may have been lost", VK_SC_VULKAN_RUNTIME_ERROR);     // Retrying would never succeed
+
+        }
+
+        uint64_t submitted(Queue queue_) {
+
+            QueueTimeline& timeline = timelineOf(queue_);
+            std::scoped_lock< std::mutex > lock(timeline.mutex);
+
+            return timeline.submitted;
+
+        }
+
+        uint64_t completed(Queue queue_) {
+
+            QueueTimeline& timeline = timelineOf(queue_);
+            std::scoped_lock< std::mutex > lock(timeline.mutex);
+
+            if (native) {
+
+                uint64_t value = 0;
+                if (getCounterValue(device, timeline.semaphore, &value) == VK_SUCCESS) {
+
+                    timeline.completed = std::max(timeline.completed, value);
+
+                }
+
+            }
+            else {
+
+                retireSignaled(timeline);
+
+            }
+
+            return timeline.completed;
+
+        }
+
+        void destroy() {
+
+            for (auto& timeline : timelines) {
+
+                std::scoped_lock< std::mutex > lock(timeline.mutex);
+                if (timeline.semaphore != VK_NULL_HANDLE) {
+
+                    vkDestroySemaphore(device, timeline.semaphore, vk::core::allocator);
+                    timeline.semaphore = VK_NULL_HANDLE;
+
+                }
+
+                for (const auto& submission : timeline.inFlight) {
+
+                    vkDestroyFence(device, submission.fence, vk::core::allocator);
+
+                }
+                timeline.inFlight.clear();
+
+                for (auto fence : timeline.spare) {
+
+                    vkDestroyFence(device, fence, vk::core::allocator);
+
+                }
+                timeline.spare.clear();
+
+            }
+
+        }
+
+        TimelineStats stats() {
+
+            std::scoped_lock< std::mutex > lock(statsMutex);
+
+            return timelineStats;
+
+        }
+
+        void logStats() {
+
+            TimelineStats snapshot = stats();
+
+            logger::log(EVENT_LOG, std::string("Queue timelines (") + (snapshot.native ? "timeline semaphores" : "emulated with fences") + "): "
+                + std::to_string(snapshot.submissions) + " submissions, "
+                + std::to_string(snapshot.waits) + " waits, "
+                + std::to_string(snapshot.timeouts) + " waits exceeded the timeout, graphics at "
+                + std::to_string(completed(GRAPHICS_QUEUE)) + ", transfer at "
+                + std::to_string(completed(TRANSFER_QUEUE))
+                );
+
+        }
+
+    }
+
+}
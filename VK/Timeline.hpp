@@ -0,0 +1,111 @@
+/**
+    Prototypes the timeline namespace
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         Timeline.hpp
+    @brief        Prototype of the timeline namespace, a monotonically increasing completion counter per queue
+*/
+#ifndef TIMELINE_HPP
+#define TIMELINE_HPP
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+#include "Queue.cpp"
+#include "VK_STATUS_CODE.hpp"
+#include "TimelineSemaphoreKHR.cpp"
+#include "TimelineStats.cpp"
+
+namespace vk {
+
+    /**
+        Gives the graphics and the transfer queue a timeline each. Every submission signals the next value of its
+        queue's timeline, and the CPU waits for exactly the value it needs instead of for a shared fence or an idle
+        queue. The timelines are VK_KHR_timeline_semaphores where the device supports them and are emulated with a
+        fence per submission otherwise.
+    */
+    namespace timeline {
+
+        /**
+            Creates the timelines, has to be called once the logical device and its queues exist
+
+            @param      device_                 The logical device
+            @param      timelineSemaphores_     Whether VK_KHR_timeline_semaphore is enabled on the logical device
+
+            @return     Returns VK_SC_SUCCESS on success
+        */
+        VK_STATUS_CODE init(VkDevice device_, bool timelineSemaphores_);
+
+        /**
+            Submits work to a queue, signaling the next value of its timeline, the caller has to hold the queue's mutex
+
+            @param      queue_          GRAPHICS_QUEUE or TRANSFER_QUEUE
+            @param      submitInfo_     The submission, its semaphores are kept and the timeline's is appended
+            @param      value_          Is set to the value the submission signals
+
+            @return     Returns the result of vkQueueSubmit
+        */
+        VkResult submit(Queue queue_, VkSubmitInfo submitInfo_, uint64_t* value_);
+
+        /**
+            Waits until a queue's timeline has reached a value
+
+            @param      queue_          GRAPHICS_QUEUE or TRANSFER_QUEUE
+            @param      value_          The value, 0 never has to be waited for
+            @param      timeout_        The timeout in nanoseconds
+
+            @return     Returns VK_SUCCESS once the value is reached, VK_TIMEOUT if the timeout expired first,
+                        VK_NOT_READY if the value was never submitted or the error the wait failed with
+        */
+        VkResult wait(Queue queue_, uint64_t value_, uint64_t timeout_);
+
+        /**
+            Waits until a queue's timeline has reached a value, warning every TIMELINE_WAIT_TIMEOUT it takes longer.
+            Errors other than timeouts, like a lost device, are logged and end the wait.
+
+            @param      queue_          GRAPHICS_QUEUE or TRANSFER_QUEUE
+            @param      value_          The value, 0 never has to be waited for
+        */
+        void wait(Queue queue_, uint64_t value_);
+
+        /**
+            Returns the value of the latest submission to a queue
+
+            @param      queue_          GRAPHICS_QUEUE or TRANSFER_QUEUE
+
+            @return     Returns the value, 0 if nothing has been submitted yet
+        */
+        uint64_t submitted(Queue queue_);
+
+        /**
+            Returns the value a queue's timeline has reached
+
+            @param      queue_          GRAPHICS_QUEUE or TRANSFER_QUEUE
+
+            @return     Returns the value of the latest submission known to have finished
+        */
+        uint64_t completed(Queue queue_);
+
+        /**
+            Destroys the timelines, the device has to be idle
+        */
+        void destroy(void);
+
+        /**
+            Returns the timeline statistics
+
+            @return     Returns a TimelineStats snapshot
+        */
+        TimelineStats stats(void);
+
+        /**
+            Writes the timeline statistics to the event log
+        */
+        void logStats(void);
+
+    }
+
+}
+#endif  // TIMELINE_HPP
@@ -0,0 +1,78 @@
+/**
+    Defines the VK_KHR_timeline_semaphore types
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TimelineSemaphoreKHR.cpp
+    @brief        Definition of the VK_KHR_timeline_semaphore types the bundled Vulkan headers predate
+*/
+#ifndef TIMELINE_SEMAPHORE_KHR_CPP
+#define TIMELINE_SEMAPHORE_KHR_CPP
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+#ifndef VK_KHR_timeline_semaphore                   // Added in header version 124, newer headers bring their own
+#define VK_KHR_timeline_semaphore 1
+#define VK_KHR_TIMELINE_SEMAPHORE_SPEC_VERSION      2
+#define VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME    "VK_KHR_timeline_semaphore"
+
+const VkStructureType VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR    = static_cast< VkStructureType >(1000207000);
+const VkStructureType VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR                    = static_cast< VkStructureType >(1000207002);
+const VkStructureType VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR                = static_cast< VkStructureType >(1000207003);
+const VkStructureType VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR                           = static_cast< VkStructureType >(1000207004);
+
+typedef enum VkSemaphoreTypeKHR {
+
+    VK_SEMAPHORE_TYPE_BINARY_KHR        = 0,
+    VK_SEMAPHORE_TYPE_TIMELINE_KHR      = 1,
+    VK_SEMAPHORE_TYPE_MAX_ENUM_KHR      = 0x7FFFFFFF
+
+} VkSemaphoreTypeKHR;
+
+typedef VkFlags VkSemaphoreWaitFlagsKHR;
+
+typedef struct VkPhysicalDeviceTimelineSemaphoreFeaturesKHR {
+
+    VkStructureType                     sType;
+    void*                               pNext;
+    VkBool32                            timelineSemaphore;
+
+} VkPhysicalDeviceTimelineSemaphoreFeaturesKHR;
+
+typedef struct VkSemaphoreTypeCreateInfoKHR {
+
+    VkStructureType                     sType;
+    const void*                         pNext;
+    VkSemaphoreTypeKHR                  semaphoreType;
+    uint64_t                            initialValue;
+
+} VkSemaphoreTypeCreateInfoKHR;
+
+typedef struct VkTimelineSemaphoreSubmitInfoKHR {
+
+    VkStructureType                     sType;
+    const void*                         pNext;
+    uint32_t                            waitSemaphoreValueCount;
+    const uint64_t*                     pWaitSemaphoreValues;
+    uint32_t                            signalSemaphoreValueCount;
+    const uint64_t*                     pSignalSemaphoreValues;
+
+} VkTimelineSemaphoreSubmitInfoKHR;
+
+typedef struct VkSemaphoreWaitInfoKHR {
+
+    VkStructureType                     sType;
+    const void*                         pNext;
+    VkSemaphoreWaitFlagsKHR             flags;
+    uint32_t                            semaphoreCount;
+    const VkSemaphore*                  pSemaphores;
+    const uint64_t*                     pValues;
+
+} VkSemaphoreWaitInfoKHR;
+
+typedef VkResult (VKAPI_PTR *PFN_vkGetSemaphoreCounterValueKHR)(VkDevice device, VkSemaphore semaphore, uint64_t* pValue);
+typedef VkResult (VKAPI_PTR *PFN_vkWaitSemaphoresKHR)(VkDevice device, const VkSemaphoreWaitInfoKHR* pWaitInfo, uint64_t timeout);
+#endif
+#endif  // TIMELINE_SEMAPHORE_KHR_CPP
@@ -0,0 +1,25 @@
+/**
+    Defines the TimelineStats struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         TimelineStats.cpp
+    @brief        Definition of the TimelineStats struct
+*/
+#ifndef TIMELINE_STATS_CPP
+#define TIMELINE_STATS_CPP
+#include <cstdint>
+
+/**
+    Holds the statistics of the queue timelines
+*/
+struct TimelineStats {
+
+    bool                native;             // Whether VK_KHR_timeline_semaphore backs the timelines
+    uint64_t            submissions;        // Submissions that signaled a timeline value
+    uint64_t            waits;              // CPU waits for a value that had not been reached yet
+    uint64_t            timeouts;           // Waits that exceeded TIMELINE_WAIT_TIMEOUT at least once
+
+};
+#endif  // TIMELINE_STATS_CPP
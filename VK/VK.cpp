@@ -8,7 +8,13 @@
     @brief        Prototype of the vk namespace
 */
 #include "VK.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
 #include "ASSERT.cpp"
+#include "FileIO.hpp"
 
 
 namespace vk {
@@ -25,22 +31,37 @@ namespace vk {
     const double                        SPEED                       = 2.0;
     const double                        SENS                        = 0.1;
     const double                        FOV                         = 45.0;
-
-    VkCommandPool                       graphicsCommandPool         = VK_NULL_HANDLE;
+    const float                         WORLD_CELL_SIZE             = 64.0f;
+    const float                         WORLD_LOAD_RADIUS           = 128.0f;
+    const float                         WORLD_UNLOAD_RADIUS         = 192.0f;
+    const VkDeviceSize                  WORLD_MEMORY_BUDGET         = 512ull << 20;
+    const size_t                        IO_PREFETCH_BUDGET          = 256ull << 20;
+    const char*                         ASSET_PACKAGE               = "res.vkpak";
+    const char*                         METRICS_SOCKET              = "logs/metrics.sock";
+    const double                        MEMORY_BUDGET_FRACTION      = 0.8;
+    const double                        RESIDENCY_HIGH_WATERMARK    = 0.9;
+    const double                        RESIDENCY_LOW_WATERMARK     = 0.7;
+    const uint32_t                      RESIDENCY_MIN_EDGE          = 64;
+    const uint32_t                      TEXTURE_STREAMING_TAIL_EDGE = 64;
+    const uint32_t                      TEXTURE_STREAMING_UPLOADS   = 4;
+    const size_t                        FRAME_ARENA_SIZE            = 64ull << 10;
+    const uint32_t                      FRAME_DESCRIPTOR_SETS       = 256;
+    const uint64_t                      TIMELINE_WAIT_TIMEOUT       = 1000000000ull;
+
+    VkCommandPool                       graphicsCommandPool         = VK_NULL_HANDLE;      // Only the render loop records into it
     VkQueue                             graphicsQueue               = VK_NULL_HANDLE;
-    VkFence                             graphicsFence;
-    std::mutex                          graphicsMutex;
+    Mutex                               graphicsMutex("graphics_queue");
     VkQueue                             transferQueue               = VK_NULL_HANDLE;
-    VkCommandPool                       transferCommandPool         = VK_NULL_HANDLE;
-    VkFence                             transferFence;
-    std::mutex                          transferMutex;
-    std::mutex                          commandBufferMutex;
+    Mutex                               transferMutex("transfer_queue");
 
-    std::mutex                          loadingMutex;
+    Mutex                               loadingMutex("loading");
+
+    Mutex                                                                       imageMemoryMutex("image_memory");
+    std::unordered_map< VkImage, std::pair< MEMORY_CATEGORY, uint32_t > >      imageMemory;        // Category and memory type of every image createImage() allocated for
 
     VK_STATUS_CODE init() {
 
-        std::scoped_lock< std::mutex > lock(loadingMutex);
+        std::scoped_lock< Mutex > lock(loadingMutex);
         vk::core::preInit();
         vk::core::init();
 
@@ -140,28 +161,24 @@ namespace vk {
 
     const std::vector< char > loadFile(const std::string& filePath_) {
 
-        logger::log(EVENT_LOG, "Loading file at '" + filePath_ + "'");
+        VK_LOG_DEBUG(LC_IO, "Loading file at '{}'", filePath_);
 
-        std::ifstream file(filePath_, std::ios::ate | std::ios::binary);        // Start reading at end of file --> determine the buffer size needed
+        std::shared_ptr< FileData > file = io::read(filePath_);
 
-        if (!file.is_open()) {
+        if (!file) {
 
             logger::log(ERROR_LOG, "Failed to load file at '" + filePath_ + "'");
 
         }
 
-        size_t bufferSize = (size_t)file.tellg();        // Find read position and thus necessary buffer size
-        std::vector< char > buffer(bufferSize);
-
-        file.seekg(0);        // Translate back to the beginning of the file
-        file.read(buffer.data(), bufferSize);
-        file.close();
+        const char* data = reinterpret_cast< const char* >(file->data());
+        std::vector< char > buffer(data, data + file->size());
 
         return buffer;
 
     }
 
-    void copyBuffer(VkBuffer srcBuf_, VkBuffer dstBuf_, VkDeviceSize size_) {
+    void copyBuffer(VkBuffer srcBuf_, VkBuffer dstBuf_, VkDeviceSize size_, VkBufferUsageFlags dstUsage_) {
 
         VkCommandBuffer commandBuffer = startCommandBuffer(TRANSFER_QUEUE);
 
@@ -170,9 +187,8 @@ namespace vk {
         copy.dstOffset          = 0;
         copy.size               = size_;
         
-        std::unique_lock< std::mutex > lock(transferMutex);
         vkCmdCopyBuffer(commandBuffer, srcBuf_, dstBuf_, 1, &copy);
-        lock.unlock();
+        vk::ownership::releaseBuffer(commandBuffer, dstBuf_, dstUsage_);
 
         endCommandBuffer(commandBuffer, TRANSFER_QUEUE);
 
@@ -180,109 +196,35 @@ namespace vk {
 
     VkCommandBuffer startCommandBuffer(Queue queue_) {
 
-        std::scoped_lock< std::mutex > commandLock(commandBufferMutex);
-
-        VkCommandPool   commandPool     = VK_NULL_HANDLE;
-        std::mutex*     mutex           = nullptr;
-
-        if (queue_ == TRANSFER_QUEUE) {
-
-            std::scoped_lock< std::mutex > lock(transferMutex);
-            commandPool = transferCommandPool;
-            mutex       = &transferMutex;
-        
-        }
-        else if (queue_ == GRAPHICS_QUEUE) {
-
-            std::scoped_lock< std::mutex > lock(graphicsMutex);
-            commandPool = graphicsCommandPool;
-            mutex       = &graphicsMutex;
-
-        }
-        else {
+        if (queue_ != TRANSFER_QUEUE && queue_ != GRAPHICS_QUEUE) {
         
             logger::log(ERROR_LOG, "Command buffer was allocated from unsupported command pool");
+
+            return VK_NULL_HANDLE;
         
         }
 
-        std::scoped_lock< std::mutex > lock(*mutex);
-        VkCommandBufferAllocateInfo allocInfo   = {};
-        allocInfo.sType                         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level                         = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool                   = commandPool;
-        allocInfo.commandBufferCount            = 1;
-
-        VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(vk::core::logicalDevice, &allocInfo, &commandBuffer);
-
-        VkCommandBufferBeginInfo beginInfo      = {};
-        beginInfo.sType                         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags                         = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
-
-        return commandBuffer;
+        return vk::commands::acquire(queue_);          // From the calling thread's own pool, without locking
 
     }
 
     void endCommandBuffer(VkCommandBuffer commandBuffer_, Queue queue_) {
 
-        std::scoped_lock< std::mutex > commandLock(commandBufferMutex);
-
-        waitForQueue(queue_);
-
-        VkQueue         queue       = VK_NULL_HANDLE;
-        VkFence         fence       = VK_NULL_HANDLE;
-        VkCommandPool   commandPool = VK_NULL_HANDLE;
-        std::mutex*     mutex       = nullptr;
-
-        if (queue_ == TRANSFER_QUEUE) {
-        
-            std::scoped_lock< std::mutex > lock(transferMutex);
-            queue           = transferQueue;
-            fence           = transferFence;
-            mutex           = &transferMutex;
-            commandPool     = transferCommandPool;
-        
-        }
-        else if (queue_ == GRAPHICS_QUEUE) {
-
-            std::scoped_lock< std::mutex > lock(graphicsMutex);
-            queue           = graphicsQueue;
-            fence           = graphicsFence;
-            mutex           = &graphicsMutex;
-            commandPool     = graphicsCommandPool;
-        
-        } 
-        else {
+        if (queue_ != TRANSFER_QUEUE && queue_ != GRAPHICS_QUEUE) {
         
             logger::log(ERROR_LOG, "Command buffer was submitted to an unsupported queue");
 
+            return;
+
         }
 
-        std::unique_lock< std::mutex > lock(*mutex);
         vkEndCommandBuffer(commandBuffer_);
 
-        VkSubmitInfo submitInfo         = {};
-        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount   = 1;
-        submitInfo.pCommandBuffers      = &commandBuffer_;
-
-        vkQueueSubmit(
-            queue,
-            1,
-            &submitInfo,
-            fence
-            );
-
-        vkQueueWaitIdle(queue);
-
-        vkFreeCommandBuffers(
-            vk::core::logicalDevice,
-            commandPool,
-            1,
-            &commandBuffer_
-            );
+        uint64_t value = 0;
+        vk::commands::submit(commandBuffer_, queue_, &value);
+        vk::timeline::wait(queue_, value);         // Only for this submission, frames and other uploads in flight keep running
+        vk::commands::release(commandBuffer_, queue_);
+        if (queue_ == TRANSFER_QUEUE) vk::ownership::publish();        // Its releases have executed, the next frame may acquire them
 
     }
 
@@ -291,7 +233,8 @@ namespace vk {
         VkFormat        format_,
         VkImageLayout   oldLayout_,
         VkImageLayout   newLayout_,
-        uint32_t        mipLevels_
+        uint32_t        mipLevels_,
+        uint32_t        baseMipLevel_
         ) {
 
         VkCommandBuffer commandBuffer               = startCommandBuffer(GRAPHICS_QUEUE);
@@ -321,8 +264,8 @@ namespace vk {
 
         }
 
-        barrier.subresourceRange.baseMipLevel       = 0;
-        barrier.subresourceRange.levelCount         = mipLevels_;
+        barrier.subresourceRange.baseMipLevel       = baseMipLevel_;
+        barrier.subresourceRange.levelCount         = mipLevels_ - baseMipLevel_;
         barrier.subresourceRange.baseArrayLayer     = 0;
         barrier.subresourceRange.layerCount         = 1;
 
@@ -371,7 +314,6 @@ namespace vk {
 
         }
 
-        std::unique_lock< std::mutex > lock(graphicsMutex);
         vkCmdPipelineBarrier(
             commandBuffer,
             sourceStage,
@@ -384,7 +326,6 @@ namespace vk {
             1,
             &barrier
             );
-        lock.unlock();
 
         endCommandBuffer(
             commandBuffer, 
@@ -400,8 +341,6 @@ namespace vk {
         uint32_t        height_
         ) {
 
-        VkCommandBuffer commandBuffer               = startCommandBuffer(TRANSFER_QUEUE);
-
         VkBufferImageCopy copyRegion                = {};
         copyRegion.bufferOffset                     = 0;
         copyRegion.bufferRowLength                  = 0;
@@ -415,16 +354,55 @@ namespace vk {
         copyRegion.imageOffset                      = { 0, 0, 0 };
         copyRegion.imageExtent                      = { width_, height_, 1 };
 
-        std::unique_lock< std::mutex > lock(transferMutex);
+        copyBufferToImage(buffer_, image_, { copyRegion });
+
+    }
+
+    void copyBufferToImage(
+        VkBuffer                                    buffer_,
+        VkImage                                     image_,
+        const std::vector< VkBufferImageCopy >&     regions_,
+        VkImageLayout                               oldLayout_
+        ) {
+
+        VkCommandBuffer commandBuffer               = startCommandBuffer(TRANSFER_QUEUE);
+
+        if (oldLayout_ == VK_IMAGE_LAYOUT_UNDEFINED) {
+
+            VkImageMemoryBarrier barrier            = {};
+            barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask                   = 0;
+            barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;     // The first queue to use an exclusive image owns it
+            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image                           = image_;
+            barrier.subresourceRange                = { VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, 1 };
+
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        }
+
         vkCmdCopyBufferToImage(
             commandBuffer,
             buffer_,
             image_,
             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            1,
-            &copyRegion
+            static_cast< uint32_t >(regions_.size()),
+            regions_.data()
             );
-        lock.unlock();
+
+        uint32_t firstLevel = regions_.front().imageSubresource.mipLevel;
+        uint32_t lastLevel  = firstLevel;
+        for (const auto& region : regions_) {
+
+            firstLevel  = std::min(firstLevel, region.imageSubresource.mipLevel);
+            lastLevel   = std::max(lastLevel, region.imageSubresource.mipLevel);
+
+        }
+
+        vk::ownership::releaseImage(commandBuffer, image_, { VK_IMAGE_ASPECT_COLOR_BIT, firstLevel, lastLevel - firstLevel + 1, 0, 1 });
 
         endCommandBuffer(commandBuffer, TRANSFER_QUEUE);
 
@@ -434,10 +412,12 @@ namespace vk {
         VkImage                 image_, 
         VkFormat                format_, 
         VkImageAspectFlags      aspectFlags_,
-        uint32_t                mipLevels_
+        uint32_t                mipLevels_,
+        VkComponentMapping      components_,
+        uint32_t                baseMipLevel_
         ) {
 
-        logger::log(EVENT_LOG, "Creating image view...");
+        VK_LOG_DEBUG(LC_RENDER, "Creating image view...");
 
         VkImageViewCreateInfo imageViewCreateInfo               = {};
         imageViewCreateInfo.sType                               = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -445,14 +425,11 @@ namespace vk {
         imageViewCreateInfo.viewType                            = VK_IMAGE_VIEW_TYPE_2D;
         imageViewCreateInfo.format                              = format_;
         imageViewCreateInfo.subresourceRange.aspectMask         = aspectFlags_;
-        imageViewCreateInfo.subresourceRange.baseMipLevel       = 0;
-        imageViewCreateInfo.subresourceRange.levelCount         = mipLevels_;
+        imageViewCreateInfo.subresourceRange.baseMipLevel       = baseMipLevel_;
+        imageViewCreateInfo.subresourceRange.levelCount         = mipLevels_ - baseMipLevel_;
         imageViewCreateInfo.subresourceRange.baseArrayLayer     = 0;
         imageViewCreateInfo.subresourceRange.layerCount         = 1;
-        imageViewCreateInfo.components.r                        = VK_COMPONENT_SWIZZLE_IDENTITY;
-        imageViewCreateInfo.components.g                        = VK_COMPONENT_SWIZZLE_IDENTITY;
-        imageViewCreateInfo.components.b                        = VK_COMPONENT_SWIZZLE_IDENTITY;
-        imageViewCreateInfo.components.a                        = VK_COMPONENT_SWIZZLE_IDENTITY;
+        imageViewCreateInfo.components                          = components_;
 
         VkImageView imgView;
         VkResult result = vkCreateImageView(
@@ -462,8 +439,9 @@ namespace vk {
             &imgView
             );
         ASSERT(result, "Failed to create image view", VK_SC_IMAGE_VIEW_CREATION_ERROR);
+        vk::counters::add(FC_OBJECTS_CREATED);
 
-        logger::log(EVENT_LOG, "Successfully created image view");
+        VK_LOG_DEBUG(LC_RENDER, "Successfully created image view");
 
         return imgView;
 
@@ -511,7 +489,6 @@ namespace vk {
             barrier.srcAccessMask                       = VK_ACCESS_TRANSFER_WRITE_BIT;
             barrier.dstAccessMask                       = VK_ACCESS_TRANSFER_READ_BIT;
 
-            std::unique_lock< std::mutex > graphicsLock(graphicsMutex);
             vkCmdPipelineBarrier(
                 commandBuffer,
                 VK_PIPELINE_STAGE_TRANSFER_BIT,
@@ -524,7 +501,6 @@ namespace vk {
                 1,
                 &barrier
                 );
-            graphicsLock.unlock();
 
             VkImageBlit blit                            = {};
             blit.srcOffsets[0]                          = { 0, 0, 0 };
@@ -540,7 +516,6 @@ namespace vk {
             blit.dstSubresource.baseArrayLayer          = 0;
             blit.dstSubresource.layerCount              = 1;
 
-            graphicsLock.lock();
             vkCmdBlitImage(
                 commandBuffer,
                 image_,
@@ -551,14 +526,12 @@ namespace vk {
                 &blit,
                 VK_FILTER_LINEAR
                 );
-            graphicsLock.unlock();
 
             barrier.oldLayout                           = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
             barrier.newLayout                           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             barrier.srcAccessMask                       = VK_ACCESS_TRANSFER_READ_BIT;
             barrier.dstAccessMask                       = VK_ACCESS_SHADER_READ_BIT;
 
-            graphicsLock.lock();
             vkCmdPipelineBarrier(
                 commandBuffer,
                 VK_PIPELINE_STAGE_TRANSFER_BIT,
@@ -571,7 +544,6 @@ namespace vk {
                 1, 
                 &barrier
                 );
-            graphicsLock.unlock();
 
             if (mipWidth > 1) mipWidth /= 2;
             if (mipHeight > 1) mipHeight /= 2;
@@ -584,7 +556,6 @@ namespace vk {
         barrier.srcAccessMask                       = VK_ACCESS_TRANSFER_WRITE_BIT;
         barrier.dstAccessMask                       = VK_ACCESS_SHADER_READ_BIT;
 
-        std::unique_lock< std::mutex > graphicsLock(graphicsMutex);
         vkCmdPipelineBarrier(
             commandBuffer,
             VK_PIPELINE_STAGE_TRANSFER_BIT, 
@@ -597,7 +568,6 @@ namespace vk {
             1, 
             &barrier
             );
-        graphicsLock.unlock();
 
         endCommandBuffer(commandBuffer, GRAPHICS_QUEUE);
 
@@ -705,6 +675,16 @@ namespace vk {
             );
         ASSERT(result, "Failed to allocate image memory", VK_SC_IMAGE_MEMORY_ALLOCATION_ERROR);
 
+        MEMORY_CATEGORY category = vk::memory::imageCategory(usage_);
+        vk::memory::track(category, memoryAllocInfo.memoryTypeIndex, static_cast< int64_t >(memReqs.size));
+        {
+
+            std::scoped_lock< Mutex > lock(imageMemoryMutex);
+            imageMemory[img_] = { category, memoryAllocInfo.memoryTypeIndex };
+
+        }
+        vk::counters::add(FC_OBJECTS_CREATED, 2);       // The image and its memory
+
         vkBindImageMemory(
             vk::core::logicalDevice,
             img_,
@@ -717,65 +697,74 @@ namespace vk {
     }
 
 
+    void untrackImage(VkImage img_) {
+
+        if (img_ == VK_NULL_HANDLE) return;
+
+        std::unique_lock< Mutex > lock(imageMemoryMutex);
+        auto it = imageMemory.find(img_);
+        if (it == imageMemory.end()) return;
+
+        std::pair< MEMORY_CATEGORY, uint32_t > allocation = it->second;
+        imageMemory.erase(it);
+        lock.unlock();
+
+        VkMemoryRequirements memReqs;
+        vkGetImageMemoryRequirements(vk::core::logicalDevice, img_, &memReqs);
+        vk::memory::track(allocation.first, allocation.second, -static_cast< int64_t >(memReqs.size));
+        vk::counters::add(FC_OBJECTS_DESTROYED, 2);
+
+    }
+
     bool hasStencilBufferComponent(VkFormat format_) {
 
         return format_ == VK_FORMAT_D32_SFLOAT_S8_UINT || format_ == VK_FORMAT_D24_UNORM_S8_UINT;
 
     }
 
-    VK_STATUS_CODE push(const char* path_, glm::mat4 (*modelMatrixFunc_)()) {
+    ModelHandle push(const char* path_, glm::mat4 (*modelMatrixFunc_)()) {
 
-        vk::core::push(path_, modelMatrixFunc_);
         logger::log(EVENT_LOG, "Pushing model at path " + std::string(path_) + " to loading queue");
 
-        return vk::errorCodeBuffer;
+        return vk::core::push(path_, modelMatrixFunc_);
 
     }
 
-    VK_STATUS_CODE push(ModelInfo info_) {
+    ModelHandle push(ModelInfo info_, float bias_) {
 
-        vk::core::push(info_);
         logger::log(EVENT_LOG, "Pushing model at path " + std::string(info_.path) + " to loading queue");
 
-        return vk::errorCodeBuffer;
+        return vk::core::push(info_, bias_);
 
     }
 
-    void waitForQueue(Queue queue_) {
+    VK_STATUS_CODE stream(const char* manifest_) {
 
-        VkFence         fence       = VK_NULL_HANDLE;
-        std::mutex*     mutex       = nullptr;
+        logger::log(EVENT_LOG, "Streaming scene manifest " + std::string(manifest_));
 
-        if (queue_ == TRANSFER_QUEUE) {
+        return vk::core::stream(manifest_);
 
-            std::scoped_lock< std::mutex > lock(transferMutex);
-            fence = transferFence;
-            mutex = &transferMutex;
-        
-        }
-        else if (queue_ == GRAPHICS_QUEUE) {
+    }
 
-            std::scoped_lock< std::mutex > lock(graphicsMutex);
-            fence = graphicsFence;
-            mutex = &graphicsMutex;
-        
-        }
-        else {
+    void waitForQueue(Queue queue_) {
+
+        if (queue_ != TRANSFER_QUEUE && queue_ != GRAPHICS_QUEUE) {
         
             logger::log(ERROR_LOG, "Waiting for unsupported queue");
+
+            return;
         
         }
 
-        std::scoped_lock< std::mutex > lock(*mutex);
-        vkWaitForFences(
-            vk::core::logicalDevice,
-            1,
-            &fence,
-            VK_TRUE,
-            std::numeric_limits< uint64_t >::max()
-            );
-        vkResetFences(vk::core::logicalDevice, 1, &fence);
+        vk::timeline::wait(queue_, vk::timeline::submitted(queue_));
     
     }
 
+    void waitForDeviceIdle() {
+
+        std::scoped_lock< Mutex, Mutex > lock(graphicsMutex, transferMutex);
+        vkDeviceWaitIdle(vk::core::logicalDevice);
+
+    }
+
 }
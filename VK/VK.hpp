@@ -16,6 +16,7 @@
 #include <iostream>
 
 #include "Core.hpp"
+#include "Mutex.hpp"
 #include "VK_STATUS_CODE.hpp"
 
 
@@ -31,7 +32,6 @@ namespace vk {
     extern const char*                          TITLE;
     extern const unsigned int                   MAX_IN_FLIGHT_FRAMES;
     extern VkQueue                              transferQueue;
-    extern VkCommandPool                        transferCommandPool;
 
     // Starting/Default camera state values
     extern const double                         YAW;
@@ -41,17 +41,43 @@ namespace vk {
     extern const double                         SENS;
     extern const double                         FOV;
 
+    // World streaming defaults
+    extern const float                          WORLD_CELL_SIZE;
+    extern const float                          WORLD_LOAD_RADIUS;
+    extern const float                          WORLD_UNLOAD_RADIUS;
+    extern const VkDeviceSize                   WORLD_MEMORY_BUDGET;
+
+    // Asset I/O defaults
+    extern const size_t                         IO_PREFETCH_BUDGET;
+    extern const char*                          ASSET_PACKAGE;
+
+    // Metrics defaults
+    extern const char*                          METRICS_SOCKET;
+
+    // Memory budget defaults
+    extern const double                         MEMORY_BUDGET_FRACTION;
+    extern const double                         RESIDENCY_HIGH_WATERMARK;
+    extern const double                         RESIDENCY_LOW_WATERMARK;
+    extern const uint32_t                       RESIDENCY_MIN_EDGE;
+
+    // Texture streaming defaults
+    extern const uint32_t                       TEXTURE_STREAMING_TAIL_EDGE;
+    extern const uint32_t                       TEXTURE_STREAMING_UPLOADS;
+
+    // Frame arena defaults
+    extern const size_t                         FRAME_ARENA_SIZE;
+    extern const uint32_t                       FRAME_DESCRIPTOR_SETS;
+
+    // Synchronization defaults
+    extern const uint64_t                       TIMELINE_WAIT_TIMEOUT;
+
     extern VkCommandPool                        graphicsCommandPool;
     extern VkQueue                              graphicsQueue;
-    extern VkFence                              graphicsFence;
-    extern std::mutex                           graphicsMutex;
+    extern Mutex                                graphicsMutex;
     extern VkQueue                              transferQueue;
-    extern VkCommandPool                        transferCommandPool;
-    extern VkFence                              transferFence;
-    extern std::mutex                           transferMutex;
-    extern std::mutex                           commandBufferMutex;
+    extern Mutex                                transferMutex;
 
-    extern std::mutex                           loadingMutex;
+    extern Mutex                                loadingMutex;
 
     /**
         Initializes the VKEngine object
@@ -130,16 +156,18 @@ namespace vk {
     const std::vector< char > loadFile(const std::string& filePath_);
 
     /**
-        Copies one buffer into the memory of another
+        Copies one buffer into the memory of another on the transfer queue and releases the destination to the graphics
+        queue
 
         @param      srcBuf_     The source buffer
         @param      dstBuf_     The destination buffer
         @param      size_       The buffer size in bytes
+        @param      dstUsage_   The usage flags of the destination buffer, selects how the graphics queue acquires it
     */
-    void copyBuffer(VkBuffer srcBuf_, VkBuffer dstBuf_, VkDeviceSize size_);
+    void copyBuffer(VkBuffer srcBuf_, VkBuffer dstBuf_, VkDeviceSize size_, VkBufferUsageFlags dstUsage_);
 
     /**
-        Starts a command buffer
+        Starts a command buffer from the calling thread's command pool
 
         @param      queue_          The queue to submit the command buffer on
 
@@ -148,7 +176,7 @@ namespace vk {
     VkCommandBuffer startCommandBuffer(Queue queue_);
 
     /**
-        Ends a command buffer
+        Ends a command buffer, submits it and waits for it to finish, has to be called by the thread that started it
 
         @param      commandBuffer_      The command buffer to end
         @param      queue_              The queue to submit the command buffer on
@@ -163,17 +191,20 @@ namespace vk {
         @param      oldLayout_      The old layout
         @param      newLayout_      The new layout
         @param      mipLevels       The amount of mip levels
+        @param      baseMipLevel_   The first mip level to transition, levels [baseMipLevel_, mipLevels_) are transitioned
     */
     void imageLayoutTransition(
         VkImage         image_,
         VkFormat        format_,
         VkImageLayout   oldLayout_,
         VkImageLayout   newLayout_,
-        uint32_t        mipLevels_
+        uint32_t        mipLevels_,
+        uint32_t        baseMipLevel_   = 0
         );
 
     /**
-        Copies a specific buffer area to an image
+        Copies a specific buffer area to the first level of an image in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL on the
+        transfer queue and releases the level to the graphics queue
 
         @param      buffer_     The buffer to read from
         @param      image_      The image to write to
@@ -187,6 +218,22 @@ namespace vk {
         uint32_t        height_
         );
 
+    /**
+        Copies several buffer regions to an image with a single transfer queue submission, the copied levels are
+        released to the graphics queue in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL and acquired by the next frame
+
+        @param      buffer_     The buffer to read from
+        @param      image_      The image to write to
+        @param      regions_    The regions to copy, usually one per mip level
+        @param      oldLayout_  VK_IMAGE_LAYOUT_UNDEFINED moves every level of a new image to the transfer layout first
+    */
+    void copyBufferToImage(
+        VkBuffer                                    buffer_,
+        VkImage                                     image_,
+        const std::vector< VkBufferImageCopy >&     regions_,
+        VkImageLayout                               oldLayout_  = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+        );
+
     /**
         Creates a VkImageView handle
 
@@ -194,6 +241,8 @@ namespace vk {
         @param      format_             The image format
         @param      aspectFlags_        The aspect mask to specify in the image view creation process
         @param      mipLevels_          The amount of mip levels
+        @param      components_         The component swizzle, defaults to identity
+        @param      baseMipLevel_       The first mip level the view shows, levels [baseMipLevel_, mipLevels_) are visible
 
         @return     Returns a valid VkImageView handle
     */
@@ -201,7 +250,9 @@ namespace vk {
         VkImage                 image_,
         VkFormat                format_,
         VkImageAspectFlags      aspectFlags_,
-        uint32_t                mipLevels_
+        uint32_t                mipLevels_,
+        VkComponentMapping      components_     = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY },
+        uint32_t                baseMipLevel_   = 0
         );
 
     /**
@@ -273,6 +324,13 @@ namespace vk {
         uint32_t        mipLevels_
         );
 
+    /**
+        Removes an image's memory from the device memory accounting, has to be called before the image is destroyed
+
+        @param      img_            The image, may be VK_NULL_HANDLE
+    */
+    void untrackImage(VkImage img_);
+
     /**
         Checks whether a VkFormat has a stencil component
 
@@ -288,25 +346,40 @@ namespace vk {
         @param      path_                   The path to the model
         @param      modelMatrixFunc_        The function pointer to calculate the models model matrix
 
-        @return     Returns VK_SC_SUCCESS on success
+        @return     Returns a handle to poll, wait on or cancel the load, models nearest to the camera load first
     */
-    VK_STATUS_CODE push(const char* path_, glm::mat4 (*modelMatrixFunc_)());
+    ModelHandle push(const char* path_, glm::mat4 (*modelMatrixFunc_)());
 
     /**
         Adds a model to the model loading queue
 
-        @param      path_       The path to the model
+        @param      info_       A model info struct
+        @param      bias_       Subtracted from the distance to the camera, larger values load earlier
+
+        @return     Returns a handle to poll, wait on or cancel the load
+    */
+    ModelHandle push(ModelInfo info_, float bias_ = 0.0f);
+
+    /**
+        Streams the models of a scene manifest in and out around the camera
+
+        @param      manifest_       The path to the scene manifest
 
         @return     Returns VK_SC_SUCCESS on success
     */
-    VK_STATUS_CODE push(ModelInfo info_);
+    VK_STATUS_CODE stream(const char* manifest_);
 
     /**
-        Waits on a queue to signal their fence
+        Waits for everything submitted to a queue so far to finish
 
         @param      queue_      The queue to wait on
     */
     void waitForQueue(Queue queue_);
 
+    /**
+        Waits for the logical device to become idle while holding every queue's mutex, as vkDeviceWaitIdle requires
+    */
+    void waitForDeviceIdle(void);
+
 }
 #endif  // VK_HPP
@@ -16,6 +16,7 @@
 */
 typedef enum VK_STATUS_CODE {
 
+    VK_SC_TEXTURE_CACHE_ERROR                               = -54,
     VK_SC_RESOURCE_LOADING_ERROR                            = -53,
     VK_SC_MODEL_LOADING_ERROR_ASSIMP                        = -52,
     VK_SC_MSAA_BUFFER_CREATION_ERROR                        = -51,
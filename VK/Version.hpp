@@ -39,10 +39,33 @@
 
 //#define VK_VERTEX_DEDUPLICATION       // Toggle Vertex Deduplication, may be buggy
 
+#define VK_TEXTURE_CACHE                        // Keep decoded, mipmapped textures in cache/textures so warm loads skip decoding
+//#define VK_TEXTURE_COMPRESSION_BC1_BC3        // Block-compress textures to BC1 (opaque) or BC3 (with alpha)
+//#define VK_TEXTURE_COMPRESSION_BC7            // Block-compress textures to BC7, slower to encode but higher quality
+
+#define VK_HOT_RELOAD                           // Watch res/ and shaders/ and swap in changed textures, models and shaders while running
+#define VK_TEXTURE_STREAMING                    // Load textures with only their small mip levels resident and stream the larger ones in while they are drawn
+//#define VK_MIPMAP_FILTER_KAISER              // Downsample mipmaps with a Kaiser-windowed sinc instead of a box filter, sharper but slower
+
+#define VK_LOG_LEVEL 1                          // Structured log messages below this level are compiled out: 0 trace, 1 debug, 2 info, 3 warning, 4 error
+#define VK_METRICS                              // Serve counters, gauges and histograms on logs/metrics.sock, read them with VKMetrics
+//#define VK_LOG_BINARY                         // Write structured log messages to logs/event.bin as format ids and raw arguments, decode with VKLogDecode
+//#define VK_PIPELINE_STATISTICS                // Count vertex and fragment shader invocations per frame with pipeline statistics queries
+//#define VK_HOST_ALLOCATOR                     // Route the driver's host allocations through tracking VkAllocationCallbacks, see memory_host_* metrics
+//#define VK_HOST_ALLOCATOR_ARENA               // With VK_HOST_ALLOCATOR, serve small command scope allocations from a per-thread arena
+#define VK_HEAP_TRACKING                        // Count the main thread's heap allocations per frame, see render_heap_allocations_total
+//#define VK_LOCK_PROFILING                     // Record acquisitions, wait and hold times of the engine's locks, see sync_lock_* metrics
+
 // Default values
 
 #ifdef VK_NO_LOG
     #define VK_RELEASE
+    #undef VK_LOG_LEVEL
+    #define VK_LOG_LEVEL 5
+#endif
+
+#ifndef VK_LOG_LEVEL
+    #define VK_LOG_LEVEL 2
 #endif
 
 #if !defined VK_DEVELOPMENT && !defined VK_RELEASE && !defined VK_RELEASE_CONSOLE
@@ -57,6 +80,10 @@
     #define VK_RELEASE
 #endif
 
+#if defined VK_TEXTURE_COMPRESSION_BC7 && defined VK_TEXTURE_COMPRESSION_BC1_BC3
+    #undef VK_TEXTURE_COMPRESSION_BC1_BC3
+#endif
+
 #if !defined VK_DEVELOPMENT && !defined VK_RELEASE_CONSOLE && defined VK_RELEASE && (defined WIN_64 || defined WIN_32)
     #pragma comment(linker, "/SUBSYSTEM:windows /ENTRY:mainCRTStartup")
 #endif
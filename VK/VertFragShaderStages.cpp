@@ -52,7 +52,7 @@ VK_STATUS_CODE VertFragShaderStages::destroyModules() {
 
 VkShaderModule VertFragShaderStages::createShaderModuleFromBinary(const std::vector< char >* code_) {
 
-    logger::log(EVENT_LOG, "Creating shader module...");
+    VK_LOG_DEBUG(LC_RENDER, "Creating shader module...");
 
     VkShaderModuleCreateInfo shaderModuleCreateInfo            = {};
     shaderModuleCreateInfo.sType                            = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
@@ -68,7 +68,7 @@ VkShaderModule VertFragShaderStages::createShaderModuleFromBinary(const std::vec
         );
     ASSERT(result, "Failed to create shader module", VK_SC_SHADER_MODULE_CREATION_ERROR);
 
-    logger::log(EVENT_LOG, "Successfully created shader module");
+    VK_LOG_DEBUG(LC_RENDER, "Successfully created shader module");
 
     return module;
 
@@ -0,0 +1,25 @@
+/**
+    Defines the WorldEntry struct
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         WorldEntry.cpp
+    @brief        Definition of the WorldEntry struct
+*/
+#ifndef WORLD_ENTRY_CPP
+#define WORLD_ENTRY_CPP
+#include <glm/glm.hpp>
+
+#include <string>
+
+/**
+    Holds a single model placement of a scene manifest
+*/
+struct WorldEntry {
+
+    std::string             path;
+    glm::mat4               transform;
+
+};
+#endif  // WORLD_ENTRY_CPP
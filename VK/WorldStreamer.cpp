@@ -0,0 +1,331 @@
+/**
+    Implements the WorldStreamer class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         WorldStreamer.cpp
+    @brief        Implementation of the WorldStreamer class, loads and unloads world cells around the camera
+*/
+#include "WorldStreamer.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "VK.hpp"
+#include "FileIO.hpp"
+#include "FileStreamBuffer.hpp"
+
+
+WorldStreamer::WorldStreamer(
+    const std::string&          manifest_,
+    LoadScheduler*              scheduler_,
+    GraphicsPipeline&           pipeline_,
+    float                       cellSize_,
+    float                       loadRadius_,
+    float                       unloadRadius_,
+    VkDeviceSize                budget_
+    ) : pipeline(pipeline_) {
+
+    scheduler       = scheduler_;
+    cellSize        = cellSize_;
+    loadRadius      = loadRadius_;
+    unloadRadius    = std::max(unloadRadius_, loadRadius_);
+    budget          = budget_;
+
+    parse(manifest_);
+
+    for (uint32_t i = 0; i < entries.size(); i++) {
+
+        glm::vec3 position  = glm::vec3(entries[i].transform[3]);
+        int32_t x           = static_cast< int32_t >(std::floor(position.x / cellSize));
+        int32_t z           = static_cast< int32_t >(std::floor(position.z / cellSize));
+
+        Cell& cell          = cells[key(x, z)];
+        cell.min            = glm::vec2(x, z) * cellSize;
+        cell.max            = cell.min + glm::vec2(cellSize);
+        cell.entries.push_back(i);
+
+    }
+
+    logger::log(EVENT_LOG, "Partitioned " + std::to_string(entries.size()) + " manifest entries into " + std::to_string(cells.size()) + " cells");
+
+}
+
+void WorldStreamer::parse(const std::string& manifest_) {
+
+    std::shared_ptr< FileData > data = vk::io::read(manifest_);
+    if (!data) {
+
+        logger::log(ERROR_LOG, "Failed to open scene manifest " + manifest_);
+
+    }
+
+    FileStreamBuffer buffer(data);
+    std::istream file(&buffer);
+
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line)) {
+
+        lineNumber++;
+
+        std::istringstream stream(line);
+        WorldEntry entry;
+        if (!(stream >> std::quoted(entry.path)) || entry.path.empty() || entry.path[0] == '#') continue;
+
+        std::vector< float > values;
+        float value;
+        while (stream >> value) {
+
+            values.push_back(value);
+
+        }
+
+        if (values.size() == 3 || values.size() == 4) {
+
+            entry.transform = glm::translate(glm::mat4(1.0f), glm::vec3(values[0], values[1], values[2]));
+            if (values.size() == 4) entry.transform = glm::scale(entry.transform, glm::vec3(values[3]));
+
+        }
+        else if (values.size() == 16) {
+
+            std::copy(values.begin(), values.end(), &entry.transform[0][0]);
+
+        }
+        else {
+
+            VK_LOG_WARNING(LC_ASSETS, "Skipping malformed line {} of scene manifest {}", lineNumber, manifest_);
+            continue;
+
+        }
+
+        entries.push_back(entry);
+
+    }
+
+}
+
+uint64_t WorldStreamer::key(int32_t x_, int32_t z_) {
+
+    return (static_cast< uint64_t >(static_cast< uint32_t >(x_)) << 32) | static_cast< uint32_t >(z_);
+
+}
+
+float WorldStreamer::distance(const Cell& cell_, const glm::vec2& viewer_) {
+
+    return glm::length(viewer_ - glm::clamp(viewer_, cell_.min, cell_.max));
+
+}
+
+void WorldStreamer::update(const glm::vec3& viewer_, std::vector< Model* >& models_) {
+
+    frame++;
+
+    glm::vec2 viewer    = glm::vec2(viewer_.x, viewer_.z);
+    int32_t reach       = static_cast< int32_t >(std::ceil(loadRadius / cellSize));
+    int32_t viewerX     = static_cast< int32_t >(std::floor(viewer.x / cellSize));
+    int32_t viewerZ     = static_cast< int32_t >(std::floor(viewer.y / cellSize));
+
+    // Only the cells within the load radius are visited, the cost does not depend on the size of the world
+    candidates.clear();
+    for (int32_t x = viewerX - reach; x <= viewerX + reach; x++) {
+
+        for (int32_t z = viewerZ - reach; z <= viewerZ + reach; z++) {
+
+            auto cellIt = cells.find(key(x, z));
+            if (cellIt == cells.end()) continue;
+
+            float cellDistance = distance(cellIt->second, viewer);
+            if (cellDistance > loadRadius) continue;
+
+            cellIt->second.lastUsed = frame;
+            if (cellIt->second.state == CS_UNLOADED) {
+
+                candidates.push_back({ cellDistance, cellIt->first });
+
+            }
+
+        }
+
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& candidate : candidates) {
+
+        if (residentBytes + loadingBytes >= budget) break;         // Nearer cells come first, the rest waits for memory to free up
+        if (unestimated > 0) break;                                 // Nothing is known about the size of models yet, one cell at a time until something arrives
+
+        load(cells[candidate.second]);
+        active.insert(candidate.second);
+
+    }
+
+    evictable.clear();
+    unloaded.clear();
+    for (uint64_t cellKey : active) {
+
+        Cell& cell          = cells[cellKey];
+        float cellDistance  = distance(cell, viewer);
+
+        if (cell.state == CS_LOADING) {
+
+            bool ready = true;
+            for (auto& handle : cell.handles) {
+
+                if (cellDistance > unloadRadius && handle.cancel()) cell.cancelled = true;        // Loads that already started finish and are evicted afterwards
+                ready = ready && handle.ready();
+
+            }
+
+            if (ready) {
+
+                cell.state      = CS_ARRIVING;
+                cell.arrived    = frame;
+
+            }
+
+        }
+        else if (cell.state == CS_ARRIVING && frame > cell.arrived) {
+
+            if (cell.estimated) loadingBytes -= std::min(loadingBytes, cell.bytes);
+            else unestimated--;
+            cell.bytes = 0;
+
+            for (auto& handle : cell.handles) {
+
+                try {
+
+                    Model* model = handle.wait();
+                    if (model != nullptr) {
+
+                        cell.models.push_back(model);
+                        cell.bytes += model->getResidentSize();
+                        arrivedBytes += model->getResidentSize();
+                        arrivedModels++;
+
+                    }
+
+                }
+                catch (std::exception& e) {
+
+                    VK_LOG_WARNING(LC_ASSETS, "Failed to stream model: {}", e.what());
+
+                }
+
+            }
+
+            cell.handles.clear();
+            cell.state      = CS_RESIDENT;
+            residentBytes   += cell.bytes;
+
+            if (cell.cancelled) {
+
+                evict(cell, models_);           // Incomplete, loaded again as a whole once the viewer comes back
+                unloaded.push_back(cellKey);
+
+            }
+
+        }
+        else if (cell.state == CS_RESIDENT) {
+
+            if (cellDistance > unloadRadius) {
+
+                evict(cell, models_);
+                unloaded.push_back(cellKey);
+
+            }
+            else if (cellDistance > loadRadius) {
+
+                evictable.push_back({ cell.lastUsed, cellKey });        // Inside the hysteresis band, kept unless memory runs out
+
+            }
+
+        }
+
+    }
+
+    if (residentBytes > budget) {
+
+        std::sort(evictable.begin(), evictable.end());
+        for (const auto& lru : evictable) {
+
+            if (residentBytes <= budget) break;
+
+            evict(cells[lru.second], models_);
+            unloaded.push_back(lru.second);
+
+        }
+
+    }
+
+    for (uint64_t cellKey : unloaded) {
+
+        active.erase(cellKey);
+
+    }
+
+}
+
+void WorldStreamer::load(Cell& cell_) {
+
+    for (uint32_t index : cell_.entries) {
+
+        ModelInfo info = { entries[index].path.c_str(), pipeline, VK_STANDARD_MODEL_LOADING_LIB, nullptr };
+        info.transform = entries[index].transform;
+
+        cell_.handles.push_back(scheduler->push(info));
+
+    }
+
+    if (cell_.bytes == 0 && arrivedModels > 0) {
+
+        cell_.bytes = arrivedBytes / arrivedModels * cell_.entries.size();
+
+    }
+
+    cell_.state     = CS_LOADING;
+    cell_.estimated = cell_.bytes > 0;
+    cell_.cancelled = false;
+    if (cell_.estimated) loadingBytes += cell_.bytes;
+    else unestimated++;
+    loads++;
+
+}
+
+void WorldStreamer::evict(Cell& cell_, std::vector< Model* >& models_) {
+
+    std::unordered_set< Model* > evicted(cell_.models.begin(), cell_.models.end());
+    models_.erase(std::remove_if(models_.begin(), models_.end(), [&evicted](Model* model_) {
+
+        return evicted.count(model_) > 0;
+
+    }), models_.end());
+
+    for (auto model : cell_.models) {
+
+        vk::deletion::retire([model]() { delete model; });         // The frames in flight may still draw it
+
+    }
+
+    residentBytes   -= std::min(residentBytes, cell_.bytes);
+    cell_.models.clear();
+    cell_.state     = CS_UNLOADED;
+    evictions++;
+
+}
+
+void WorldStreamer::logStats() {
+
+    logger::log(EVENT_LOG, "World streamer: "
+        + std::to_string(active.size()) + " of " + std::to_string(cells.size()) + " cells active, "
+        + std::to_string(residentBytes >> 20) + " of " + std::to_string(budget >> 20) + " MiB resident, "
+        + std::to_string(loads) + " cell loads, "
+        + std::to_string(evictions) + " evictions"
+        );
+
+}
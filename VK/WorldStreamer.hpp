@@ -0,0 +1,150 @@
+/**
+    Declares the WorldStreamer class
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         WorldStreamer.hpp
+    @brief        Declaration of the WorldStreamer class, loads and unloads world cells around the camera
+*/
+#ifndef WORLD_STREAMER_HPP
+#define WORLD_STREAMER_HPP
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "CELL_STATE.cpp"
+#include "WorldEntry.cpp"
+#include "LoadScheduler.hpp"
+
+/**
+    Partitions a scene manifest into square cells on the xz-plane and keeps the cells around the viewer resident
+
+    A manifest line holds a quoted model path followed by 3 (translation), 4 (translation and uniform scale)
+    or 16 (column-major matrix) numbers, lines starting with # are comments.
+*/
+class WorldStreamer
+{
+public:
+
+    /**
+        Constructor, reads and partitions the manifest
+
+        @param      manifest_           The path to the scene manifest
+        @param      scheduler_          The scheduler to issue loads to
+        @param      pipeline_           The pipeline to render the streamed models with
+        @param      cellSize_           The edge length of a cell
+        @param      loadRadius_         Cells closer to the viewer than this are loaded
+        @param      unloadRadius_       Cells further from the viewer than this are unloaded, larger than loadRadius_
+        @param      budget_             The device memory resident cells may use, in bytes
+    */
+    WorldStreamer(
+        const std::string&          manifest_,
+        LoadScheduler*              scheduler_,
+        GraphicsPipeline&           pipeline_,
+        float                       cellSize_,
+        float                       loadRadius_,
+        float                       unloadRadius_,
+        VkDeviceSize                budget_
+        );
+
+    /**
+        Updates the working set, has to be called once per frame by the render loop after it adopted new models
+
+        @param      viewer_         The world-space position of the viewer
+        @param      models_         The models drawn by the render loop, evicted models are removed from it
+    */
+    void update(const glm::vec3& viewer_, std::vector< Model* >& models_);
+
+    /**
+        Writes the residency statistics to the event log
+    */
+    void logStats(void);
+
+private:
+
+    /**
+        A square of the world and the models placed in it
+    */
+    struct Cell {
+
+        std::vector< uint32_t >                             entries;
+        glm::vec2                                           min;
+        glm::vec2                                           max;
+        CELL_STATE                                          state           = CS_UNLOADED;
+        std::vector< ModelHandle >                          handles;
+        std::vector< Model* >                               models;
+        VkDeviceSize                                        bytes           = 0;        // Kept after eviction as the estimate for the next load
+        bool                                                estimated       = false;    // Whether bytes was charged to loadingBytes when the load was queued
+        bool                                                cancelled       = false;    // Whether a load of the current attempt was cancelled
+        uint64_t                                            lastUsed        = 0;        // Last frame the cell was inside the load radius
+        uint64_t                                            arrived         = 0;
+
+    };
+
+    std::vector< WorldEntry >                               entries;
+    std::unordered_map< uint64_t, Cell >                    cells;
+    std::unordered_set< uint64_t >                          active;                     // Every cell that is not CS_UNLOADED
+    std::vector< std::pair< float, uint64_t > >             candidates;                 // Scratch space of update(), kept to avoid per-frame allocations
+    std::vector< std::pair< uint64_t, uint64_t > >          evictable;
+    std::vector< uint64_t >                                 unloaded;
+    LoadScheduler*                                          scheduler;
+    GraphicsPipeline&                                       pipeline;
+    float                                                   cellSize;
+    float                                                   loadRadius;
+    float                                                   unloadRadius;
+    VkDeviceSize                                            budget;
+    VkDeviceSize                                            residentBytes   = 0;
+    VkDeviceSize                                            loadingBytes    = 0;        // Estimated size of the cells being loaded
+    uint32_t                                                unestimated     = 0;        // Cells being loaded that no size could be estimated for
+    VkDeviceSize                                            arrivedBytes    = 0;        // Size of every model that arrived, for the estimate of cells never loaded
+    uint64_t                                                arrivedModels   = 0;
+    uint64_t                                                frame           = 0;
+    uint64_t                                                loads           = 0;
+    uint64_t                                                evictions       = 0;
+
+    /**
+        Reads the manifest into entries
+
+        @param      manifest_       The path to the scene manifest
+    */
+    void parse(const std::string& manifest_);
+
+    /**
+        Packs the integer cell coordinates into a key
+
+        @return     Returns the key of the cell
+    */
+    static uint64_t key(int32_t x_, int32_t z_);
+
+    /**
+        Returns the distance from the viewer to the closest point of a cell
+
+        @return     Returns the distance on the xz-plane
+    */
+    static float distance(const Cell& cell_, const glm::vec2& viewer_);
+
+    /**
+        Queues a load for every model of a cell, charging its estimated size to loadingBytes. A cell that was never
+        loaded is estimated from the average size of the models that arrived so far.
+
+        @param      cell_       The cell to load
+    */
+    void load(Cell& cell_);
+
+    /**
+        Removes the models of a resident cell from the render loop and retires them
+
+        @param      cell_       The cell to evict
+        @param      models_     The models drawn by the render loop
+    */
+    void evict(Cell& cell_, std::vector< Model* >& models_);
+
+};
+#endif  // WORLD_STREAMER_HPP
@@ -0,0 +1,220 @@
+/**
+    Implements the binary log decoder
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         VKLogDecode.cpp
+    @brief        Command line tool that renders a binary log written with VK_LOG_BINARY as text
+*/
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include "LOG_LEVEL.cpp"
+#include "LOG_CATEGORY.cpp"
+#include "LogArgs.hpp"
+
+namespace {
+
+    /**
+        A format string as defined in the log
+    */
+    struct Definition {
+
+        uint8_t                         level;
+        uint8_t                         category;
+        uint32_t                        line;
+        std::string                     file;
+        std::string                     format;
+
+    };
+
+    void usage(void) {
+
+        std::cerr << "Usage: VKLogDecode [--level <level>] [--category <category>] <event.bin>" << std::endl;
+        std::cerr << "Levels: trace, debug, info, warning, error. Categories: core, render, memory, io, assets, jobs." << std::endl;
+
+    }
+
+    template< typename T >
+    bool readValue(std::ifstream& file_, T& value_) {
+
+        return static_cast< bool >(file_.read(reinterpret_cast< char* >(&value_), sizeof(value_)));
+
+    }
+
+    bool readString(std::ifstream& file_, size_t length_, std::string& string_) {
+
+        string_.resize(length_);
+
+        return length_ == 0 || static_cast< bool >(file_.read(&string_[0], length_));
+
+    }
+
+    std::string timestamp(int64_t nanoseconds_) {
+
+        time_t seconds = static_cast< time_t >(nanoseconds_ / 1000000000);
+        struct tm local = {};
+#if defined _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+
+        char text[64];
+        size_t length = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+        std::snprintf(text + length, sizeof(text) - length, ".%06lld", static_cast< long long >((nanoseconds_ / 1000) % 1000000));
+
+        return text;
+
+    }
+
+    int find(const char* const* names_, int count_, const char* name_) {
+
+        for (int i = 0; i < count_; i++) {
+
+            if (std::strcmp(names_[i], name_) == 0) return i;
+
+        }
+
+        return -1;
+
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+
+    int minimumLevel    = LL_TRACE;
+    int category        = -1;
+    const char* path    = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+
+        if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+
+            minimumLevel = find(LOG_LEVEL_NAMES, LL_OFF, argv[++i]);
+            if (minimumLevel < 0) {
+
+                usage();
+                return 1;
+
+            }
+
+        }
+        else if (std::strcmp(argv[i], "--category") == 0 && i + 1 < argc) {
+
+            category = find(LOG_CATEGORY_NAMES, LC_COUNT, argv[++i]);
+            if (category < 0) {
+
+                usage();
+                return 1;
+
+            }
+
+        }
+        else {
+
+            path = argv[i];
+
+        }
+
+    }
+
+    if (path == nullptr) {
+
+        usage();
+        return 1;
+
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    LogBinaryHeader header = {};
+    if (!file.is_open() || !readValue(file, header) || header.magic != LOG_BINARY_MAGIC) {
+
+        std::cerr << "'" << path << "' is not a binary log" << std::endl;
+        return 1;
+
+    }
+
+    if (header.version != LOG_BINARY_VERSION) {
+
+        std::cerr << "'" << path << "' has version " << header.version << ", expected " << LOG_BINARY_VERSION << std::endl;
+        return 1;
+
+    }
+
+    std::unordered_map< uint32_t, Definition > definitions;
+    std::string payload;
+    std::string line;
+    uint64_t messages = 0;
+
+    while (file.peek() != std::ifstream::traits_type::eof()) {
+
+        uint8_t kind = static_cast< uint8_t >(file.peek());
+
+        if (kind == LBR_FORMAT) {
+
+            LogBinaryFormat record;
+            Definition definition;
+            if (!readValue(file, record) || !readString(file, record.fileLength, definition.file) || !readString(file, record.formatLength, definition.format)) break;
+
+            definition.level        = record.level;
+            definition.category     = record.category;
+            definition.line         = record.line;
+            definitions[record.id]  = definition;
+
+        }
+        else if (kind == LBR_MESSAGE) {
+
+            LogBinaryMessage record;
+            if (!readValue(file, record) || !readString(file, record.payloadLength, payload)) break;
+
+            auto it = definitions.find(record.id);
+            if (it == definitions.end()) {
+
+                std::cerr << "Message with undefined format " << record.id << std::endl;
+                continue;
+
+            }
+
+            const Definition& definition = it->second;
+            if (definition.level < minimumLevel || (category >= 0 && definition.category != category)) continue;
+
+            line = timestamp(record.time);
+            line += " [";
+            line += definition.category < LC_COUNT ? LOG_CATEGORY_NAMES[definition.category] : "?";
+            line += "/";
+            line += definition.level < LL_OFF ? LOG_LEVEL_NAMES[definition.level] : "?";
+            line += "] thread " + std::to_string(record.thread) + " " + definition.file + ":" + std::to_string(definition.line) + "    ";
+            logger::args::render(definition.format.c_str(), payload.data(), payload.size(), line);
+
+            std::cout << line << '\n';
+            messages++;
+
+        }
+        else {
+
+            std::cerr << "Corrupt record at offset " << file.tellg() << ", stopping" << std::endl;
+            return 1;
+
+        }
+
+    }
+
+    if (file.fail() && !file.eof()) {
+
+        std::cerr << "Truncated record, the log was probably not closed cleanly" << std::endl;
+
+    }
+
+    std::cerr << messages << " messages" << std::endl;
+
+    return 0;
+
+}
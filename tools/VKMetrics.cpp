@@ -0,0 +1,141 @@
+/**
+    Implements the metrics reader
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         VKMetrics.cpp
+    @brief        Command line tool that prints the metrics a running engine exports on its metrics socket
+*/
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+    void usage(void) {
+
+        std::cerr << "Usage: VKMetrics [--watch <milliseconds>] [--filter <prefix>] [socket]" << std::endl;
+        std::cerr << "The socket defaults to logs/metrics.sock, run VKMetrics from the engine's working directory." << std::endl;
+
+    }
+
+    /**
+        Reads one snapshot from the socket
+    */
+    bool fetch(const std::string& path_, std::string& text_) {
+
+        sockaddr_un address     = {};
+        address.sun_family      = AF_UNIX;
+        if (path_.size() >= sizeof(address.sun_path)) return false;
+        std::memcpy(address.sun_path, path_.c_str(), path_.size() + 1);
+
+        int handle = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (handle < 0) return false;
+
+        if (connect(handle, reinterpret_cast< sockaddr* >(&address), sizeof(address)) != 0) {
+
+            close(handle);
+            return false;
+
+        }
+
+        text_.clear();
+        char buffer[4096];
+        ssize_t result;
+        while ((result = read(handle, buffer, sizeof(buffer))) > 0) {
+
+            text_.append(buffer, static_cast< size_t >(result));
+
+        }
+        close(handle);
+
+        return result == 0;
+
+    }
+
+    /**
+        Prints the lines of a snapshot whose metric name starts with a prefix, comments only with --filter unset
+    */
+    void print(const std::string& text_, const std::string& filter_) {
+
+        size_t begin = 0;
+        while (begin < text_.size()) {
+
+            size_t end = text_.find('\n', begin);
+            if (end == std::string::npos) end = text_.size();
+
+            std::string line = text_.substr(begin, end - begin);
+            begin = end + 1;
+
+            bool comment = line.compare(0, 1, "#") == 0;
+            if (!filter_.empty() && (comment || line.compare(0, filter_.size(), filter_) != 0)) continue;
+
+            std::cout << line << '\n';
+
+        }
+        std::cout.flush();
+
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+
+    std::string path        = "logs/metrics.sock";
+    std::string filter;
+    long interval           = 0;
+
+    for (int i = 1; i < argc; i++) {
+
+        if (std::strcmp(argv[i], "--watch") == 0 && i + 1 < argc) {
+
+            interval = std::strtol(argv[++i], nullptr, 10);
+
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+
+            filter = argv[++i];
+
+        }
+        else if (argv[i][0] == '-') {
+
+            usage();
+            return 1;
+
+        }
+        else {
+
+            path = argv[i];
+
+        }
+
+    }
+
+    std::string text;
+    do {
+
+        if (!fetch(path, text)) {
+
+            std::cerr << "Failed to read metrics from '" << path << "', is the engine running with VK_METRICS?" << std::endl;
+            return 1;
+
+        }
+
+        if (interval > 0) std::cout << "\033[2J\033[H";       // Redraw in place
+        print(text, filter);
+
+        if (interval > 0) std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+
+    } while (interval > 0);
+
+    return 0;
+
+}
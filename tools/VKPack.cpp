@@ -0,0 +1,231 @@
+/**
+    Implements the asset packer
+
+    @author       D3PSI
+    @version      0.0.1 02.12.2019
+
+    @file         VKPack.cpp
+    @brief        Command line tool that writes loose asset files into a single package for the engine to map
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "LZ4.hpp"
+#include "Package.hpp"
+
+namespace {
+
+    /**
+        A file to be packaged
+    */
+    struct Input {
+
+        std::string                     name;
+        std::vector< uint8_t >          bytes;
+        PackageEntry                    entry;
+
+    };
+
+    void usage(void) {
+
+        std::cerr << "Usage: VKPack [--store] <package> <file or directory>..." << std::endl;
+        std::cerr << "Paths are stored relative to the working directory, run VKPack from the engine's working directory." << std::endl;
+        std::cerr << "Entries are LZ4-compressed where that saves at least an eighth of their size, --store disables compression." << std::endl;
+
+    }
+
+    bool readFile(const std::filesystem::path& path_, std::vector< uint8_t >& bytes_) {
+
+        std::ifstream file(path_, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        bytes_.assign(std::istreambuf_iterator< char >(file), std::istreambuf_iterator< char >());
+
+        return true;
+
+    }
+
+    void collect(const std::filesystem::path& path_, std::vector< std::filesystem::path >& files_) {
+
+        if (std::filesystem::is_directory(path_)) {
+
+            for (const auto& item : std::filesystem::recursive_directory_iterator(path_)) {
+
+                if (item.is_regular_file()) files_.push_back(item.path());
+
+            }
+
+        }
+        else if (std::filesystem::is_regular_file(path_)) {
+
+            files_.push_back(path_);
+
+        }
+        else {
+
+            std::cerr << "Skipping '" << path_.string() << "', not a file or directory" << std::endl;
+
+        }
+
+    }
+
+    void pad(std::ofstream& out_, uint64_t& offset_, uint64_t alignment_) {
+
+        static const char zeros[PACKAGE_ALIGNMENT] = {};
+
+        uint64_t aligned = (offset_ + alignment_ - 1) & ~(alignment_ - 1);
+        out_.write(zeros, static_cast< std::streamsize >(aligned - offset_));
+        offset_ = aligned;
+
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+
+    bool compress = true;
+    std::vector< std::string > arguments;
+    for (int i = 1; i < argc; i++) {
+
+        if (std::strcmp(argv[i], "--store") == 0) compress = false;
+        else arguments.push_back(argv[i]);
+
+    }
+
+    if (arguments.size() < 2) {
+
+        usage();
+        return 1;
+
+    }
+
+    std::filesystem::path output = arguments[0];
+    std::vector< std::filesystem::path > files;
+    for (size_t i = 1; i < arguments.size(); i++) {
+
+        collect(arguments[i], files);
+
+    }
+
+    std::vector< Input > inputs;
+    for (const auto& path : files) {
+
+        if (std::filesystem::exists(output) && std::filesystem::equivalent(path, output)) continue;
+
+        Input input;
+        input.name = Package::normalize(path.generic_string());
+        if (input.name.empty() || input.name.compare(0, 2, "..") == 0 || path.is_absolute()) {
+
+            std::cerr << "Skipping '" << path.string() << "', it is not below the working directory" << std::endl;
+            continue;
+
+        }
+
+        if (!readFile(path, input.bytes)) {
+
+            std::cerr << "Failed to read '" << path.string() << "'" << std::endl;
+            return 1;
+
+        }
+
+        input.entry             = {};
+        input.entry.rawSize     = input.bytes.size();
+        input.entry.compression = PC_NONE;
+
+        if (compress && !input.bytes.empty()) {
+
+            std::vector< uint8_t > compressed;
+            lz4::compress(input.bytes.data(), input.bytes.size(), compressed);
+
+            if (compressed.size() + compressed.size() / 7 < input.bytes.size()) {      // Already compressed images rarely shrink, keep those mappable
+
+                input.bytes.swap(compressed);
+                input.entry.compression = PC_LZ4;
+
+            }
+
+        }
+
+        input.entry.size = input.bytes.size();
+        inputs.push_back(std::move(input));
+
+    }
+
+    std::sort(inputs.begin(), inputs.end(), [](const Input& a_, const Input& b_) { return a_.name < b_.name; });
+    inputs.erase(std::unique(inputs.begin(), inputs.end(), [](const Input& a_, const Input& b_) { return a_.name == b_.name; }), inputs.end());
+
+    std::string nameTable;
+    for (auto& input : inputs) {
+
+        input.entry.nameOffset = static_cast< uint32_t >(nameTable.size());
+        input.entry.nameLength = static_cast< uint32_t >(input.name.size());
+        nameTable += input.name;
+
+    }
+
+    PackageHeader header    = {};
+    header.magic            = PACKAGE_MAGIC;
+    header.version          = PACKAGE_VERSION;
+    header.entryCount       = static_cast< uint32_t >(inputs.size());
+    header.namesOffset      = sizeof(PackageHeader) + inputs.size() * sizeof(PackageEntry);
+    header.namesSize        = nameTable.size();
+
+    uint64_t offset = (header.namesOffset + header.namesSize + PACKAGE_ALIGNMENT - 1) & ~(PACKAGE_ALIGNMENT - 1);
+    for (auto& input : inputs) {
+
+        input.entry.offset = offset;
+        offset = (offset + input.entry.size + PACKAGE_ALIGNMENT - 1) & ~(PACKAGE_ALIGNMENT - 1);
+
+    }
+
+    std::filesystem::path temporary = output;
+    temporary += ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+
+        std::cerr << "Failed to create '" << temporary.string() << "'" << std::endl;
+        return 1;
+
+    }
+
+    out.write(reinterpret_cast< const char* >(&header), sizeof(header));
+    for (const auto& input : inputs) {
+
+        out.write(reinterpret_cast< const char* >(&input.entry), sizeof(input.entry));
+
+    }
+    out.write(nameTable.data(), static_cast< std::streamsize >(nameTable.size()));
+
+    uint64_t written    = header.namesOffset + header.namesSize;
+    uint64_t rawTotal   = 0;
+    for (const auto& input : inputs) {
+
+        pad(out, written, PACKAGE_ALIGNMENT);
+        out.write(reinterpret_cast< const char* >(input.bytes.data()), static_cast< std::streamsize >(input.bytes.size()));
+        written     += input.bytes.size();
+        rawTotal    += input.entry.rawSize;
+
+    }
+    out.close();
+
+    if (!out) {
+
+        std::cerr << "Failed to write '" << temporary.string() << "'" << std::endl;
+        return 1;
+
+    }
+
+    std::filesystem::rename(temporary, output);     // Never leave a half-written package where the engine would map it
+
+    std::cout << "Packed " << inputs.size() << " files, " << rawTotal << " bytes into " << written << " bytes at '" << output.string() << "'" << std::endl;
+
+    return 0;
+
+}